@@ -1,10 +1,15 @@
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "../benchmark_basic_fixture.hpp"
 #include "benchmark/benchmark.h"
 #include "operators/aggregate.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/table.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -25,4 +30,97 @@ BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_Aggregate)(benchmark::State& state)
 }
 BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_Aggregate)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
 
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_AggregateUngrouped)(benchmark::State& state) {
+  clear_cache();
+
+  std::vector<AggregateDefinition> aggregates = {{ColumnID{0} /* "a" */, AggregateFunction::Sum},
+                                                 {ColumnID{1} /* "b" */, AggregateFunction::Min},
+                                                 {CountStarID, AggregateFunction::Count}};
+
+  auto warm_up = std::make_shared<Aggregate>(_table_wrapper_a, aggregates, std::vector<ColumnID>{});
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto aggregate = std::make_shared<Aggregate>(_table_wrapper_a, aggregates, std::vector<ColumnID>{});
+    aggregate->execute();
+  }
+}
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_AggregateUngrouped)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_AggregateUngroupedOnDictionary)(benchmark::State& state) {
+  clear_cache();
+
+  std::vector<AggregateDefinition> aggregates = {{ColumnID{0} /* "a" */, AggregateFunction::Sum},
+                                                 {ColumnID{1} /* "b" */, AggregateFunction::Min},
+                                                 {CountStarID, AggregateFunction::Count}};
+
+  auto warm_up = std::make_shared<Aggregate>(_table_dict_wrapper, aggregates, std::vector<ColumnID>{});
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto aggregate = std::make_shared<Aggregate>(_table_dict_wrapper, aggregates, std::vector<ColumnID>{});
+    aggregate->execute();
+  }
+}
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_AggregateUngroupedOnDictionary)
+    ->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+
+/**
+ * Aggregates a table of 2M rows with SUM and COUNT(*), grouped by a column with state.range(0) distinct values. With
+ * state.range(1) set, the jobs are executed by a NodeQueueScheduler instead of sequentially.
+ */
+class AggregateGroupCountFixture : public benchmark::Fixture {
+ public:
+  void SetUp(::benchmark::State& state) override {
+    const auto group_count = static_cast<int32_t>(state.range(0));
+
+    auto random_engine = std::default_random_engine{42};
+    auto group_distribution = std::uniform_int_distribution<int32_t>{0, group_count - 1};
+    auto value_distribution = std::uniform_int_distribution<int32_t>{0, 1'000};
+
+    auto table = std::make_shared<Table>(100'000);
+    table->add_column("a", DataType::Int);
+    table->add_column("b", DataType::Int);
+    for (auto row = 0; row < 2'000'000; ++row) {
+      table->append({group_distribution(random_engine), value_distribution(random_engine)});
+    }
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+
+    if (state.range(1)) {
+      CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_numa_topology()));
+    }
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    if (state.range(1)) {
+      CurrentScheduler::get()->finish();
+      CurrentScheduler::set(nullptr);
+    }
+  }
+
+  static void GroupCountIn(benchmark::internal::Benchmark* b) {
+    for (const auto group_count : {10, 1'000, 100'000, 1'000'000}) {
+      for (const auto use_scheduler : {0, 1}) {
+        b->Args({group_count, use_scheduler});
+      }
+    }
+  }
+
+ protected:
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+BENCHMARK_DEFINE_F(AggregateGroupCountFixture, BM_AggregateGroupCount)(benchmark::State& state) {
+  const auto aggregates = std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Sum},
+                                                           {CountStarID, AggregateFunction::Count}};
+  const auto groupby = std::vector<ColumnID>{ColumnID{0}};
+
+  while (state.KeepRunning()) {
+    auto aggregate = std::make_shared<Aggregate>(_table_wrapper, aggregates, groupby);
+    aggregate->execute();
+  }
+}
+BENCHMARK_REGISTER_F(AggregateGroupCountFixture, BM_AggregateGroupCount)
+    ->Apply(AggregateGroupCountFixture::GroupCountIn);
+
 }  // namespace opossum
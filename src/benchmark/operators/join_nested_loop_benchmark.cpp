@@ -0,0 +1,75 @@
+#include <memory>
+
+#include "../benchmark_basic_fixture.hpp"
+#include "../table_generator.hpp"
+#include "benchmark/benchmark.h"
+#include "operators/join_nested_loop.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+
+namespace opossum {
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_JoinNestedLoopEquals)(benchmark::State& state) {
+  clear_cache();
+  auto warm_up = std::make_shared<JoinNestedLoop>(_table_wrapper_a, _table_wrapper_b, JoinMode::Inner,
+                                                  std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto join = std::make_shared<JoinNestedLoop>(_table_wrapper_a, _table_wrapper_b, JoinMode::Inner,
+                                                 std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+    join->execute();
+  }
+}
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_JoinNestedLoopEqualsOnDict)(benchmark::State& state) {
+  clear_cache();
+  auto warm_up = std::make_shared<JoinNestedLoop>(_table_dict_wrapper, _table_wrapper_b, JoinMode::Inner,
+                                                  std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto join = std::make_shared<JoinNestedLoop>(_table_dict_wrapper, _table_wrapper_b, JoinMode::Inner,
+                                                 std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+    join->execute();
+  }
+}
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_JoinNestedLoopLessThan)(benchmark::State& state) {
+  clear_cache();
+
+  // The output of a theta join grows quadratically, so only a small fraction of the left input is joined
+  auto scan = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0} /* "a" */, ScanType::LessThan, 10);
+  scan->execute();
+
+  auto warm_up = std::make_shared<JoinNestedLoop>(scan, _table_wrapper_b, JoinMode::Inner,
+                                                  std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::LessThan);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto join = std::make_shared<JoinNestedLoop>(scan, _table_wrapper_b, JoinMode::Inner,
+                                                 std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::LessThan);
+    join->execute();
+  }
+}
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_JoinNestedLoopLeftOuterNotEquals)(benchmark::State& state) {
+  clear_cache();
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0} /* "a" */, ScanType::LessThan, 10);
+  scan->execute();
+
+  auto warm_up = std::make_shared<JoinNestedLoop>(scan, _table_wrapper_b, JoinMode::Left,
+                                                  std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::NotEquals);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto join = std::make_shared<JoinNestedLoop>(scan, _table_wrapper_b, JoinMode::Left,
+                                                 std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::NotEquals);
+    join->execute();
+  }
+}
+
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_JoinNestedLoopEquals)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_JoinNestedLoopEqualsOnDict)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_JoinNestedLoopLessThan)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_JoinNestedLoopLeftOuterNotEquals)
+    ->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+
+}  // namespace opossum
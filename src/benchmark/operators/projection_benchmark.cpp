@@ -71,6 +71,23 @@ BENCHMARK_DEFINE_F(OperatorsProjectionBenchmark, BM_ProjectionConstantTerm)(benc
   }
 }
 
+BENCHMARK_DEFINE_F(OperatorsProjectionBenchmark, BM_ProjectionNestedTerm)(benchmark::State& state) {
+  clear_cache();
+
+  // "a" * "b" + "a"
+  Projection::ColumnExpressions expressions = {Expression::create_binary_operator(
+      ExpressionType::Addition,
+      Expression::create_binary_operator(ExpressionType::Multiplication, Expression::create_column(ColumnID{0}),
+                                         Expression::create_column(ColumnID{1})),
+      Expression::create_column(ColumnID{0}))};
+  auto warm_up = std::make_shared<Projection>(_tables[_column_type], expressions);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto projection = std::make_shared<Projection>(_tables[_column_type], expressions);
+    projection->execute();
+  }
+}
+
 static void CustomArguments(benchmark::internal::Benchmark* b) {
   for (ChunkID chunk_size : {ChunkID(0), ChunkID(10000), ChunkID(100000)}) {
     for (int column_type = 0; column_type <= 2; column_type++) {
@@ -85,4 +102,6 @@ BENCHMARK_REGISTER_F(OperatorsProjectionBenchmark, BM_ProjectionVariableTerm)->A
 
 BENCHMARK_REGISTER_F(OperatorsProjectionBenchmark, BM_ProjectionConstantTerm)->Apply(CustomArguments);
 
+BENCHMARK_REGISTER_F(OperatorsProjectionBenchmark, BM_ProjectionNestedTerm)->Apply(CustomArguments);
+
 }  // namespace opossum
@@ -1,10 +1,19 @@
 #include <memory>
+#include <random>
+#include <utility>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
 #include "../benchmark_basic_fixture.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
 
 namespace opossum {
 
@@ -21,6 +30,33 @@ BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_Sort_ChunkSizeOut)(benchmark::State
   }
 }
 
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_Sort_MultipleColumns)(benchmark::State& state) {
+  clear_cache();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{
+      {ColumnID{0} /* "a" */}, {ColumnID{1} /* "b" */, OrderByMode::Descending}, {ColumnID{2} /* "c" */}};
+
+  auto warm_up = std::make_shared<Sort>(_table_wrapper_a, sort_definitions);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto sort = std::make_shared<Sort>(_table_wrapper_a, sort_definitions);
+    sort->execute();
+  }
+}
+
+BENCHMARK_DEFINE_F(BenchmarkBasicFixture, BM_TopK)(benchmark::State& state) {
+  clear_cache();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0} /* "a" */, OrderByMode::Descending}};
+
+  auto warm_up = std::make_shared<TopK>(_table_wrapper_a, sort_definitions, 10);
+  warm_up->execute();
+  while (state.KeepRunning()) {
+    auto top_k = std::make_shared<TopK>(_table_wrapper_a, sort_definitions, 10);
+    top_k->execute();
+  }
+}
+
 static void ChunkSizeOut(benchmark::internal::Benchmark* b) {
   for (ChunkID chunk_size_in : {ChunkID(0), ChunkID(10000), ChunkID(100000)}) {
     for (ChunkID chunk_size_out : {ChunkID(0), ChunkID(10000), ChunkID(100000)}) {
@@ -30,5 +66,68 @@ static void ChunkSizeOut(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_Sort_ChunkSizeOut)->Apply(ChunkSizeOut);
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_Sort_MultipleColumns)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+BENCHMARK_REGISTER_F(BenchmarkBasicFixture, BM_TopK)->Apply(BenchmarkBasicFixture::ChunkSizeIn);
+
+/**
+ * Sorts a table of 8M rows by two random integer columns. state.range(0) is the number of workers of the
+ * NodeQueueScheduler, without a scheduler if it is 0, which shows how the Sort scales with the cores.
+ */
+class SortWorkerCountFixture : public benchmark::Fixture {
+ public:
+  void SetUp(::benchmark::State& state) override {
+    auto random_engine = std::default_random_engine{42};
+    auto distribution = std::uniform_int_distribution<int32_t>{0, 1'000'000};
+
+    auto table = std::make_shared<Table>(100'000);
+    table->add_column_definition("a", DataType::Int);
+    table->add_column_definition("b", DataType::Int);
+    for (auto chunk_idx = 0; chunk_idx < 80; ++chunk_idx) {
+      Chunk chunk;
+      for (auto column_idx = 0; column_idx < 2; ++column_idx) {
+        auto values = pmr_concurrent_vector<int32_t>(100'000);
+        for (auto& value : values) {
+          value = distribution(random_engine);
+        }
+        chunk.add_column(std::make_shared<ValueColumn<int32_t>>(std::move(values)));
+      }
+      table->emplace_chunk(std::move(chunk));
+    }
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+
+    if (state.range(0)) {
+      CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(
+          Topology::create_numa_topology(static_cast<uint32_t>(state.range(0)))));
+    }
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    if (state.range(0)) {
+      CurrentScheduler::get()->finish();
+      CurrentScheduler::set(nullptr);
+    }
+  }
+
+  static void WorkerCountIn(benchmark::internal::Benchmark* b) {
+    for (const auto worker_count : {0, 1, 2, 4, 8, 16, 32}) {
+      b->Args({worker_count});
+    }
+  }
+
+ protected:
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+BENCHMARK_DEFINE_F(SortWorkerCountFixture, BM_Sort_WorkerCount)(benchmark::State& state) {
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}}, {ColumnID{1}}};
+
+  while (state.KeepRunning()) {
+    auto sort = std::make_shared<Sort>(_table_wrapper, sort_definitions);
+    sort->execute();
+  }
+}
+BENCHMARK_REGISTER_F(SortWorkerCountFixture, BM_Sort_WorkerCount)->Apply(SortWorkerCountFixture::WorkerCountIn);
 
 }  // namespace opossum
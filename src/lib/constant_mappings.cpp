@@ -71,7 +71,10 @@ const std::unordered_map<ExpressionType, std::string> expression_type_to_string
 };
 
 const std::unordered_map<OrderByMode, std::string> order_by_mode_to_string = {
-    {OrderByMode::Ascending, "Ascending"}, {OrderByMode::Descending, "Descending"},
+    {OrderByMode::Ascending, "Ascending"},
+    {OrderByMode::Descending, "Descending"},
+    {OrderByMode::AscendingNullsLast, "AscendingNullsLast"},
+    {OrderByMode::DescendingNullsLast, "DescendingNullsLast"},
 };
 
 const std::unordered_map<hsql::OperatorType, ExpressionType> operator_type_to_expression_type = {
@@ -129,6 +132,7 @@ const boost::bimap<AggregateFunction, std::string> aggregate_function_to_string
         {AggregateFunction::Avg, "AVG"},
         {AggregateFunction::Count, "COUNT"},
         {AggregateFunction::CountDistinct, "COUNT DISTINCT"},
+        {AggregateFunction::ApproxCountDistinct, "APPROX_COUNT_DISTINCT"},
     });
 
 const boost::bimap<DataType, std::string> data_type_to_string =
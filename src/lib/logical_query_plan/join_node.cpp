@@ -22,20 +22,39 @@ JoinNode::JoinNode(const JoinMode join_mode) : AbstractLQPNode(LQPNodeType::Join
 }
 
 JoinNode::JoinNode(const JoinMode join_mode, const std::pair<ColumnID, ColumnID>& join_column_ids,
-                   const ScanType scan_type)
+                   const ScanType scan_type,
+                   const std::vector<std::pair<ColumnID, ColumnID>>& additional_join_column_ids)
     : AbstractLQPNode(LQPNodeType::Join),
       _join_mode(join_mode),
       _join_column_ids(join_column_ids),
-      _scan_type(scan_type) {
+      _scan_type(scan_type),
+      _additional_join_column_ids(additional_join_column_ids) {
   DebugAssert(join_mode != JoinMode::Cross && join_mode != JoinMode::Natural,
               "Specified JoinMode must specify neither column ids nor scan type.");
+  DebugAssert(additional_join_column_ids.empty() || scan_type == ScanType::Equals,
+              "Additional join column ids are only supported for equi joins.");
+  DebugAssert(scan_type != ScanType::Between, "Band joins need an upper bound column id.");
+}
+
+JoinNode::JoinNode(const JoinMode join_mode, const std::pair<ColumnID, ColumnID>& join_column_ids,
+                   const ColumnID upper_bound_column_id)
+    : AbstractLQPNode(LQPNodeType::Join),
+      _join_mode(join_mode),
+      _join_column_ids(join_column_ids),
+      _scan_type(ScanType::Between),
+      _upper_bound_column_id(upper_bound_column_id) {
+  DebugAssert(join_mode != JoinMode::Cross && join_mode != JoinMode::Natural,
+              "Specified JoinMode must specify neither column ids nor scan type.");
+  DebugAssert(join_mode != JoinMode::Self, "Band joins do not support self joins.");
 }
 
 std::shared_ptr<AbstractLQPNode> JoinNode::_deep_copy_impl() const {
   if (_join_mode == JoinMode::Cross || _join_mode == JoinMode::Natural) {
     return std::make_shared<JoinNode>(_join_mode);
+  } else if (_upper_bound_column_id) {
+    return std::make_shared<JoinNode>(_join_mode, *_join_column_ids, *_upper_bound_column_id);
   } else {
-    return std::make_shared<JoinNode>(_join_mode, *_join_column_ids, *_scan_type);
+    return std::make_shared<JoinNode>(_join_mode, *_join_column_ids, *_scan_type, _additional_join_column_ids);
   }
 }
 
@@ -51,6 +70,18 @@ std::string JoinNode::description() const {
     desc << " " << scan_type_to_string.left.at(*_scan_type);
     desc << " " << get_verbose_column_name(ColumnID{static_cast<ColumnID::base_type>(
                        left_child()->output_column_count() + _join_column_ids->second)});
+
+    if (_upper_bound_column_id) {
+      desc << " AND " << get_verbose_column_name(ColumnID{static_cast<ColumnID::base_type>(
+                             left_child()->output_column_count() + *_upper_bound_column_id)});
+    }
+
+    for (const auto& additional_join_column_ids : _additional_join_column_ids) {
+      desc << " AND " << get_verbose_column_name(additional_join_column_ids.first);
+      desc << " " << scan_type_to_string.left.at(ScanType::Equals);
+      desc << " " << get_verbose_column_name(ColumnID{static_cast<ColumnID::base_type>(
+                         left_child()->output_column_count() + additional_join_column_ids.second)});
+    }
   }
 
   return desc.str();
@@ -147,8 +178,11 @@ std::shared_ptr<TableStatistics> JoinNode::derive_statistics_from(
     Assert(_join_column_ids,
            "Only cross joins and joins with join column ids supported for generating join statistics");
     Assert(_scan_type, "Only cross joins and joins with scan type supported for generating join statistics");
+    // For composite-key joins, only the first pair of join columns is considered, which overestimates the row count.
+    // The same applies to band joins, which are estimated as `point >= lower`.
+    const auto scan_type = _upper_bound_column_id ? ScanType::GreaterThanEquals : *_scan_type;
     return left_child->get_statistics()->generate_predicated_join_statistics(right_child->get_statistics(), _join_mode,
-                                                                             *_join_column_ids, *_scan_type);
+                                                                             *_join_column_ids, scan_type);
   }
 }
 
@@ -206,6 +240,12 @@ const std::optional<std::pair<ColumnID, ColumnID>>& JoinNode::join_column_ids()
 
 const std::optional<ScanType>& JoinNode::scan_type() const { return _scan_type; }
 
+const std::vector<std::pair<ColumnID, ColumnID>>& JoinNode::additional_join_column_ids() const {
+  return _additional_join_column_ids;
+}
+
+const std::optional<ColumnID>& JoinNode::upper_bound_column_id() const { return _upper_bound_column_id; }
+
 JoinMode JoinNode::join_mode() const { return _join_mode; }
 
 std::string JoinNode::get_verbose_column_name(ColumnID column_id) const {
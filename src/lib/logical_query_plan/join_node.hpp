@@ -20,10 +20,25 @@ class JoinNode : public AbstractLQPNode {
  public:
   explicit JoinNode(const JoinMode join_mode);
 
-  JoinNode(const JoinMode join_mode, const std::pair<ColumnID, ColumnID>& join_column_ids, const ScanType scan_type);
+  /**
+   * @param additional_join_column_ids  further pairs of columns that have to be equal for two rows to match, i.e.,
+   *                                    the join is performed on a composite key. Only valid with ScanType::Equals.
+   */
+  JoinNode(const JoinMode join_mode, const std::pair<ColumnID, ColumnID>& join_column_ids, const ScanType scan_type,
+           const std::vector<std::pair<ColumnID, ColumnID>>& additional_join_column_ids = {});
+
+  /**
+   * Creates a band join with the predicate `left.point BETWEEN right.lower AND right.upper`, i.e., ScanType::Between.
+   * @param join_column_ids         the point column of the left and the lower bound column of the right input
+   * @param upper_bound_column_id   the upper bound column of the right input
+   */
+  JoinNode(const JoinMode join_mode, const std::pair<ColumnID, ColumnID>& join_column_ids,
+           const ColumnID upper_bound_column_id);
 
   const std::optional<std::pair<ColumnID, ColumnID>>& join_column_ids() const;
   const std::optional<ScanType>& scan_type() const;
+  const std::vector<std::pair<ColumnID, ColumnID>>& additional_join_column_ids() const;
+  const std::optional<ColumnID>& upper_bound_column_id() const;
   JoinMode join_mode() const;
 
   std::string description() const override;
@@ -50,6 +65,8 @@ class JoinNode : public AbstractLQPNode {
   JoinMode _join_mode;
   std::optional<std::pair<ColumnID, ColumnID>> _join_column_ids;
   std::optional<ScanType> _scan_type;
+  std::vector<std::pair<ColumnID, ColumnID>> _additional_join_column_ids;
+  std::optional<ColumnID> _upper_bound_column_id;
 
   mutable std::optional<std::vector<std::string>> _output_column_names;
 
@@ -1,5 +1,6 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -16,10 +17,13 @@
 #include "join_node.hpp"
 #include "limit_node.hpp"
 #include "operators/aggregate.hpp"
+#include "operators/aggregate_sorted.hpp"
 #include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/insert.hpp"
+#include "operators/join_band.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/create_view.hpp"
@@ -31,13 +35,17 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "operators/union_positions.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "optimizer/table_statistics.hpp"
 #include "predicate_node.hpp"
 #include "projection_node.hpp"
 #include "show_columns_node.hpp"
 #include "sort_node.hpp"
+#include "storage/index/base_index.hpp"
+#include "storage/storage_manager.hpp"
 #include "stored_table_node.hpp"
 #include "union_node.hpp"
 #include "update_node.hpp"
@@ -46,6 +54,69 @@
 
 namespace opossum {
 
+namespace {
+
+/**
+ * JoinIndex performs one index lookup per row of the left input and chunk of the right input, while JoinHash and
+ * JoinSortMerge read both inputs entirely. Thus, JoinIndex is only chosen if the right input is a stored table that is
+ * indexed on the join column in every chunk and if the number of lookups is small compared to its row count.
+ */
+constexpr auto INDEX_JOIN_MAX_LOOKUPS_PER_INDEXED_ROW = 0.1f;
+
+bool use_index_join(const std::shared_ptr<JoinNode>& join_node) {
+  const auto mode = join_node->join_mode();
+  if (mode != JoinMode::Inner && mode != JoinMode::Left && mode != JoinMode::Semi && mode != JoinMode::Anti) {
+    return false;
+  }
+
+  const auto scan_type = *join_node->scan_type();
+  if (scan_type == ScanType::Between || scan_type == ScanType::Like || scan_type == ScanType::NotLike) return false;
+  if (!join_node->additional_join_column_ids().empty()) return false;
+
+  const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(join_node->right_child());
+  if (!stored_table_node) return false;
+
+  const auto right_table = StorageManager::get().get_table(stored_table_node->table_name());
+  const auto right_column_id = join_node->join_column_ids()->second;
+  if (right_table->column_is_nullable(right_column_id)) return false;
+
+  for (ChunkID chunk_id{0}; chunk_id < right_table->chunk_count(); ++chunk_id) {
+    if (right_table->get_chunk(chunk_id).get_indices(std::vector<ColumnID>{right_column_id}).empty()) return false;
+  }
+
+  const auto left_statistics = join_node->left_child()->get_statistics();
+  if (!left_statistics) return false;
+
+  const auto lookup_count = left_statistics->row_count() * right_table->chunk_count();
+  return lookup_count <= INDEX_JOIN_MAX_LOOKUPS_PER_INDEXED_ROW * right_table->row_count();
+}
+
+// Returns a copy of the expression in which column references are replaced by the expressions that compute the columns
+std::shared_ptr<Expression> inline_column_expressions(const std::shared_ptr<Expression>& expression,
+                                                      const Projection::ColumnExpressions& column_expressions) {
+  if (expression->type() == ExpressionType::Column) return column_expressions[expression->column_id()]->deep_copy();
+
+  auto inlined_expression = expression->deep_copy();
+  if (expression->left_child()) {
+    inlined_expression->set_left_child(inline_column_expressions(expression->left_child(), column_expressions));
+  }
+  if (expression->right_child()) {
+    inlined_expression->set_right_child(inline_column_expressions(expression->right_child(), column_expressions));
+  }
+  return inlined_expression;
+}
+
+std::vector<SortColumnDefinition> sort_column_definitions(const SortNode& sort_node) {
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
+  sort_definitions.reserve(sort_node.order_by_definitions().size());
+  for (const auto& definition : sort_node.order_by_definitions()) {
+    sort_definitions.emplace_back(definition.column_id, definition.order_by_mode);
+  }
+  return sort_definitions;
+}
+
+}  // namespace
+
 std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::shared_ptr<AbstractLQPNode>& node) const {
   return _translate_by_node_type(node->type(), node);
 }
@@ -87,26 +158,9 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_projection_node(
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_sort_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto sort_node = std::dynamic_pointer_cast<SortNode>(node);
-  auto input_operator = translate_node(node->left_child());
-
-  /**
-   * Go through all the order descriptions and create a sort operator for each of them.
-   * Iterate in reverse because the sort operator does not support multiple columns, and instead relies on stable sort.
-   * We therefore sort by the n+1-th column before sorting by the n-th column.
-   */
-
-  std::shared_ptr<AbstractOperator> result_operator;
-  const auto& definitions = sort_node->order_by_definitions();
-  if (definitions.size() > 1) {
-    PerformanceWarning("Multiple ORDER BYs are executed one-by-one");
-  }
-  for (auto it = definitions.rbegin(); it != definitions.rend(); it++) {
-    const auto& definition = *it;
-    result_operator = std::make_shared<Sort>(input_operator, definition.column_id, definition.order_by_mode);
-    input_operator = result_operator;
-  }
+  const auto input_operator = translate_node(node->left_child());
 
-  return result_operator;
+  return std::make_shared<Sort>(input_operator, sort_column_definitions(*sort_node));
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
@@ -124,105 +178,71 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_join_node(
   DebugAssert(static_cast<bool>(join_node->join_column_ids()), "Cannot translate Join without join column ids.");
   DebugAssert(static_cast<bool>(join_node->scan_type()), "Cannot translate Join without ScanType.");
 
-  if (*join_node->scan_type() == ScanType::Equals && join_node->join_mode() != JoinMode::Outer) {
+  if (join_node->upper_bound_column_id()) {
+    return std::make_shared<JoinBand>(input_left_operator, input_right_operator, join_node->join_mode(),
+                                      *(join_node->join_column_ids()), *(join_node->upper_bound_column_id()));
+  }
+
+  if (use_index_join(join_node)) {
+    return std::make_shared<JoinIndex>(input_left_operator, input_right_operator, join_node->join_mode(),
+                                       *(join_node->join_column_ids()), *(join_node->scan_type()));
+  }
+
+  if (*join_node->scan_type() == ScanType::Equals) {
     return std::make_shared<JoinHash>(input_left_operator, input_right_operator, join_node->join_mode(),
-                                      *(join_node->join_column_ids()), *(join_node->scan_type()));
+                                      *(join_node->join_column_ids()), *(join_node->scan_type()),
+                                      join_node->additional_join_column_ids());
   }
 
   return std::make_shared<JoinSortMerge>(input_left_operator, input_right_operator, join_node->join_mode(),
-                                         *(join_node->join_column_ids()), *(join_node->scan_type()));
+                                         *(join_node->join_column_ids()), *(join_node->scan_type()),
+                                         join_node->additional_join_column_ids());
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_child());
-
   const auto aggregate_node = std::dynamic_pointer_cast<AggregateNode>(node);
-  auto aggregate_expressions = aggregate_node->aggregate_expressions();
-  auto groupby_columns = aggregate_node->groupby_column_ids();
-
-  auto aggregate_input_operator = input_operator;
+  const auto& aggregate_expressions = aggregate_node->aggregate_expressions();
+  const auto& groupby_columns = aggregate_node->groupby_column_ids();
 
   /**
-   * 1. Handle arithmetic expressions in aggregate functions via Projection.
+   * 1. Handle arithmetic expressions via column expressions of the Aggregate.
    *
-   * In Hyrise, only Projections are supposed to be able to handle arithmetic expressions.
-   * Therefore, if we encounter an expression within an aggregate function, we have to execute a Projection first.
-   * The Aggregate will work with the output columns of that Projection.
+   * The Aggregate evaluates its column expressions chunk by chunk, so that neither the group keys computed by a
+   * ProjectionNode below the AggregateNode (e.g., for `GROUP BY a * 100 + b`) nor arithmetic expressions in aggregate
+   * functions (e.g., `a+b` in `SUM(a+b)`) need a Projection that materializes them for the whole input first.
    *
-   * We only need a Projection before the aggregate if the function argument is an arithmetic expression.
+   * If the input is a ProjectionNode that only consists of columns, literals, and arithmetics, its expressions become
+   * the column expressions, so that the ColumnIDs of the AggregateNode remain valid.
    */
-  auto need_projection = false;
-
-  // Check if there are any arithmetic expressions.
-  for (const auto& aggregate_expression : aggregate_expressions) {
-    DebugAssert(aggregate_expression->type() == ExpressionType::Function, "Expression is not a function.");
-
-    // Check whether the expression that is the argument of the aggregate function, e.g. `a+b` in `SUM(a+b)` is, as in
-    // this case, an arithmetic expression and therefore needs a Projection before the aggregate is performed. If all
-    // Aggregates are in the style of `COUNT(b)` or there are just groupby columns, there is no need for a Projection.
-    const auto& function_arg_expr = (aggregate_expression->expression_list())[0];
-    if (function_arg_expr->is_arithmetic_operator()) {
-      need_projection = true;
-      break;
-    }
+  auto input_node = node->left_child();
+  Projection::ColumnExpressions column_expressions;
+
+  const auto projection_node = std::dynamic_pointer_cast<ProjectionNode>(input_node);
+  if (projection_node && std::all_of(projection_node->column_expressions().cbegin(),
+                                     projection_node->column_expressions().cend(), [](const auto& expression) {
+                                       return expression->type() == ExpressionType::Column ||
+                                              expression->type() == ExpressionType::Literal ||
+                                              expression->is_arithmetic_operator();
+                                     })) {
+    column_expressions = projection_node->column_expressions();
+    input_node = projection_node->left_child();
   }
 
-  /**
-   * If there are arithmetic expressions create a Projection with:
-   *
-   *  - arithmetic expressions,
-   *  - columns used in aggregate functions, and
-   *  - GROUP BY columns
-   *
-   *  TODO(anybody): this might result in the same columns being created multiple times. Improve.
-   */
-  if (need_projection) {
-    Projection::ColumnExpressions column_expressions = Expression::create_columns(groupby_columns);
-    column_expressions.reserve(groupby_columns.size() + aggregate_expressions.size());
-
-    // The Projection will only select columns used in the Aggregate, i.e., GROUP BY columns and expressions.
-    // Unused columns are skipped – therefore, the ColumnIDs might change.
-    // GROUP BY columns will be the first columns of the Projection.
-    for (ColumnID column_id{0}; column_id < groupby_columns.size(); column_id++) {
-      groupby_columns[column_id] = column_id;
-    }
-
-    // Aggregates will get consecutive ColumnIDs.
-    auto current_column_id = static_cast<ColumnID::base_type>(groupby_columns.size());
-
-    for (auto& aggregate_expression : aggregate_expressions) {
-      Assert(aggregate_expression->expression_list().size(), "Aggregate: empty expression list");
-      DebugAssert(aggregate_expression->type() == ExpressionType::Function, "Expression is not a function.");
-
-      // Do not project for COUNT(*)
-      if (aggregate_expression->aggregate_function() == AggregateFunction::Count &&
-          (aggregate_expression->expression_list())[0]->type() == ExpressionType::Star) {
-        continue;
-      }
-
-      // Add original expression of the function to the Projection.
-      column_expressions.emplace_back(aggregate_expression->expression_list()[0]);
-
-      // Create a ColumnReference expression for the column id of the Projection.
-      const auto column_ref_expr = Expression::create_column(ColumnID{current_column_id});
-      current_column_id++;
-
-      // Change the expression list of the expression representing the aggregate.
-      aggregate_expression->set_expression_list({column_ref_expr});
-    }
-
-    aggregate_input_operator = std::make_shared<Projection>(aggregate_input_operator, column_expressions);
-  }
+  const auto input_operator = translate_node(input_node);
 
   /**
    * 2. Build Aggregate
+   *
+   * An arithmetic expression in an aggregate function is appended to the column expressions. As it refers to the
+   * columns of the AggregateNode's input, these are replaced by the column expressions that compute them.
    */
   std::vector<AggregateDefinition> aggregate_definitions;
   aggregate_definitions.reserve(aggregate_expressions.size());
 
   for (const auto& aggregate_expression : aggregate_expressions) {
     DebugAssert(aggregate_expression->type() == ExpressionType::Function, "Only functions are supported in Aggregates");
+    Assert(aggregate_expression->expression_list().size(), "Aggregate: empty expression list");
 
     const auto aggregate_function_type = aggregate_expression->aggregate_function();
     const auto root_expr = (aggregate_expression->expression_list())[0];
@@ -230,19 +250,57 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_aggregate_node(
     if (aggregate_function_type == AggregateFunction::Count && root_expr->type() == ExpressionType::Star) {
       // COUNT(*) does not specify a ColumnID
       aggregate_definitions.emplace_back(CountStarID, AggregateFunction::Count, aggregate_expression->alias());
+    } else if (root_expr->is_arithmetic_operator()) {
+      if (column_expressions.empty()) {
+        column_expressions = Expression::create_columns(node->left_child()->get_output_column_ids());
+      }
+
+      const auto column_id = ColumnID{static_cast<ColumnID::base_type>(column_expressions.size())};
+      column_expressions.emplace_back(inline_column_expressions(root_expr, column_expressions));
+      aggregate_definitions.emplace_back(column_id, aggregate_function_type, aggregate_expression->alias());
     } else {
       const auto column_id = root_expr->column_id();
       aggregate_definitions.emplace_back(column_id, aggregate_function_type, aggregate_expression->alias());
     }
   }
 
-  return std::make_shared<Aggregate>(aggregate_input_operator, aggregate_definitions, groupby_columns);
+  /**
+   * 3. If the input is sorted by all GROUP BY columns, the rows of each group are adjacent and can be aggregated
+   * without hashing. AggregateSorted does not evaluate column expressions, so a Projection computes them. It does not
+   * change the order of the rows.
+   */
+  const auto sort_node = std::dynamic_pointer_cast<SortNode>(node->left_child());
+
+  if (sort_node && !groupby_columns.empty() &&
+      sort_node->order_by_definitions().size() >= groupby_columns.size()) {
+    auto sort_column_ids = std::vector<ColumnID>{};
+    for (auto definition_idx = size_t{0}; definition_idx < groupby_columns.size(); ++definition_idx) {
+      sort_column_ids.emplace_back(sort_node->order_by_definitions()[definition_idx].column_id);
+    }
+
+    if (std::is_permutation(sort_column_ids.begin(), sort_column_ids.end(), groupby_columns.begin())) {
+      const auto sorted_input_operator = column_expressions.empty()
+                                             ? input_operator
+                                             : std::make_shared<Projection>(input_operator, column_expressions);
+      return std::make_shared<AggregateSorted>(sorted_input_operator, aggregate_definitions, groupby_columns);
+    }
+  }
+
+  return std::make_shared<Aggregate>(input_operator, aggregate_definitions, groupby_columns, column_expressions);
 }
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_limit_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
-  const auto input_operator = translate_node(node->left_child());
   auto limit_node = std::dynamic_pointer_cast<LimitNode>(node);
+
+  // A Limit on top of a Sort only needs the first rows of the sorted input, which TopK finds without a full sort
+  if (const auto sort_node = std::dynamic_pointer_cast<SortNode>(node->left_child())) {
+    const auto input_operator = translate_node(sort_node->left_child());
+
+    return std::make_shared<TopK>(input_operator, sort_column_definitions(*sort_node), limit_node->num_rows());
+  }
+
+  const auto input_operator = translate_node(node->left_child());
   return std::make_shared<Limit>(input_operator, limit_node->num_rows());
 }
 
@@ -1,19 +1,103 @@
 #include "abstract_join_operator.hpp"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "storage/reference_column.hpp"
+#include "storage/value_column.hpp"
 
 namespace opossum {
 
+namespace {
+
+/**
+ * Returns the type that the values of two join columns are converted to before they are encoded into a composite key.
+ * Integral columns are widened to long and mixed integral/floating point columns to double, so that equal values of
+ * different types get equal keys.
+ */
+DataType composite_key_type(const DataType left_type, const DataType right_type) {
+  Assert((left_type == DataType::String) == (right_type == DataType::String),
+         "Cannot join a string column with a non-string column.");
+
+  if (left_type == right_type) return left_type;
+
+  const auto is_floating_point = [](const DataType type) {
+    return type == DataType::Float || type == DataType::Double;
+  };
+  if (is_floating_point(left_type) || is_floating_point(right_type)) return DataType::Double;
+  return DataType::Long;
+}
+
+/**
+ * Appends the encoded value of one join column to the keys of a chunk. Fixed-width types are appended in their binary
+ * representation, strings are prefixed with their length so that ("a", "bc") and ("ab", "c") get different keys.
+ */
+void append_to_composite_keys(const BaseColumn& column, const DataType column_type, const DataType key_type,
+                              std::vector<std::string>& keys, std::vector<bool>& null_values) {
+  resolve_data_type(key_type, [&](auto key_data_type) {
+    using KeyType = typename decltype(key_data_type)::type;
+
+    resolve_data_and_column_type(column_type, column, [&](auto type, auto& typed_column) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      // composite_key_type() guarantees that strings are only encoded as strings, so only compile valid combinations
+      if constexpr (std::is_same<KeyType, std::string>{} == std::is_same<ColumnDataType, std::string>{}) {
+        auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+
+        iterable.for_each([&](const auto& value) {
+          const auto chunk_offset = value.chunk_offset();
+
+          if (value.is_null()) {
+            null_values[chunk_offset] = true;
+            return;
+          }
+
+          auto& key = keys[chunk_offset];
+
+          if constexpr (std::is_same<KeyType, std::string>{}) {
+            const auto length = static_cast<uint32_t>(value.value().size());
+            key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            key.append(value.value());
+          } else {
+            auto converted_value = static_cast<KeyType>(value.value());
+
+            // -0.0 and 0.0 are equal, but have different binary representations
+            if (converted_value == KeyType{0}) converted_value = KeyType{0};
+
+            key.append(reinterpret_cast<const char*>(&converted_value), sizeof(KeyType));
+          }
+        });
+      } else {
+        Fail("Cannot encode column into composite key of a different kind.");
+      }
+    });
+  });
+}
+
+}  // namespace
+
 AbstractJoinOperator::AbstractJoinOperator(const std::shared_ptr<const AbstractOperator> left,
                                            const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                                           const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
-    : AbstractReadOnlyOperator(left, right), _mode(mode), _column_ids(column_ids), _scan_type(scan_type) {
+                                           const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                                           const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids)
+    : AbstractReadOnlyOperator(left, right),
+      _mode(mode),
+      _column_ids(column_ids),
+      _scan_type(scan_type),
+      _additional_column_ids(additional_column_ids) {
   DebugAssert(mode != JoinMode::Cross && mode != JoinMode::Natural,
               "Specified JoinMode not supported by an AbstractJoin, use Product etc. instead.");
+  DebugAssert(additional_column_ids.empty() || scan_type == ScanType::Equals,
+              "Composite-key joins are only supported for equi joins.");
 }
 
 JoinMode AbstractJoinOperator::mode() const { return _mode; }
@@ -22,15 +106,135 @@ const std::pair<ColumnID, ColumnID>& AbstractJoinOperator::column_ids() const {
 
 ScanType AbstractJoinOperator::scan_type() const { return _scan_type; }
 
+const std::vector<std::pair<ColumnID, ColumnID>>& AbstractJoinOperator::additional_column_ids() const {
+  return _additional_column_ids;
+}
+
 const std::string AbstractJoinOperator::description() const {
-  std::string column_name_left = std::string("Col #") + std::to_string(_column_ids.first);
-  std::string column_name_right = std::string("Col #") + std::to_string(_column_ids.second);
+  const auto predicate_description = [&](const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type) {
+    std::string column_name_left = std::string("Col #") + std::to_string(column_ids.first);
+    std::string column_name_right = std::string("Col #") + std::to_string(column_ids.second);
+
+    if (_input_table_left()) column_name_left = _input_table_left()->column_name(column_ids.first);
+    if (_input_table_right()) column_name_right = _input_table_right()->column_name(column_ids.second);
+
+    return column_name_left + " " + scan_type_to_string.left.at(scan_type) + " " + column_name_right;
+  };
+
+  auto predicates = predicate_description(_column_ids, _scan_type);
+  for (const auto& additional_column_ids : _additional_column_ids) {
+    predicates += " AND " + predicate_description(additional_column_ids, ScanType::Equals);
+  }
+
+  return name() + "\\n(" + join_mode_to_string.at(_mode) + " Join where " + predicates + ")";
+}
+
+std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>>
+AbstractJoinOperator::_create_composite_key_tables() const {
+  auto column_id_pairs = std::vector<std::pair<ColumnID, ColumnID>>{_column_ids};
+  column_id_pairs.insert(column_id_pairs.end(), _additional_column_ids.begin(), _additional_column_ids.end());
+
+  const auto left_input = _input_table_left();
+  const auto right_input = _input_table_right();
+
+  auto key_types = std::vector<DataType>();
+  key_types.reserve(column_id_pairs.size());
+  for (const auto& column_ids : column_id_pairs) {
+    key_types.emplace_back(
+        composite_key_type(left_input->column_type(column_ids.first), right_input->column_type(column_ids.second)));
+  }
+
+  const auto create_key_table = [&](const std::shared_ptr<const Table>& input_table, const bool is_left) {
+    auto key_table = std::make_shared<Table>();
+    key_table->add_column("composite_key", DataType::String, true);
+
+    // Create the chunks upfront. Table::emplace_chunk would drop an empty first chunk and thus shift the ChunkIDs.
+    for (ChunkID chunk_id{1}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+      key_table->create_new_chunk();
+    }
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(input_table->chunk_count());
+
+    for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto& chunk = input_table->get_chunk(chunk_id);
+
+        auto keys = std::vector<std::string>(chunk.size());
+        auto null_values = std::vector<bool>(chunk.size());
+
+        for (size_t pair_idx = 0; pair_idx < column_id_pairs.size(); ++pair_idx) {
+          const auto column_id = is_left ? column_id_pairs[pair_idx].first : column_id_pairs[pair_idx].second;
+          append_to_composite_keys(*chunk.get_column(column_id), input_table->column_type(column_id),
+                                   key_types[pair_idx], keys, null_values);
+        }
+
+        auto key_values = pmr_concurrent_vector<std::string>(chunk.size());
+        auto key_null_values = pmr_concurrent_vector<bool>(chunk.size());
+        for (ChunkOffset chunk_offset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+          key_values[chunk_offset] = null_values[chunk_offset] ? std::string{} : std::move(keys[chunk_offset]);
+          key_null_values[chunk_offset] = null_values[chunk_offset];
+        }
+
+        key_table->get_chunk(chunk_id).replace_column(
+            0, std::make_shared<ValueColumn<std::string>>(std::move(key_values), std::move(key_null_values)));
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    return std::const_pointer_cast<const Table>(key_table);
+  };
+
+  return {create_key_table(left_input, true), create_key_table(right_input, false)};
+}
+
+void AbstractJoinOperator::_write_output_columns(Chunk& output_chunk, const std::shared_ptr<const Table>& input_table,
+                                                 const std::shared_ptr<const PosList>& pos_list) {
+  // Resolved position lists, by the position lists of the input's chunks they were resolved through
+  auto resolved_pos_lists = std::map<std::vector<const PosList*>, std::shared_ptr<const PosList>>{};
+
+  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
+    // We assume that either all chunks contain ReferenceColumns or none does
+    const auto first_reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(
+        input_table->get_chunk(ChunkID{0}).get_column(column_id));
+
+    if (!first_reference_column) {
+      output_chunk.add_column(std::make_shared<ReferenceColumn>(input_table, column_id, pos_list));
+      continue;
+    }
+
+    auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>{};
+    auto input_pos_list_ptrs = std::vector<const PosList*>{};
+    input_pos_lists.reserve(input_table->chunk_count());
+    input_pos_list_ptrs.reserve(input_table->chunk_count());
+    for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+      const auto reference_column =
+          std::dynamic_pointer_cast<const ReferenceColumn>(input_table->get_chunk(chunk_id).get_column(column_id));
+      DebugAssert(reference_column, "Tables must consist either of ReferenceColumns only or of none at all");
+      input_pos_lists.emplace_back(reference_column->pos_list());
+      input_pos_list_ptrs.emplace_back(input_pos_lists.back().get());
+    }
 
-  if (_input_table_left()) column_name_left = _input_table_left()->column_name(_column_ids.first);
-  if (_input_table_right()) column_name_right = _input_table_right()->column_name(_column_ids.second);
+    auto& resolved_pos_list = resolved_pos_lists[input_pos_list_ptrs];
+    if (!resolved_pos_list) {
+      auto new_pos_list = std::make_shared<PosList>();
+      new_pos_list->reserve(pos_list->size());
+      for (const auto& row : *pos_list) {
+        if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
+          new_pos_list->emplace_back(NULL_ROW_ID);
+        } else {
+          new_pos_list->emplace_back((*input_pos_lists[row.chunk_id])[row.chunk_offset]);
+        }
+      }
+      resolved_pos_list = std::move(new_pos_list);
+    }
 
-  return name() + "\\n(" + join_mode_to_string.at(_mode) + " Join where " + column_name_left + " " +
-         scan_type_to_string.left.at(_scan_type) + " " + column_name_right + ")";
+    output_chunk.add_column(std::make_shared<ReferenceColumn>(first_reference_column->referenced_table(),
+                                                              first_reference_column->referenced_column_id(),
+                                                              resolved_pos_list));
+  }
 }
 
 }  // namespace opossum
@@ -12,7 +12,8 @@ namespace opossum {
 
 // operator to join two tables using one column of each table
 // output is a table with reference columns
-// to filter by multiple criteria, you can chain the operator
+// to filter by multiple criteria, you can chain the operator or, for equi joins, pass additional pairs of columns
+// that all have to be equal (composite-key join)
 
 // As with most operators, we do not guarantee a stable operation with regards
 // to positions - i.e., your sorting order might be disturbed
@@ -26,17 +27,44 @@ class AbstractJoinOperator : public AbstractReadOnlyOperator {
  public:
   AbstractJoinOperator(const std::shared_ptr<const AbstractOperator> left,
                        const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                       const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+                       const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                       const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids = {});
 
   JoinMode mode() const;
   const std::pair<ColumnID, ColumnID>& column_ids() const;
   ScanType scan_type() const;
+  const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids() const;
   const std::string description() const override;
 
  protected:
+  /**
+   * For composite-key joins (i.e., with additional_column_ids), the join algorithms do not compare the join columns
+   * one by one. Instead, all join columns of a row are encoded into a single normalized binary key, so that two rows
+   * match iff their keys are equal. Numeric columns of different types are widened to a common type first.
+   *
+   * The returned tables (left, right) have the same chunk layout as the input tables, so that RowIDs into them are
+   * valid RowIDs into the input tables. They contain the keys in a single nullable string column. Rows where any of the
+   * join columns is NULL get a NULL key.
+   */
+  std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>> _create_composite_key_tables() const;
+
+  /**
+   * Adds a ReferenceColumn for every column of input_table to output_chunk. pos_list contains the matched rows of
+   * input_table, NULL_ROW_ID stands for a NULL-extended row of an outer join.
+   *
+   * All output columns share pos_list instead of each getting a copy. If input_table is itself a reference table, the
+   * positions are resolved to the referenced table so that ReferenceColumns never reference ReferenceColumns. This is
+   * done only once for each distinct set of input position lists, so that all columns that came from the same table
+   * (which, after scans and joins, is usually all of them) share one resolved position list. Thus, a join on top of
+   * other joins copies its positions once per input table rather than once per column.
+   */
+  static void _write_output_columns(Chunk& output_chunk, const std::shared_ptr<const Table>& input_table,
+                                    const std::shared_ptr<const PosList>& pos_list);
+
   const JoinMode _mode;
   const std::pair<ColumnID, ColumnID> _column_ids;
   const ScanType _scan_type;
+  const std::vector<std::pair<ColumnID, ColumnID>> _additional_column_ids;
 
   // Some operators need an internal implementation class, mostly in cases where
   // their execute method depends on a template parameter. An example for this is
@@ -1,10 +1,12 @@
 #include "aggregate.hpp"
 
 #include <algorithm>
-#include <map>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -13,19 +15,244 @@
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/current_scheduler.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/dictionary_column.hpp"
+#include "storage/iterables/attribute_vector_iterable.hpp"
 #include "storage/iterables/create_iterable_from_column.hpp"
-#include "type_comparison.hpp"
+#include "storage/value_column.hpp"
+#include "table_wrapper.hpp"
 #include "utils/assert.hpp"
+#include "utils/murmur_hash.hpp"
+#include "utils/performance_warning.hpp"
+#include "utils/physical_memory.hpp"
+#include "utils/spill_file.hpp"
 
 namespace opossum {
 
+namespace {
+
+/**
+ * The local groups of all chunks are radix-partitioned for merging them. Small aggregations are merged by a single job,
+ * large ones by up to MAX_PARTITION_COUNT jobs that each merge about MIN_GROUPS_PER_PARTITION local groups or more.
+ */
+constexpr auto MAX_PARTITION_COUNT = size_t{64};
+constexpr auto MIN_GROUPS_PER_PARTITION = size_t{1'000};
+
+// The number of spill files is limited to bound the number of open files, see Aggregate::_aggregate_spilled()
+constexpr auto MAX_SPILL_PARTITION_COUNT = size_t{256};
+constexpr auto SPILLING_SEED = 31u;
+
+// The group keys of the rows of a chunk, see Aggregate::_pre_aggregate_chunk()
+struct ChunkGroupKeys {
+  // key_width words per row
+  std::vector<uint64_t> row_keys;
+
+  // If the only group-by column is dictionary-encoded, the keys of the dictionary's values (followed by the key of
+  // NULL) and the index of each row's key in there are stored instead. This way, each distinct value is hashed once.
+  bool uses_dictionary{false};
+  std::vector<uint64_t> dictionary_keys;
+  std::vector<ValueID> key_indices;
+
+  // The range of the integers in the keys, used for assigning GroupIDs without hashing
+  int64_t min_value{std::numeric_limits<int64_t>::max()};
+  int64_t max_value{std::numeric_limits<int64_t>::min()};
+};
+
+// Writes the words of a group-by column into the keys of a chunk, which has to be zero-initialized
+template <typename T>
+void write_key_words(const BaseColumn& column, const size_t column_idx, const size_t key_width,
+                     std::vector<uint64_t>& keys, StringKeyDictionary* string_dictionary) {
+  const auto null_word_idx = key_width - 1;
+  const auto null_bit = uint64_t{1} << column_idx;
+
+  resolve_column_type<T>(column, [&](const auto& typed_column) {
+    using ColumnType = std::decay_t<decltype(typed_column)>;
+
+    auto key = keys.data();
+
+    if constexpr (!std::is_same<T, std::string>::value) {
+      auto iterable = create_iterable_from_column<T>(typed_column);
+      iterable.for_each([&](const auto& value) {
+        if (value.is_null()) {
+          key[null_word_idx] |= null_bit;
+        } else {
+          key[column_idx] = encode_key_word(value.value());
+        }
+        key += key_width;
+      });
+    } else {
+      /**
+       * Strings are first replaced by ids that are local to this chunk and then translated into the ids of the
+       * StringKeyDictionary. This way, the dictionary is locked only once per chunk and only sees distinct strings.
+       */
+      auto local_to_global_ids = std::vector<uint64_t>{};
+
+      if constexpr (std::is_same<ColumnType, DictionaryColumn<T>>::value) {
+        // The ValueIDs already are local ids
+        auto iterable = AttributeVectorIterable{*typed_column.attribute_vector()};
+        iterable.for_each([&](const auto& value_id) {
+          if (value_id.is_null()) {
+            key[null_word_idx] |= null_bit;
+          } else {
+            key[column_idx] = value_id.value();
+          }
+          key += key_width;
+        });
+
+        local_to_global_ids = string_dictionary->get_or_add_ids(*typed_column.dictionary());
+      } else {
+        auto local_ids = std::unordered_map<std::string, uint64_t>{};
+        auto local_strings = std::vector<std::string>{};
+
+        auto iterable = create_iterable_from_column<T>(typed_column);
+        iterable.for_each([&](const auto& value) {
+          if (value.is_null()) {
+            key[null_word_idx] |= null_bit;
+          } else {
+            const auto inserted = local_ids.try_emplace(value.value(), local_strings.size());
+            if (inserted.second) local_strings.emplace_back(value.value());
+            key[column_idx] = inserted.first->second;
+          }
+          key += key_width;
+        });
+
+        local_to_global_ids = string_dictionary->get_or_add_ids(local_strings);
+      }
+
+      for (key = keys.data(); key != keys.data() + keys.size(); key += key_width) {
+        if (!(key[null_word_idx] & null_bit)) key[column_idx] = local_to_global_ids[key[column_idx]];
+      }
+    }
+  });
+}
+
+// Fast path for a single dictionary-encoded group-by column: only the keys of the dictionary's values are computed
+template <typename T>
+void write_dictionary_keys(const DictionaryColumn<T>& column, ChunkGroupKeys& chunk_keys,
+                           StringKeyDictionary* string_dictionary) {
+  const auto& dictionary = *column.dictionary();
+  const auto null_key_idx = static_cast<ValueID::base_type>(dictionary.size());
+
+  // Two words per key: the value and the NULL flag
+  chunk_keys.uses_dictionary = true;
+  chunk_keys.dictionary_keys.resize((dictionary.size() + 1) * 2);
+  chunk_keys.dictionary_keys[null_key_idx * 2 + 1] = 1;
+
+  if constexpr (std::is_same<T, std::string>::value) {
+    const auto ids = string_dictionary->get_or_add_ids(dictionary);
+    for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+      chunk_keys.dictionary_keys[value_id * 2] = ids[value_id];
+    }
+  } else {
+    for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+      chunk_keys.dictionary_keys[value_id * 2] = encode_key_word(dictionary[value_id]);
+    }
+
+    // The dictionary is sorted
+    if constexpr (std::is_integral<T>::value) {
+      if (!dictionary.empty()) {
+        chunk_keys.min_value = dictionary.front();
+        chunk_keys.max_value = dictionary.back();
+      }
+    }
+  }
+
+  chunk_keys.key_indices.reserve(column.size());
+  auto iterable = AttributeVectorIterable{*column.attribute_vector()};
+  iterable.for_each([&](const auto& value_id) {
+    chunk_keys.key_indices.emplace_back(value_id.is_null() ? ValueID{null_key_idx} : value_id.value());
+  });
+}
+
+// Returns the number of spill files (a power of two) needed so that the groups of each of them fit into the budget
+size_t spill_partition_count(const size_t estimated_size, const size_t memory_budget) {
+  const auto required_partition_count = estimated_size / std::max(memory_budget, size_t{1}) + 1;
+
+  auto partition_count = size_t{2};
+  while (partition_count < required_partition_count && partition_count < MAX_SPILL_PARTITION_COUNT) {
+    partition_count *= 2;
+  }
+  return partition_count;
+}
+
+// Combines the hashes of the rows of a chunk with the values of a group-by column. NULLs leave the hashes unchanged.
+template <typename T>
+void hash_groupby_column(const BaseColumn& column, std::vector<unsigned int>& row_hashes) {
+  resolve_column_type<T>(column, [&](const auto& typed_column) {
+    auto iterable = create_iterable_from_column<T>(typed_column);
+    iterable.for_each([&](const auto& value) {
+      if (value.is_null()) return;
+
+      auto& row_hash = row_hashes[value.chunk_offset()];
+      if constexpr (std::is_same<T, std::string>::value) {
+        row_hash = murmur2<std::string>(value.value(), row_hash);
+      } else {
+        // Values that are equal in a group key, such as -0.0 and 0.0, have to end up in the same partition
+        row_hash = murmur2<uint64_t>(encode_key_word(value.value()), row_hash);
+      }
+    });
+  });
+}
+
+// Writes the values of a column to the spill files, each file receiving the rows at its offsets
+template <typename T>
+void spill_column(const BaseColumn& column, const std::vector<std::vector<ChunkOffset>>& offsets_per_partition,
+                  std::vector<std::unique_ptr<SpillFile>>& files) {
+  auto values = std::vector<T>(column.size());
+  auto null_values = std::vector<uint8_t>(column.size());
+
+  resolve_column_type<T>(column, [&](const auto& typed_column) {
+    auto iterable = create_iterable_from_column<T>(typed_column);
+    iterable.for_each([&](const auto& value) {
+      if (value.is_null()) {
+        null_values[value.chunk_offset()] = true;
+      } else {
+        values[value.chunk_offset()] = value.value();
+      }
+    });
+  });
+
+  for (auto partition_idx = size_t{0}; partition_idx < files.size(); ++partition_idx) {
+    auto& file = *files[partition_idx];
+    for (const auto chunk_offset : offsets_per_partition[partition_idx]) {
+      file.write(null_values[chunk_offset]);
+      if (!null_values[chunk_offset]) file.write(values[chunk_offset]);
+    }
+  }
+}
+
+// Appends the next row_count values written by spill_column() to a nullable ValueColumn
+template <typename T>
+void read_spilled_column(SpillFile& file, const size_t row_count, BaseColumn& column) {
+  auto& value_column = static_cast<ValueColumn<T>&>(column);
+  auto& values = value_column.values();
+  auto& null_values = value_column.null_values();
+
+  for (auto row_idx = size_t{0}; row_idx < row_count; ++row_idx) {
+    auto is_null = uint8_t{0};
+    auto value = T{};
+    file.read(is_null);
+    if (!is_null) file.read(value);
+
+    values.push_back(std::move(value));
+    null_values.push_back(is_null);
+  }
+}
+
+}  // namespace
+
 AggregateDefinition::AggregateDefinition(const ColumnID column_id, const AggregateFunction function,
                                          const std::optional<std::string>& alias)
     : column_id(column_id), function(function), alias(alias) {}
 
 Aggregate::Aggregate(const std::shared_ptr<AbstractOperator> in, const std::vector<AggregateDefinition> aggregates,
-                     const std::vector<ColumnID> groupby_column_ids)
-    : AbstractReadOnlyOperator(in), _aggregates(aggregates), _groupby_column_ids(groupby_column_ids) {
+                     const std::vector<ColumnID> groupby_column_ids,
+                     const Projection::ColumnExpressions& column_expressions,
+                     const std::optional<size_t>& memory_budget)
+    : AbstractReadOnlyOperator(in),
+      _aggregates(aggregates),
+      _groupby_column_ids(groupby_column_ids),
+      _column_expressions(column_expressions),
+      _memory_budget(memory_budget) {
   Assert(!(aggregates.empty() && groupby_column_ids.empty()),
          "Neither aggregate nor groupby columns have been specified");
 }
@@ -34,664 +261,833 @@ const std::vector<AggregateDefinition>& Aggregate::aggregates() const { return _
 
 const std::vector<ColumnID>& Aggregate::groupby_column_ids() const { return _groupby_column_ids; }
 
+const Projection::ColumnExpressions& Aggregate::column_expressions() const { return _column_expressions; }
+
 const std::string Aggregate::name() const { return "Aggregate"; }
 
 std::shared_ptr<AbstractOperator> Aggregate::recreate(const std::vector<AllParameterVariant>& args) const {
-  return std::make_shared<Aggregate>(_input_left->recreate(args), _aggregates, _groupby_column_ids);
+  return std::make_shared<Aggregate>(_input_left->recreate(args), _aggregates, _groupby_column_ids,
+                                     _column_expressions, _memory_budget);
 }
 
-/*
-Visitor context for the partitioning/grouping visitor
-*/
-struct GroupByContext : ColumnVisitableContext {
-  GroupByContext(std::shared_ptr<const Table> t, ChunkID chunk, ColumnID column,
-                 std::shared_ptr<std::vector<AggregateKey>> keys)
-      : table_in(t), chunk_id(chunk), column_id(column), hash_keys(keys) {}
-
-  // constructor for use in ReferenceColumn::visit_dereferenced
-  GroupByContext(std::shared_ptr<BaseColumn>, const std::shared_ptr<const Table> referenced_table,
-                 std::shared_ptr<ColumnVisitableContext> base_context, ChunkID chunk_id,
-                 std::shared_ptr<std::vector<ChunkOffset>> chunk_offsets)
-      : table_in(referenced_table),
-        chunk_id(chunk_id),
-        column_id(std::static_pointer_cast<GroupByContext>(base_context)->column_id),
-        hash_keys(std::static_pointer_cast<GroupByContext>(base_context)->hash_keys),
-        chunk_offsets_in(chunk_offsets) {}
-
-  std::shared_ptr<const Table> table_in;
-  ChunkID chunk_id;
-  const ColumnID column_id;
-  std::shared_ptr<std::vector<AggregateKey>> hash_keys;
-  std::shared_ptr<std::vector<ChunkOffset>> chunk_offsets_in;
-};
+size_t Aggregate::default_memory_budget() {
+  return static_cast<size_t>(DEFAULT_MEMORY_BUDGET_FRACTION * physical_memory_size());
+}
 
-/*
-Visitor context for the AggregateVisitor.
-*/
-template <typename ColumnType, typename AggregateType>
-struct AggregateContext : ColumnVisitableContext {
-  AggregateContext() {}
-  explicit AggregateContext(std::shared_ptr<GroupByContext> base_context) : groupby_context(base_context) {}
-
-  // constructor for use in ReferenceColumn::visit_dereferenced
-  AggregateContext(std::shared_ptr<BaseColumn>, const std::shared_ptr<const Table>,
-                   std::shared_ptr<ColumnVisitableContext> base_context, ChunkID chunk_id,
-                   std::shared_ptr<std::vector<ChunkOffset>> chunk_offsets)
-      : groupby_context(std::static_pointer_cast<AggregateContext>(base_context)->groupby_context),
-        results(std::static_pointer_cast<AggregateContext>(base_context)->results) {
-    groupby_context->chunk_id = chunk_id;
-    groupby_context->chunk_offsets_in = chunk_offsets;
-  }
-
-  std::shared_ptr<GroupByContext> groupby_context;
-  std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>> results;
-};
+std::shared_ptr<const Table> Aggregate::_on_execute() {
+  auto input_table = _input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  _validate_aggregates();
+
+  // Group keys have a word with one NULL flag for each group-by column
+  Assert(_groupby_column_ids.size() <= 64, "Aggregate: Cannot group by more than 64 columns");
+
+  const auto memory_budget = _memory_budget ? *_memory_budget : default_memory_budget();
+  const auto spill = [&](const size_t estimated_size) {
+    PerformanceWarning("Aggregate exceeds its memory budget and spills to disk");
+    return _aggregate_spilled(spill_partition_count(estimated_size, memory_budget));
+  };
+
+  // A single group-by column that is dictionary-encoded in all chunks does not need group keys at all. Columns computed
+  // by an expression never are.
+  if (_groupby_column_ids.size() == 1 && chunk_count > 0) {
+    const auto column_id = _groupby_column_ids.front();
+    auto is_dictionary_encoded =
+        _column_expressions.empty() || _column_expressions[column_id]->type() == ExpressionType::Column;
+    for (ChunkID chunk_id{0}; chunk_id < chunk_count && is_dictionary_encoded; ++chunk_id) {
+      const auto column = _input_column(chunk_id, column_id);
+      is_dictionary_encoded = static_cast<bool>(std::dynamic_pointer_cast<const BaseDictionaryColumn>(column));
+    }
 
-/*
-The following structs describe the different aggregate traits.
-Given a ColumnType and AggregateFunction, certain traits like the aggregate type
-can be deduced.
-*/
-template <typename ColumnType, AggregateFunction function, class Enable = void>
-struct AggregateTraits {};
-
-// COUNT on all types
-template <typename ColumnType>
-struct AggregateTraits<ColumnType, AggregateFunction::Count> {
-  typedef ColumnType column_type;
-  typedef int64_t aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Long;
-};
+    if (is_dictionary_encoded) {
+      // Each chunk has one local group per value of its dictionary and one for NULL
+      auto local_group_count = size_t{0};
+      for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto column = _input_column(chunk_id, column_id);
+        local_group_count += std::static_pointer_cast<const BaseDictionaryColumn>(column)->unique_values_count() + 1;
+      }
 
-// COUNT(DISTINCT) on all types
-template <typename ColumnType>
-struct AggregateTraits<ColumnType, AggregateFunction::CountDistinct> {
-  typedef ColumnType column_type;
-  typedef int64_t aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Long;
-};
+      const auto estimated_size = local_group_count * _estimated_group_size();
+      if (estimated_size > memory_budget) return spill(estimated_size);
 
-// MIN/MAX on all types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Min || function == AggregateFunction::Max, void>> {
-  typedef ColumnType column_type;
-  typedef ColumnType aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Null;
-};
+      std::shared_ptr<const Table> output;
+      resolve_data_type(_input_column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        output = _aggregate_by_value_ids<ColumnDataType>();
+      });
+      return output;
+    }
+  }
 
-// AVG on arithmetic types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Avg && std::is_arithmetic<ColumnType>::value, void>> {
-  typedef ColumnType column_type;
-  typedef double aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Double;
-};
+  _string_dictionaries = std::vector<std::unique_ptr<StringKeyDictionary>>(_groupby_column_ids.size());
+  for (auto groupby_column_idx = size_t{0}; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+    if (_input_column_type(_groupby_column_ids[groupby_column_idx]) == DataType::String) {
+      _string_dictionaries[groupby_column_idx] = std::make_unique<StringKeyDictionary>();
+    }
+  }
 
-// SUM on integers
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_integral<ColumnType>::value, void>> {
-  typedef ColumnType column_type;
-  typedef int64_t aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Long;
-};
+  /*
+  PRE-AGGREGATION PHASE
+  Each chunk is aggregated by a separate job into groups that are local to the chunk. If there are multiple chunks,
+  the first one is aggregated upfront as a sample for estimating whether the groups of all chunks fit into the budget.
+  */
+  auto chunk_aggregates = std::vector<PartialAggregates>(chunk_count);
+  auto first_chunk_id = ChunkID{0};
+
+  if (!_groupby_column_ids.empty() && chunk_count > 1 && input_table->get_chunk(ChunkID{0}).size() > 0) {
+    chunk_aggregates[0] = _pre_aggregate_chunk(ChunkID{0});
+    first_chunk_id = ChunkID{1};
+
+    const auto sample_row_count = input_table->get_chunk(ChunkID{0}).size();
+    const auto estimated_local_group_count =
+        chunk_aggregates[0].groups->group_count() * input_table->row_count() / sample_row_count;
+    const auto estimated_size = estimated_local_group_count * _estimated_group_size();
+    if (estimated_size > memory_budget) {
+      chunk_aggregates.clear();
+      _string_dictionaries.clear();
+      return spill(estimated_size);
+    }
+  }
 
-// SUM on floating point numbers
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<
-    ColumnType, function,
-    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_floating_point<ColumnType>::value, void>> {
-  typedef ColumnType column_type;
-  typedef double aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Double;
-};
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_count);
 
-// invalid: AVG on non-arithmetic types
-template <typename ColumnType, AggregateFunction function>
-struct AggregateTraits<ColumnType, function, typename std::enable_if_t<!std::is_arithmetic<ColumnType>::value &&
-                                                                           (function == AggregateFunction::Avg ||
-                                                                            function == AggregateFunction::Sum),
-                                                                       void>> {
-  typedef ColumnType column_type;
-  typedef ColumnType aggregate_type;
-  static constexpr DataType aggregate_data_type = DataType::Null;
-};
+  for (ChunkID chunk_id{first_chunk_id}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>(
+        [&, chunk_id]() { chunk_aggregates[chunk_id] = _pre_aggregate_chunk(chunk_id); }));
+    jobs.back()->schedule();
+  }
 
-/*
-The AggregateFunctionBuilder is used to create the lambda function that will be used by
-the AggregateVisitor. It is a separate class because methods cannot be partially specialized.
-Therefore, we partially specialize the whole class and define the get_aggregate_function anew every time.
-*/
-template <typename ColumnType, typename AggregateType>
-using AggregateFunctor = std::function<std::optional<AggregateType>(ColumnType, std::optional<AggregateType>)>;
-
-template <typename ColumnType, typename AggregateType, AggregateFunction function>
-struct AggregateFunctionBuilder {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() { Fail("Invalid aggregate function"); }
-};
+  CurrentScheduler::wait_for_tasks(jobs);
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Min> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      if (!current_aggregate || value_smaller(new_value, *current_aggregate)) {
-        // New minimum found
-        return new_value;
-      }
-      return *current_aggregate;
-    };
+  /*
+  MERGE PHASE
+  The local groups of each chunk are radix-partitioned by the topmost bits of the hash of their keys. Equal keys end up
+  in the same partition, so each partition can be merged by a separate job.
+  */
+  auto local_group_count = size_t{0};
+  for (const auto& partial_aggregates : chunk_aggregates) {
+    local_group_count += partial_aggregates.groups->group_count();
   }
-};
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Max> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      if (!current_aggregate || value_greater(new_value, *current_aggregate)) {
-        // New maximum found
-        return new_value;
-      }
-      return *current_aggregate;
-    };
+  auto radix_bits = size_t{0};
+  while ((size_t{1} << radix_bits) < MAX_PARTITION_COUNT &&
+         (size_t{1} << radix_bits) * MIN_GROUPS_PER_PARTITION < local_group_count) {
+    ++radix_bits;
   }
-};
+  const auto partition_count = size_t{1} << radix_bits;
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Sum> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      // add new value to sum
-      return new_value + (!current_aggregate ? 0 : *current_aggregate);
-    };
-  }
-};
+  auto groups_per_partition = std::vector<std::vector<std::vector<GroupID>>>(chunk_count);
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Avg> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType new_value, std::optional<AggregateType> current_aggregate) {
-      // add new value to sum
-      return new_value + (!current_aggregate ? 0 : *current_aggregate);
-    };
-  }
-};
+  jobs.clear();
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto& groups = *chunk_aggregates[chunk_id].groups;
+      auto& partitions = groups_per_partition[chunk_id];
+      partitions.resize(partition_count);
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::Count> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType, std::optional<AggregateType> current_aggregate) { return std::nullopt; };
+      for (auto group_id = GroupID{0}; group_id < groups.group_count(); ++group_id) {
+        const auto partition_idx = radix_bits == 0 ? 0 : groups.hash(groups.group_key(group_id)) >> (64 - radix_bits);
+        partitions[partition_idx].emplace_back(group_id);
+      }
+    }));
+    jobs.back()->schedule();
   }
-};
 
-template <typename ColumnType, typename AggregateType>
-struct AggregateFunctionBuilder<ColumnType, AggregateType, AggregateFunction::CountDistinct> {
-  AggregateFunctor<ColumnType, AggregateType> get_aggregate_function() {
-    return [](ColumnType, std::optional<AggregateType> current_aggregate) { return std::nullopt; };
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  auto partitions = std::vector<PartialAggregates>(partition_count);
+
+  jobs.clear();
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      partitions[partition_idx] = _merge_partition(chunk_aggregates, groups_per_partition, partition_idx);
+    }));
+    jobs.back()->schedule();
   }
-};
 
-template <typename ColumnDataType, AggregateFunction function>
-void Aggregate::_aggregate_column(ChunkID chunk_id, ColumnID column_index, const BaseColumn& base_column) {
-  using AggregateType = typename AggregateTraits<ColumnDataType, function>::aggregate_type;
+  CurrentScheduler::wait_for_tasks(jobs);
 
-  auto aggregator = AggregateFunctionBuilder<ColumnDataType, AggregateType, function>().get_aggregate_function();
+  chunk_aggregates.clear();
 
-  // create context if it doesn't exist yet
-  if (!_contexts_per_column[column_index]) {
-    _contexts_per_column[column_index] = std::make_shared<AggregateContext<ColumnDataType, AggregateType>>();
+  /*
+  OUTPUT
+  The groups of each partition are written to a separate range of the output columns.
+  */
+  auto partition_offsets = std::vector<size_t>(partition_count);
+  auto group_count = size_t{0};
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    partition_offsets[partition_idx] = group_count;
+    group_count += partitions[partition_idx].groups->group_count();
   }
 
-  auto& context =
-      *std::static_pointer_cast<AggregateContext<ColumnDataType, AggregateType>>(_contexts_per_column[column_index]);
+  auto output = std::make_shared<Table>();
+  _add_output_column_definitions(*output);
+  const auto output_columns = _create_output_columns(group_count);
 
-  if (!context.results) {
-    context.results = std::make_shared<std::map<AggregateKey, AggregateResult<AggregateType, ColumnDataType>>>();
+  jobs.clear();
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      _write_output(partitions[partition_idx], partition_offsets[partition_idx], output_columns);
+    }));
+    jobs.back()->schedule();
   }
 
-  auto& results = *context.results;
-  auto& hash_keys = _keys_per_chunk[chunk_id];
+  CurrentScheduler::wait_for_tasks(jobs);
 
-  resolve_column_type<ColumnDataType>(base_column, [&results, &hash_keys, aggregator](const auto& typed_column) {
-    auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+  Chunk output_chunk;
+  for (const auto& output_column : output_columns) {
+    output_chunk.add_column(output_column);
+  }
+  output->emplace_chunk(std::move(output_chunk));
 
-    ChunkOffset chunk_offset{0};
+  _string_dictionaries.clear();
 
-    // Now that all relevant types have been resolved, we can iterate over the column and build the aggregations.
-    iterable.for_each([&, aggregator](const auto& value) {
-      if (value.is_null()) {
-        /**
-         * If the value is NULL, the current aggregate value does not change.
-         * However, if we do not have a result entry for the current hash key, i.e., group value,
-         * we need to insert an empty AggregateResult into the results.
-         * Hence, the try_emplace with no constructing arguments.
-         */
-        results.try_emplace((*hash_keys)[chunk_offset]);
-      } else {
-        // If we have a value, use the aggregator lambda to update the current aggregate value for this group
-        results[(*hash_keys)[chunk_offset]].current_aggregate =
-            aggregator(value.value(), results[(*hash_keys)[chunk_offset]].current_aggregate);
+  return output;
+}
 
-        // increase value counter
-        ++results[(*hash_keys)[chunk_offset]].aggregate_count;
+DataType Aggregate::_input_column_type(const ColumnID column_id) const {
+  if (_column_expressions.empty()) return _input_table_left()->column_type(column_id);
 
-        if (function == AggregateFunction::CountDistinct) {
-          // for the case of CountDistinct, insert this value into the set to keep track of distinct values
-          results[(*hash_keys)[chunk_offset]].distinct_values.insert(value.value());
-        }
-      }
+  const auto data_type = Projection::get_type_of_expression(_column_expressions[column_id], _input_table_left());
+  return data_type == DataType::Null ? DataType::Int : data_type;
+}
 
-      ++chunk_offset;
-    });
-  });
+const std::string Aggregate::_input_column_name(const ColumnID column_id) const {
+  if (_column_expressions.empty()) return _input_table_left()->column_name(column_id);
+
+  return Projection::get_name_of_expression(_column_expressions[column_id], _input_table_left());
 }
 
-std::shared_ptr<const Table> Aggregate::_on_execute() {
-  auto input_table = _input_table_left();
+std::shared_ptr<const BaseColumn> Aggregate::_input_column(const ChunkID chunk_id, const ColumnID column_id) const {
+  const auto input_table = _input_table_left();
+  if (_column_expressions.empty()) return input_table->get_chunk(chunk_id).get_column(column_id);
+
+  return Projection::evaluate_expression_on_chunk(_column_expressions[column_id], input_table, chunk_id);
+}
+
+std::shared_ptr<const Chunk> Aggregate::_input_chunk(const ChunkID chunk_id) const {
+  const auto input_table = _input_table_left();
+  if (_column_expressions.empty()) {
+    // The chunk is owned by the input table
+    return std::shared_ptr<const Chunk>(input_table, &input_table->get_chunk(chunk_id));
+  }
 
-  // check for invalid aggregates
+  auto chunk = std::make_shared<Chunk>();
+  for (const auto& column_expression : _column_expressions) {
+    chunk->add_column(Projection::evaluate_expression_on_chunk(column_expression, input_table, chunk_id));
+  }
+  return chunk;
+}
+
+void Aggregate::_validate_aggregates() const {
   for (const auto& aggregate : _aggregates) {
     if (aggregate.column_id == CountStarID) {
       if (aggregate.function != AggregateFunction::Count) {
         Fail("Aggregate: Asterisk is only valid with COUNT");
       }
-    } else if (input_table->column_type(aggregate.column_id) == DataType::String &&
+    } else if (_input_column_type(aggregate.column_id) == DataType::String &&
                (aggregate.function == AggregateFunction::Sum || aggregate.function == AggregateFunction::Avg)) {
       Fail("Aggregate: Cannot calculate SUM or AVG on string column");
     }
   }
+}
+
+template <typename ColumnDataType>
+std::shared_ptr<const Table> Aggregate::_aggregate_by_value_ids() const {
+  const auto input_table = _input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+  const auto column_id = _groupby_column_ids.front();
+
+  // The group-by column is not computed by an expression, so it is owned by the input table
+  const auto get_dictionary_column = [&](const ChunkID chunk_id) -> const DictionaryColumn<ColumnDataType>& {
+    const auto& column = *_input_column(chunk_id, column_id);
+    return static_cast<const DictionaryColumn<ColumnDataType>&>(column);
+  };
 
   /*
-  PARTITIONING PHASE
-  First we partition the input chunks by the given group key(s).
-  This is done by creating a vector that contains the AggregateKey for each row.
-  It is gradually built by visitors, one for each group column.
+  PRE-AGGREGATION PHASE
+  The ValueIDs of each chunk are its local GroupIDs, and NULL is assigned the GroupID following the last ValueID.
   */
-  _keys_per_chunk = std::vector<std::shared_ptr<std::vector<AggregateKey>>>(input_table->chunk_count());
+  auto chunk_states = std::vector<std::vector<std::unique_ptr<BaseAggregateStates>>>(chunk_count);
+  // Not std::vector<bool>, as it is written concurrently
+  auto chunk_has_null = std::vector<uint8_t>(chunk_count);
 
   std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(input_table->chunk_count());
+  jobs.reserve(chunk_count);
+
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto& column = get_dictionary_column(chunk_id);
+      const auto null_group_id = static_cast<GroupID>(column.dictionary()->size());
+
+      auto group_ids = std::vector<GroupID>{};
+      group_ids.reserve(column.size());
+
+      auto iterable = AttributeVectorIterable{*column.attribute_vector()};
+      iterable.for_each([&](const auto& value_id) {
+        if (value_id.is_null()) {
+          chunk_has_null[chunk_id] = true;
+          group_ids.emplace_back(null_group_id);
+        } else {
+          group_ids.emplace_back(value_id.value());
+        }
+      });
 
-  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id, this]() {
-      const Chunk& chunk_in = input_table->get_chunk(chunk_id);
+      const auto chunk = _input_chunk(chunk_id);
+      for (const auto& aggregate : _aggregates) {
+        auto states = _create_aggregate_states(aggregate);
+        states->resize(null_group_id + 1);
+        states->aggregate(*chunk, group_ids);
+        chunk_states[chunk_id].emplace_back(std::move(states));
+      }
+    }));
+    jobs.back()->schedule();
+  }
 
-      auto hash_keys = std::make_shared<std::vector<AggregateKey>>(chunk_in.size());
+  CurrentScheduler::wait_for_tasks(jobs);
 
-      // Partition by group columns
-      for (const auto column_id : _groupby_column_ids) {
-        auto base_column = chunk_in.get_column(column_id);
-        auto column_type = input_table->column_type(column_id);
+  /*
+  MERGE PHASE
+  The GroupIDs of the output are the positions in the sorted union of all dictionaries. As all dictionaries are sorted,
+  the ValueIDs of a chunk are translated into these GroupIDs by a single pass over both.
+  */
+  auto values = std::vector<ColumnDataType>{};
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& dictionary = *get_dictionary_column(chunk_id).dictionary();
+    values.insert(values.end(), dictionary.cbegin(), dictionary.cend());
+  }
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+
+  const auto has_null =
+      std::any_of(chunk_has_null.cbegin(), chunk_has_null.cend(), [](const auto chunk_flag) { return chunk_flag; });
+  const auto null_group_id = static_cast<GroupID>(values.size());
+  const auto group_count = values.size() + (has_null ? 1 : 0);
+
+  auto source_group_ids = std::vector<std::vector<GroupID>>(chunk_count);
+  auto target_group_ids = std::vector<std::vector<GroupID>>(chunk_count);
+
+  jobs.clear();
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto& dictionary = *get_dictionary_column(chunk_id).dictionary();
+      auto& sources = source_group_ids[chunk_id];
+      auto& targets = target_group_ids[chunk_id];
+      sources.reserve(dictionary.size() + 1);
+      targets.reserve(dictionary.size() + 1);
+
+      auto group_id = GroupID{0};
+      for (auto value_id = GroupID{0}; value_id < dictionary.size(); ++value_id) {
+        while (values[group_id] < dictionary[value_id]) ++group_id;
+        sources.emplace_back(value_id);
+        targets.emplace_back(group_id);
+      }
 
-        resolve_data_and_column_type(column_type, *base_column, [&](auto type, auto& typed_column) {
-          using ColumnDataType = typename decltype(type)::type;
+      if (chunk_has_null[chunk_id]) {
+        sources.emplace_back(static_cast<GroupID>(dictionary.size()));
+        targets.emplace_back(null_group_id);
+      }
+    }));
+    jobs.back()->schedule();
+  }
 
-          auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+  CurrentScheduler::wait_for_tasks(jobs);
 
-          ChunkOffset chunk_offset{0};
-          iterable.for_each([&](const auto& value) {
-            if (value.is_null()) {
-              (*hash_keys)[chunk_offset].emplace_back(NULL_VALUE);
-            } else {
-              (*hash_keys)[chunk_offset].emplace_back(value.value());
-            }
+  auto output = std::make_shared<Table>();
+  _add_output_column_definitions(*output);
+  const auto output_columns = _create_output_columns(group_count);
 
-            ++chunk_offset;
-          });
-        });
+  jobs.clear();
+  for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, aggregate_idx]() {
+      auto states = _create_aggregate_states(_aggregates[aggregate_idx]);
+      states->resize(group_count);
+
+      for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+        states->merge(*chunk_states[chunk_id][aggregate_idx], source_group_ids[chunk_id], target_group_ids[chunk_id]);
+        chunk_states[chunk_id][aggregate_idx].reset();
       }
 
-      _keys_per_chunk[chunk_id] = hash_keys;
+      states->write_output(*output_columns[1 + aggregate_idx], 0);
     }));
     jobs.back()->schedule();
   }
 
+  /*
+  OUTPUT
+  The group-by values are the sorted union of the dictionaries, followed by NULL.
+  */
+  auto& groupby_column = static_cast<ValueColumn<ColumnDataType>&>(*output_columns.front());
+  std::move(values.begin(), values.end(), groupby_column.values().begin());
+  if (has_null) groupby_column.null_values()[null_group_id] = true;
+
   CurrentScheduler::wait_for_tasks(jobs);
 
+  Chunk output_chunk;
+  for (const auto& output_column : output_columns) {
+    output_chunk.add_column(output_column);
+  }
+  output->emplace_chunk(std::move(output_chunk));
+
+  return output;
+}
+
+size_t Aggregate::_estimated_group_size() const {
+  // The group key, the hash table's slot for it (at a load factor of 0.5), and the key of the merged group
+  auto size = 2 * (_groupby_column_ids.size() + 1) * sizeof(uint64_t) + 2 * sizeof(uint64_t);
+  for (const auto column_id : _groupby_column_ids) {
+    if (_input_column_type(column_id) == DataType::String) size += sizeof(std::string);
+  }
+
+  // Each aggregate keeps a value and a count for the local and for the merged group. Distinct values are stored in a
+  // hash set, whose size can only be guessed.
+  for (const auto& aggregate : _aggregates) {
+    size += 4 * sizeof(uint64_t);
+    if (aggregate.function == AggregateFunction::CountDistinct) size += 8 * sizeof(uint64_t);
+  }
+
+  return size;
+}
+
+std::shared_ptr<const Table> Aggregate::_aggregate_spilled(const size_t partition_count) const {
+  const auto input_table = _input_table_left();
+
+  // Only the group-by columns and the aggregated columns are spilled, in the order of their ColumnIDs
+  auto spilled_column_ids = _groupby_column_ids;
+  for (const auto& aggregate : _aggregates) {
+    if (aggregate.column_id != CountStarID) spilled_column_ids.emplace_back(aggregate.column_id);
+  }
+  std::sort(spilled_column_ids.begin(), spilled_column_ids.end());
+  spilled_column_ids.erase(std::unique(spilled_column_ids.begin(), spilled_column_ids.end()),
+                           spilled_column_ids.end());
+
+  const auto spilled_column_id = [&](const ColumnID column_id) {
+    const auto it = std::lower_bound(spilled_column_ids.cbegin(), spilled_column_ids.cend(), column_id);
+    return ColumnID{static_cast<ColumnID::base_type>(std::distance(spilled_column_ids.cbegin(), it))};
+  };
+
+  auto files = std::vector<std::unique_ptr<SpillFile>>{};
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    files.emplace_back(std::make_unique<SpillFile>());
+  }
+  auto row_counts = std::vector<size_t>(partition_count);
+
   /*
-  AGGREGATION PHASE
+  PARTITIONING PHASE
+  The rows of each chunk are assigned to the spill files by the hash of their group-by values. Each file receives a
+  block per chunk: the number of the chunk's rows in it, followed by their values, one spilled column after another.
   */
-  _contexts_per_column = std::vector<std::shared_ptr<ColumnVisitableContext>>(_aggregates.size());
+  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto chunk_ptr = _input_chunk(chunk_id);
+    const auto& chunk = *chunk_ptr;
+    if (chunk.size() == 0) continue;
+
+    auto row_hashes = std::vector<unsigned int>(chunk.size(), SPILLING_SEED);
+    for (const auto column_id : _groupby_column_ids) {
+      resolve_data_type(_input_column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        hash_groupby_column<ColumnDataType>(*chunk.get_column(column_id), row_hashes);
+      });
+    }
 
-  if (_aggregates.empty()) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
+    auto offsets_per_partition = std::vector<std::vector<ChunkOffset>>(partition_count);
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      offsets_per_partition[row_hashes[chunk_offset] & (partition_count - 1)].emplace_back(chunk_offset);
+    }
 
-    We choose int8_t for column type and aggregate type because it's small.
-    */
-    auto context = std::make_shared<AggregateContext<DistinctColumnType, DistinctAggregateType>>();
-    context->results =
-        std::make_shared<std::map<AggregateKey, AggregateResult<DistinctAggregateType, DistinctColumnType>>>();
+    for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+      const auto block_row_count = static_cast<uint32_t>(offsets_per_partition[partition_idx].size());
+      if (block_row_count == 0) continue;
 
-    _contexts_per_column.push_back(context);
+      files[partition_idx]->write(block_row_count);
+      row_counts[partition_idx] += block_row_count;
+    }
+
+    for (const auto column_id : spilled_column_ids) {
+      resolve_data_type(_input_column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        spill_column<ColumnDataType>(*chunk.get_column(column_id), offsets_per_partition, files);
+      });
+    }
   }
 
-  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-    const Chunk& chunk_in = input_table->get_chunk(chunk_id);
+  /*
+  AGGREGATION PHASE
+  All rows of a group are in the same file, so the files are aggregated one at a time and their groups are appended to
+  the output. The partitions are not split up any further: A partition that still exceeds the budget, e.g., because of
+  skew, is aggregated in memory nevertheless.
+  */
+  auto partition_aggregates = std::vector<AggregateDefinition>{};
+  for (const auto& aggregate : _aggregates) {
+    const auto column_id = aggregate.column_id == CountStarID ? CountStarID : spilled_column_id(aggregate.column_id);
+    partition_aggregates.emplace_back(column_id, aggregate.function, aggregate.alias);
+  }
 
-    auto hash_keys = _keys_per_chunk[chunk_id];
+  auto partition_groupby_column_ids = std::vector<ColumnID>{};
+  for (const auto column_id : _groupby_column_ids) {
+    partition_groupby_column_ids.emplace_back(spilled_column_id(column_id));
+  }
 
-    if (_aggregates.empty()) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by grouping without aggregation.
-       *
-       * For a query like "SELECT DISTINCT * FROM A;"
-       * we would assume that all columns from A are part of 'groupby_columns',
-       * respectively any columns that were specified in the projection.
-       * The optimizer is responsible to take care of passing in the correct columns.
-       *
-       * How does this operation work?
-       * Distinct rows are retrieved by grouping by vectors of values. Similar as for the usual aggregation
-       * these vectors are used as keys in the 'column_results' map.
-       *
-       * At this point we've got all the different keys from the chunks and accumulate them in 'column_results'.
-       * In order to reuse the aggregation implementation, we add a dummy AggregateResult.
-       * One could optimize here in the future.
-       *
-       * Obviously this implementation is also used for plain GroupBy's.
-       */
+  const auto create_partition_columns = [&]() {
+    auto columns = std::vector<std::shared_ptr<BaseColumn>>{};
+    for (const auto column_id : spilled_column_ids) {
+      resolve_data_type(_input_column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        columns.emplace_back(std::make_shared<ValueColumn<ColumnDataType>>(true));
+      });
+    }
+    return columns;
+  };
 
-      auto context = std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType>>(
-          _contexts_per_column[0]);
-      auto& results = *context->results;
-      for (auto& chunk : _keys_per_chunk) {
-        for (auto& keys : *chunk) {
-          // insert dummy value to make sure we have the key in our map
-          results[keys] = AggregateResult<DistinctAggregateType, DistinctColumnType>();
-        }
-      }
-    } else {
-      ColumnID column_index{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then basically go through the _keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
-        if (aggregate.column_id == CountStarID && aggregate.function == AggregateFunction::Count) {
-          // We know the template arguments, so we don't need a visitor
-          if (!_contexts_per_column[column_index]) {
-            _contexts_per_column[column_index] =
-                std::make_shared<AggregateContext<CountColumnType, CountAggregateType>>();
-          }
+  auto output = std::make_shared<Table>();
+  _add_output_column_definitions(*output);
 
-          auto context = std::static_pointer_cast<AggregateContext<CountColumnType, CountAggregateType>>(
-              _contexts_per_column[column_index]);
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    if (row_counts[partition_idx] == 0) continue;
 
-          if (!context->results) {
-            // create result map for the first time if necessary
-            context->results =
-                std::make_shared<std::map<AggregateKey, AggregateResult<CountAggregateType, CountColumnType>>>();
-          }
+    auto& file = *files[partition_idx];
+    file.rewind();
 
-          auto& results = *context->results;
+    auto partition_table = std::make_shared<Table>(input_table->max_chunk_size());
+    for (const auto column_id : spilled_column_ids) {
+      partition_table->add_column_definition(_input_column_name(column_id), _input_column_type(column_id), true);
+    }
 
-          // count occurrences for each group key
-          for (const auto& hash_key : *hash_keys) {
-            ++results[hash_key].aggregate_count;
-          }
+    // The blocks are read into chunks of at most the input's chunk size
+    auto columns = create_partition_columns();
+    auto chunk_row_count = size_t{0};
 
-          ++column_index;
-          continue;
-        }
+    const auto emplace_partition_chunk = [&]() {
+      Chunk chunk;
+      for (const auto& column : columns) {
+        chunk.add_column(column);
+      }
+      partition_table->emplace_chunk(std::move(chunk));
+    };
 
-        auto base_column = chunk_in.get_column(aggregate.column_id);
-        auto data_type = input_table->column_type(aggregate.column_id);
+    for (auto read_row_count = size_t{0}; read_row_count < row_counts[partition_idx];) {
+      auto block_row_count = uint32_t{0};
+      file.read(block_row_count);
 
-        /*
-        Invoke correct aggregator for each column
-        */
+      if (chunk_row_count > 0 && chunk_row_count + block_row_count > input_table->max_chunk_size()) {
+        emplace_partition_chunk();
+        columns = create_partition_columns();
+        chunk_row_count = 0;
+      }
 
-        resolve_data_type(data_type, [&, this, aggregate](auto type) {
+      for (auto column_idx = size_t{0}; column_idx < spilled_column_ids.size(); ++column_idx) {
+        resolve_data_type(_input_column_type(spilled_column_ids[column_idx]), [&](auto type) {
           using ColumnDataType = typename decltype(type)::type;
-
-          switch (aggregate.function) {
-            case AggregateFunction::Min:
-              _aggregate_column<ColumnDataType, AggregateFunction::Min>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_column<ColumnDataType, AggregateFunction::Max>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_column<ColumnDataType, AggregateFunction::Sum>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_column<ColumnDataType, AggregateFunction::Avg>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_column<ColumnDataType, AggregateFunction::Count>(chunk_id, column_index, *base_column);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_column<ColumnDataType, AggregateFunction::CountDistinct>(chunk_id, column_index, *base_column);
-              break;
-          }
+          read_spilled_column<ColumnDataType>(file, block_row_count, *columns[column_idx]);
         });
+      }
 
-        ++column_index;
+      chunk_row_count += block_row_count;
+      read_row_count += block_row_count;
+    }
+    emplace_partition_chunk();
+    files[partition_idx].reset();
+
+    auto table_wrapper = std::make_shared<TableWrapper>(partition_table);
+    table_wrapper->execute();
+    auto partition_aggregate =
+        std::make_shared<Aggregate>(table_wrapper, partition_aggregates, partition_groupby_column_ids,
+                                    Projection::ColumnExpressions{}, std::numeric_limits<size_t>::max());
+    partition_aggregate->execute();
+
+    const auto partition_output = partition_aggregate->get_output();
+    for (ChunkID chunk_id{0}; chunk_id < partition_output->chunk_count(); ++chunk_id) {
+      const auto& partition_chunk = partition_output->get_chunk(chunk_id);
+
+      Chunk output_chunk;
+      for (ColumnID column_id{0}; column_id < partition_chunk.column_count(); ++column_id) {
+        output_chunk.add_column(partition_chunk.get_mutable_column(column_id));
       }
+      output->emplace_chunk(std::move(output_chunk));
     }
   }
 
-  // Write the output
-  _output = std::make_shared<Table>();
+  return output;
+}
 
-  // add group by columns
+void Aggregate::_add_output_column_definitions(Table& output) const {
+  // Group-by columns are always nullable, as the group keys may contain NULL
   for (const auto column_id : _groupby_column_ids) {
-    const auto& column_type = input_table->column_type(column_id);
-    const auto& column_name = input_table->column_name(column_id);
-
-    _output->add_column_definition(column_name, column_type, true);
+    output.add_column_definition(_input_column_name(column_id), _input_column_type(column_id), true);
+  }
 
-    _groupby_columns.emplace_back(make_shared_by_data_type<BaseColumn, ValueColumn>(column_type, true));
-    _out_chunk.add_column(_groupby_columns.back());
+  for (const auto& aggregate : _aggregates) {
+    const auto nullable =
+        (aggregate.function != AggregateFunction::Count && aggregate.function != AggregateFunction::CountDistinct &&
+         aggregate.function != AggregateFunction::ApproxCountDistinct);
+    output.add_column_definition(_aggregate_column_name(aggregate),
+                                 _create_aggregate_states(aggregate)->output_data_type(), nullable);
   }
+}
 
-  /**
-   * Write group-by columns.
-   *
-   * 'results_per_column' always contains at least one element, since there are either GroupBy or Aggregate columns.
-   * However, we need to look only at the first element, because the keys for all columns are the same.
-   *
-   * The following loop is used for both, actual GroupBy columns and DISTINCT columns.
-   **/
-  if (_aggregates.empty()) {
-    auto context =
-        std::static_pointer_cast<AggregateContext<DistinctColumnType, DistinctAggregateType>>(_contexts_per_column[0]);
-    for (auto& map : *context->results) {
-      for (size_t group_column_index = 0; group_column_index < map.first.size(); ++group_column_index) {
-        _groupby_columns[group_column_index]->append(map.first[group_column_index]);
-      }
-    }
+std::vector<std::shared_ptr<BaseColumn>> Aggregate::_create_output_columns(const size_t group_count) const {
+  auto output_columns = std::vector<std::shared_ptr<BaseColumn>>{};
+
+  for (const auto column_id : _groupby_column_ids) {
+    resolve_data_type(_input_column_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+      output_columns.emplace_back(std::make_shared<ValueColumn<ColumnDataType>>(
+          pmr_concurrent_vector<ColumnDataType>(group_count), pmr_concurrent_vector<bool>(group_count)));
+    });
   }
 
-  /*
-  Write the aggregated columns to the output
-  */
-  ColumnID column_index{0};
   for (const auto& aggregate : _aggregates) {
-    auto column_id = aggregate.column_id;
-
-    // Output column for COUNT(*). int is chosen arbitrarily.
-    const auto data_type = (column_id == CountStarID) ? DataType::Int : input_table->column_type(column_id);
+    output_columns.emplace_back(_create_aggregate_states(aggregate)->create_output_column(group_count));
+  }
 
-    resolve_data_type(
-        data_type, [&, column_index](auto type) { _write_aggregate_output(type, column_index, aggregate.function); });
+  return output_columns;
+}
 
-    ++column_index;
-  }
+Aggregate::PartialAggregates Aggregate::_pre_aggregate_chunk(const ChunkID chunk_id) const {
+  const auto chunk_ptr = _input_chunk(chunk_id);
+  const auto& chunk = *chunk_ptr;
+  // One word for each group-by column plus one for their NULL flags
+  const auto key_width = _groupby_column_ids.size() + 1;
 
-  _output->emplace_chunk(std::move(_out_chunk));
+  auto chunk_aggregates = PartialAggregates{};
+  auto& groups = chunk_aggregates.groups.emplace(key_width);
 
-  return _output;
-}
+  if (_groupby_column_ids.empty()) {
+    // All rows belong to a single group, whose key only consists of the (unused) NULL flags
+    if (chunk.size() > 0) {
+      const auto key = uint64_t{0};
+      groups.find_or_insert(&key);
+    }
 
-/*
-The following template functions write the aggregated values for the different aggregate functions.
-They are separate and templated to avoid compiler errors for invalid type/function combinations.
-*/
-// MIN, MAX, SUM write the current aggregated value
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<
-    func == AggregateFunction::Min || func == AggregateFunction::Max || func == AggregateFunction::Sum, void>::type
-_write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
-                        std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>> results) {
-  DebugAssert(column->is_nullable(), "Aggregate: Output column needs to be nullable");
-
-  auto& values = column->values();
-  auto& null_values = column->null_values();
-
-  for (auto& kv : *results) {
-    null_values.push_back(!kv.second.current_aggregate);
-
-    if (!kv.second.current_aggregate) {
-      values.push_back(AggregateType());
-    } else {
-      values.push_back(*kv.second.current_aggregate);
+    for (const auto& aggregate : _aggregates) {
+      auto states = _create_aggregate_states(aggregate);
+      states->resize(groups.group_count());
+      if (chunk.size() > 0) states->aggregate_ungrouped(chunk);
+      chunk_aggregates.states.emplace_back(std::move(states));
     }
+
+    return chunk_aggregates;
   }
-}
 
-// COUNT writes the aggregate counter
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::Count, void>::type _write_aggregate_values(
-    std::shared_ptr<ValueColumn<AggregateType>> column,
-    std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>> results) {
-  DebugAssert(!column->is_nullable(), "Aggregate: Output column for COUNT shouldn't be nullable");
+  auto group_ids = std::vector<GroupID>{};
+  group_ids.reserve(chunk.size());
+
+  const auto is_single_column = (_groupby_column_ids.size() == 1);
+  const auto first_column_type = _input_column_type(_groupby_column_ids.front());
+  const auto is_single_integer_column =
+      is_single_column && (first_column_type == DataType::Int || first_column_type == DataType::Long);
+
+  auto chunk_keys = ChunkGroupKeys{};
 
-  auto& values = column->values();
+  if (is_single_column) {
+    const auto& base_column = *chunk.get_column(_groupby_column_ids.front());
+    resolve_data_and_column_type(first_column_type, base_column, [&](auto type, const auto& typed_column) {
+      using ColumnDataType = typename decltype(type)::type;
+      using ColumnType = std::decay_t<decltype(typed_column)>;
 
-  for (auto& kv : *results) {
-    values.push_back(kv.second.aggregate_count);
+      if constexpr (std::is_same<ColumnType, DictionaryColumn<ColumnDataType>>::value) {
+        write_dictionary_keys(typed_column, chunk_keys, _string_dictionaries.front().get());
+      }
+    });
   }
-}
 
-// COUNT(DISTINCT) writes the number of distinct values
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::CountDistinct, void>::type _write_aggregate_values(
-    std::shared_ptr<ValueColumn<AggregateType>> column,
-    std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>> results) {
-  DebugAssert(!column->is_nullable(), "Aggregate: Output column for COUNT shouldn't be nullable");
+  if (!chunk_keys.uses_dictionary) {
+    chunk_keys.row_keys.resize(chunk.size() * key_width);
+
+    for (auto groupby_column_idx = size_t{0}; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+      const auto column_id = _groupby_column_ids[groupby_column_idx];
+      resolve_data_type(_input_column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
 
-  auto& values = column->values();
+        write_key_words<ColumnDataType>(*chunk.get_column(column_id), groupby_column_idx, key_width,
+                                        chunk_keys.row_keys, _string_dictionaries[groupby_column_idx].get());
+      });
+    }
+
+    if (is_single_integer_column) {
+      for (auto key = chunk_keys.row_keys.cbegin(); key != chunk_keys.row_keys.cend(); key += key_width) {
+        if (key[1]) continue;
 
-  for (auto& kv : *results) {
-    values.push_back(kv.second.distinct_values.size());
+        const auto value = decode_key_word<int64_t>(key[0]);
+        chunk_keys.min_value = std::min(chunk_keys.min_value, value);
+        chunk_keys.max_value = std::max(chunk_keys.max_value, value);
+      }
+    }
   }
-}
 
-// AVG writes the calculated average from current aggregate and the aggregate counter
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::Avg && std::is_arithmetic<AggregateType>::value, void>::type
-_write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>> column,
-                        std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>> results) {
-  DebugAssert(column->is_nullable(), "Aggregate: Output column needs to be nullable");
+  /**
+   * For a single integer group-by column, the GroupIDs are cached in an array that is indexed by the value, as long
+   * as the range of the values is not larger than the chunk. This way, each distinct value is hashed only once.
+   */
+  auto dense_group_ids = std::vector<GroupID>{};
+  auto null_group_id = INVALID_GROUP_ID;
+
+  const auto value_range = static_cast<uint64_t>(chunk_keys.max_value) - static_cast<uint64_t>(chunk_keys.min_value);
+  if (is_single_integer_column && chunk_keys.min_value <= chunk_keys.max_value && value_range < chunk.size()) {
+    dense_group_ids.resize(value_range + 1, INVALID_GROUP_ID);
+  }
 
-  auto& values = column->values();
-  auto& null_values = column->null_values();
+  const auto find_or_insert_group = [&](const uint64_t* key) {
+    if (dense_group_ids.empty()) return groups.find_or_insert(key);
 
-  for (auto& kv : *results) {
-    null_values.push_back(!kv.second.current_aggregate);
+    const auto value_idx = static_cast<size_t>(decode_key_word<int64_t>(key[0]) - chunk_keys.min_value);
+    auto& group_id = key[1] ? null_group_id : dense_group_ids[value_idx];
+    if (group_id == INVALID_GROUP_ID) group_id = groups.find_or_insert(key);
+    return group_id;
+  };
 
-    if (!kv.second.current_aggregate) {
-      values.push_back(AggregateType());
-    } else {
-      values.push_back(*kv.second.current_aggregate / static_cast<AggregateType>(kv.second.aggregate_count));
+  if (chunk_keys.uses_dictionary) {
+    auto dictionary_group_ids = std::vector<GroupID>(chunk_keys.dictionary_keys.size() / key_width, INVALID_GROUP_ID);
+
+    for (const auto key_idx : chunk_keys.key_indices) {
+      auto& group_id = dictionary_group_ids[key_idx];
+      if (group_id == INVALID_GROUP_ID) {
+        group_id = find_or_insert_group(&chunk_keys.dictionary_keys[key_idx * key_width]);
+      }
+      group_ids.emplace_back(group_id);
+    }
+  } else {
+    const auto& row_keys = chunk_keys.row_keys;
+    for (auto key = row_keys.data(); key != row_keys.data() + row_keys.size(); key += key_width) {
+      group_ids.emplace_back(find_or_insert_group(key));
     }
   }
-}
 
-// AVG is not defined for non-arithmetic types. Avoiding compiler errors.
-template <typename ColumnType, typename AggregateType, AggregateFunction func>
-typename std::enable_if<func == AggregateFunction::Avg && !std::is_arithmetic<AggregateType>::value, void>::type
-    _write_aggregate_values(std::shared_ptr<ValueColumn<AggregateType>>,
-                            std::shared_ptr<std::map<AggregateKey, AggregateResult<AggregateType, ColumnType>>>) {
-  Fail("Invalid aggregate");
+  for (const auto& aggregate : _aggregates) {
+    auto states = _create_aggregate_states(aggregate);
+    states->resize(groups.group_count());
+    states->aggregate(chunk, group_ids);
+    chunk_aggregates.states.emplace_back(std::move(states));
+  }
+
+  return chunk_aggregates;
 }
 
-template <typename ColumnType>
-void Aggregate::_write_aggregate_output(boost::hana::basic_type<ColumnType> type, ColumnID column_index,
-                                        AggregateFunction function) {
-  switch (function) {
-    case AggregateFunction::Min:
-      write_aggregate_output<ColumnType, AggregateFunction::Min>(column_index);
-      break;
-    case AggregateFunction::Max:
-      write_aggregate_output<ColumnType, AggregateFunction::Max>(column_index);
-      break;
-    case AggregateFunction::Sum:
-      write_aggregate_output<ColumnType, AggregateFunction::Sum>(column_index);
-      break;
-    case AggregateFunction::Avg:
-      write_aggregate_output<ColumnType, AggregateFunction::Avg>(column_index);
-      break;
-    case AggregateFunction::Count:
-      write_aggregate_output<ColumnType, AggregateFunction::Count>(column_index);
-      break;
-    case AggregateFunction::CountDistinct:
-      write_aggregate_output<ColumnType, AggregateFunction::CountDistinct>(column_index);
-      break;
+Aggregate::PartialAggregates Aggregate::_merge_partition(
+    std::vector<PartialAggregates>& chunk_aggregates,
+    const std::vector<std::vector<std::vector<GroupID>>>& groups_per_partition, const size_t partition_idx) const {
+  auto partition = PartialAggregates{};
+  auto& groups = partition.groups.emplace(_groupby_column_ids.size() + 1);
+
+  for (const auto& aggregate : _aggregates) {
+    partition.states.emplace_back(_create_aggregate_states(aggregate));
   }
-}
 
-template <typename ColumnType, AggregateFunction function>
-void Aggregate::write_aggregate_output(ColumnID column_index) {
-  // retrieve type information from the aggregation traits
-  typename AggregateTraits<ColumnType, function>::aggregate_type aggregate_type;
-  auto aggregate_data_type = AggregateTraits<ColumnType, function>::aggregate_data_type;
+  auto target_group_ids = std::vector<GroupID>{};
+
+  for (auto chunk_id = size_t{0}; chunk_id < chunk_aggregates.size(); ++chunk_id) {
+    auto& chunk_partial_aggregates = chunk_aggregates[chunk_id];
+    const auto& source_group_ids = groups_per_partition[chunk_id][partition_idx];
 
-  const auto& aggregate = _aggregates[column_index];
+    target_group_ids.clear();
+    for (const auto source_group_id : source_group_ids) {
+      target_group_ids.emplace_back(groups.find_or_insert(chunk_partial_aggregates.groups->group_key(source_group_id)));
+    }
 
-  if (aggregate_data_type == DataType::Null) {
-    // if not specified, it’s the input column’s type
-    aggregate_data_type = _input_table_left()->column_type(aggregate.column_id);
+    for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+      auto& states = *partition.states[aggregate_idx];
+      states.resize(groups.group_count());
+      states.merge(*chunk_partial_aggregates.states[aggregate_idx], source_group_ids, target_group_ids);
+    }
   }
 
-  // use the alias or generate the name, e.g. MAX(column_a)
-  std::string output_column_name;
-  if (aggregate.alias) {
-    output_column_name = *aggregate.alias;
-  } else if (aggregate.column_id == CountStarID) {
-    output_column_name = "COUNT(*)";
-  } else {
-    const auto& column_name = _input_table_left()->column_name(aggregate.column_id);
+  return partition;
+}
 
-    if (aggregate.function == AggregateFunction::CountDistinct) {
-      output_column_name = std::string("COUNT(DISTINCT ") + column_name + ")";
-    } else {
-      output_column_name = aggregate_function_to_string.left.at(function) + "(" + column_name + ")";
+std::unique_ptr<BaseAggregateStates> Aggregate::_create_aggregate_states(const AggregateDefinition& aggregate) const {
+  if (aggregate.column_id == CountStarID) return std::make_unique<CountStarStates>();
+
+  std::unique_ptr<BaseAggregateStates> states;
+
+  resolve_data_type(_input_column_type(aggregate.column_id), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    switch (aggregate.function) {
+      case AggregateFunction::Min:
+        states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::Min>>(aggregate.column_id);
+        break;
+      case AggregateFunction::Max:
+        states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::Max>>(aggregate.column_id);
+        break;
+      case AggregateFunction::Sum:
+        if constexpr (std::is_arithmetic<ColumnDataType>::value) {
+          states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::Sum>>(aggregate.column_id);
+        } else {
+          Fail("Aggregate: Cannot calculate SUM or AVG on string column");
+        }
+        break;
+      case AggregateFunction::Avg:
+        if constexpr (std::is_arithmetic<ColumnDataType>::value) {
+          states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::Avg>>(aggregate.column_id);
+        } else {
+          Fail("Aggregate: Cannot calculate SUM or AVG on string column");
+        }
+        break;
+      case AggregateFunction::Count:
+        states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::Count>>(aggregate.column_id);
+        break;
+      case AggregateFunction::CountDistinct:
+        states =
+            std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::CountDistinct>>(aggregate.column_id);
+        break;
+      case AggregateFunction::ApproxCountDistinct:
+        states = std::make_unique<AggregateStates<ColumnDataType, AggregateFunction::ApproxCountDistinct>>(
+            aggregate.column_id);
+        break;
     }
-  }
+  });
+
+  return states;
+}
 
-  constexpr bool needs_null = (function != AggregateFunction::Count && function != AggregateFunction::CountDistinct);
-  _output->add_column_definition(output_column_name, aggregate_data_type, needs_null);
+void Aggregate::_write_output(const PartialAggregates& partition, const size_t offset,
+                              const std::vector<std::shared_ptr<BaseColumn>>& output_columns) const {
+  const auto& groups = *partition.groups;
+  const auto null_word_idx = groups.key_width() - 1;
 
-  auto col = std::make_shared<ValueColumn<decltype(aggregate_type)>>(needs_null);
+  for (auto groupby_column_idx = size_t{0}; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+    const auto column_type = _input_column_type(_groupby_column_ids[groupby_column_idx]);
+    const auto null_bit = uint64_t{1} << groupby_column_idx;
 
-  auto context = std::static_pointer_cast<AggregateContext<ColumnType, decltype(aggregate_type)>>(
-      _contexts_per_column[column_index]);
+    resolve_data_type(column_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
 
-  // write all group keys into the respective columns
-  if (column_index == 0) {
-    for (auto& map : *context->results) {
-      for (size_t group_column_index = 0; group_column_index < map.first.size(); ++group_column_index) {
-        _groupby_columns[group_column_index]->append(map.first[group_column_index]);
+      auto& output_column = static_cast<ValueColumn<ColumnDataType>&>(*output_columns[groupby_column_idx]);
+      auto& values = output_column.values();
+      auto& null_values = output_column.null_values();
+
+      for (auto group_id = GroupID{0}; group_id < groups.group_count(); ++group_id) {
+        const auto key = groups.group_key(group_id);
+
+        if (key[null_word_idx] & null_bit) {
+          null_values[offset + group_id] = true;
+        } else if constexpr (std::is_same<ColumnDataType, std::string>::value) {
+          values[offset + group_id] = _string_dictionaries[groupby_column_idx]->string(key[groupby_column_idx]);
+        } else {
+          values[offset + group_id] = decode_key_word<ColumnDataType>(key[groupby_column_idx]);
+        }
       }
-    }
+    });
+  }
+
+  for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+    partition.states[aggregate_idx]->write_output(*output_columns[_groupby_column_ids.size() + aggregate_idx], offset);
   }
+}
 
-  // write aggregated values into the column
-  _write_aggregate_values<ColumnType, decltype(aggregate_type), function>(col, context->results);
-  _out_chunk.add_column(col);
+const std::string Aggregate::_aggregate_column_name(const AggregateDefinition& aggregate) const {
+  // use the alias or generate the name, e.g. MAX(column_a)
+  if (aggregate.alias) return *aggregate.alias;
+  if (aggregate.column_id == CountStarID) return "COUNT(*)";
+
+  const auto column_name = _input_column_name(aggregate.column_id);
+
+  if (aggregate.function == AggregateFunction::CountDistinct) {
+    return std::string("COUNT(DISTINCT ") + column_name + ")";
+  }
+  return aggregate_function_to_string.left.at(aggregate.function) + "(" + column_name + ")";
 }
 
 }  // namespace opossum
@@ -1,52 +1,46 @@
 #pragma once
 
-#include <functional>
 #include <limits>
-#include <map>
 #include <memory>
 #include <optional>
-#include <set>
 #include <string>
-#include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
-#include "resolve_type.hpp"
-#include "storage/base_attribute_vector.hpp"
-#include "storage/column_visitable.hpp"
-#include "storage/dictionary_column.hpp"
-#include "storage/reference_column.hpp"
-#include "storage/value_column.hpp"
+#include "aggregate/aggregate_states.hpp"
+#include "aggregate/group_key_encoding.hpp"
+#include "aggregate/group_key_hash_table.hpp"
+#include "projection.hpp"
+#include "storage/base_column.hpp"
 #include "types.hpp"
-#include "utils/assert.hpp"
 
 namespace opossum {
 
-struct GroupByContext;
-
 /*
 Operator to aggregate columns by certain functions, such as min, max, sum, average, and count. The output is a table
- with reference columns. As with most operators we do not guarantee a stable operation with regards to positions -
+ with value columns. As with most operators we do not guarantee a stable operation with regards to positions -
  i.e. your sorting order.
 
-For implementation details, please check the wiki: https://github.com/hyrise/hyrise/wiki/Aggregate-Operator
-*/
+The aggregation is hash-based and runs in two phases: First, each chunk is pre-aggregated by a separate job. The
+ group-by values of each row are normalized into a fixed-width binary key, which is looked up in a GroupKeyHashTable
+ local to the chunk to assign a dense GroupID to the row. Partial aggregates are computed in typed arrays indexed by
+ these GroupIDs. Second, the groups of all chunks are radix-partitioned by the hash of their keys, and each partition
+ is merged by a separate job. As the partitions are disjoint, no synchronization is needed.
 
-/*
-Current aggregated value and the number of rows that were used.
-The latter is used for AVG and COUNT.
-*/
-template <typename AggregateType, typename ColumnDataType>
-struct AggregateResult {
-  std::optional<AggregateType> current_aggregate;
-  size_t aggregate_count = 0;
-  std::set<ColumnDataType> distinct_values;
-};
+If the only group-by column is dictionary-encoded in all chunks, the ValueIDs are used as GroupIDs instead and no
+ hashing takes place, see _aggregate_by_value_ids().
 
-/*
-The key type that is used for the aggregation map.
+If `column_expressions` are passed, the Aggregate works on the columns they compute instead of on the input columns,
+ i.e., the ColumnIDs of the group-by columns and aggregates refer to the expressions. The expressions are evaluated
+ chunk by chunk right before the chunk is aggregated, so that group keys such as `a * 100 + b` or aggregates such as
+ SUM(a * b) do not need a Projection that materializes them for the whole input first.
+
+If the groups are estimated to exceed the `memory_budget` (in bytes, by default a fraction of the main memory), the
+ input rows are partitioned by their group-by values into temporary files, which are then aggregated one at a time, see
+ _aggregate_spilled().
+
+For implementation details, please check the wiki: https://github.com/hyrise/hyrise/wiki/Aggregate-Operator
 */
-using AggregateKey = std::vector<AllTypeVariant>;
 
 // ColumnID representing the '*' when using COUNT(*)
 constexpr ColumnID CountStarID{std::numeric_limits<ColumnID::base_type>::max()};
@@ -65,61 +59,97 @@ struct AggregateDefinition {
   std::optional<std::string> alias;
 };
 
-/**
- * Types that are used for the special COUNT(*) and DISTINCT implementations
- */
-using CountColumnType = int32_t;
-using CountAggregateType = int64_t;
-using DistinctColumnType = int8_t;
-using DistinctAggregateType = int8_t;
-
-/**
- * Note: Aggregate does not support null values at the moment
- */
 class Aggregate : public AbstractReadOnlyOperator {
  public:
   Aggregate(const std::shared_ptr<AbstractOperator> in, const std::vector<AggregateDefinition> aggregates,
-            const std::vector<ColumnID> groupby_column_ids);
+            const std::vector<ColumnID> groupby_column_ids,
+            const Projection::ColumnExpressions& column_expressions = {},
+            const std::optional<size_t>& memory_budget = std::nullopt);
 
   const std::vector<AggregateDefinition>& aggregates() const;
   const std::vector<ColumnID>& groupby_column_ids() const;
+  const Projection::ColumnExpressions& column_expressions() const;
 
   const std::string name() const override;
   std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args) const override;
 
-  // write the aggregated output for a given aggregate column
-  template <typename ColumnType, AggregateFunction function>
-  void write_aggregate_output(ColumnID column_index);
+  // Fraction of the main memory that a single Aggregate may use for its groups if no budget is passed
+  static constexpr double DEFAULT_MEMORY_BUDGET_FRACTION = 0.25;
+
+  static size_t default_memory_budget();
 
  protected:
+  // The groups of a chunk or of a partition of all groups, together with the states of the aggregates for them
+  struct PartialAggregates {
+    std::optional<GroupKeyHashTable> groups;
+    std::vector<std::unique_ptr<BaseAggregateStates>> states;
+  };
+
   std::shared_ptr<const Table> _on_execute() override;
 
-  template <typename ColumnType>
-  static void _create_aggregate_context(boost::hana::basic_type<ColumnType> type,
-                                        std::shared_ptr<ColumnVisitableContext>& aggregate_context,
-                                        AggregateFunction function);
+  // The type and name of a column of the aggregated input, i.e., of the input table or of a column expression
+  DataType _input_column_type(const ColumnID column_id) const;
+  const std::string _input_column_name(const ColumnID column_id) const;
+
+  // A column or a chunk of the aggregated input. Column expressions are evaluated on the input chunk on every call.
+  std::shared_ptr<const BaseColumn> _input_column(const ChunkID chunk_id, const ColumnID column_id) const;
+  std::shared_ptr<const Chunk> _input_chunk(const ChunkID chunk_id) const;
+
+  // Fails for aggregates that are not defined on their input column
+  void _validate_aggregates() const;
+
+  /**
+   * Used if the only group-by column is dictionary-encoded in all chunks. The ValueIDs of each chunk are used as its
+   * GroupIDs, so that neither group keys nor hashing are needed. The chunks are merged by translating their ValueIDs
+   * into positions in the sorted union of all dictionaries.
+   */
+  template <typename ColumnDataType>
+  std::shared_ptr<const Table> _aggregate_by_value_ids() const;
+
+  /**
+   * Normalizes the group-by values of a chunk's rows into group keys, assigns the rows to groups that are local to the
+   * chunk, and computes partial aggregates for these groups.
+   */
+  PartialAggregates _pre_aggregate_chunk(const ChunkID chunk_id) const;
+
+  /**
+   * Merges the local groups of all chunks that belong to a partition. groups_per_partition[chunk_id][partition_idx]
+   * holds the GroupIDs of the chunk's local groups in the partition.
+   */
+  PartialAggregates _merge_partition(std::vector<PartialAggregates>& chunk_aggregates,
+                                     const std::vector<std::vector<std::vector<GroupID>>>& groups_per_partition,
+                                     const size_t partition_idx) const;
+
+  // Rough estimate of the memory (in bytes) that a local group of a chunk occupies until the groups are merged
+  size_t _estimated_group_size() const;
+
+  /**
+   * Used if the groups do not fit into the memory budget. The rows are written to partition_count spill files by the
+   * hash of their group-by values, so that all rows of a group end up in the same file. The files are then read back
+   * and aggregated one at a time by an in-memory Aggregate.
+   */
+  std::shared_ptr<const Table> _aggregate_spilled(const size_t partition_count) const;
+
+  std::unique_ptr<BaseAggregateStates> _create_aggregate_states(const AggregateDefinition& aggregate) const;
+
+  void _add_output_column_definitions(Table& output) const;
 
-  template <typename ColumnType>
-  static void _create_aggregate_visitor(boost::hana::basic_type<ColumnType> type,
-                                        std::shared_ptr<ColumnVisitable>& builder,
-                                        std::shared_ptr<ColumnVisitableContext> context,
-                                        std::shared_ptr<GroupByContext> groupby_context, AggregateFunction function);
+  // Creates the output columns for group_count groups, which are then written by _write_output()
+  std::vector<std::shared_ptr<BaseColumn>> _create_output_columns(const size_t group_count) const;
 
-  template <typename ColumnType>
-  void _write_aggregate_output(boost::hana::basic_type<ColumnType> type, ColumnID column_index,
-                               AggregateFunction function);
+  // Writes the group-by values and the aggregates of a partition's groups to the output columns, starting at offset
+  void _write_output(const PartialAggregates& partition, const size_t offset,
+                     const std::vector<std::shared_ptr<BaseColumn>>& output_columns) const;
 
-  template <typename ColumnDataType, AggregateFunction function>
-  void _aggregate_column(ChunkID chunk_id, ColumnID column_index, const BaseColumn& base_column);
+  const std::string _aggregate_column_name(const AggregateDefinition& aggregate) const;
 
   const std::vector<AggregateDefinition> _aggregates;
   const std::vector<ColumnID> _groupby_column_ids;
+  const Projection::ColumnExpressions _column_expressions;
+  const std::optional<size_t> _memory_budget;
 
-  std::shared_ptr<Table> _output;
-  Chunk _out_chunk;
-  std::vector<std::shared_ptr<BaseColumn>> _groupby_columns;
-  std::vector<std::shared_ptr<ColumnVisitableContext>> _contexts_per_column;
-  std::vector<std::shared_ptr<std::vector<AggregateKey>>> _keys_per_chunk;
+  // For string group-by columns, the dictionary of the ids that represent the strings in the group keys
+  std::vector<std::unique_ptr<StringKeyDictionary>> _string_dictionaries;
 };
 
 }  // namespace opossum
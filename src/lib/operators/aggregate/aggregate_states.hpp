@@ -0,0 +1,504 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#include "group_key_hash_table.hpp"
+#include "hyper_log_log.hpp"
+#include "resolve_type.hpp"
+#include "storage/chunk.hpp"
+#include "storage/dictionary_column.hpp"
+#include "storage/fitted_attribute_vector.hpp"
+#include "storage/iterables/attribute_vector_iterable.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "storage/value_column.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/*
+The following structs describe the different aggregate traits.
+Given a ColumnType and AggregateFunction, certain traits like the aggregate type
+can be deduced.
+*/
+template <typename ColumnType, AggregateFunction function, class Enable = void>
+struct AggregateTraits {};
+
+// COUNT on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::Count> {
+  typedef ColumnType column_type;
+  typedef int64_t aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Long;
+};
+
+// COUNT(DISTINCT) on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::CountDistinct> {
+  typedef ColumnType column_type;
+  typedef int64_t aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Long;
+};
+
+// APPROX_COUNT_DISTINCT on all types
+template <typename ColumnType>
+struct AggregateTraits<ColumnType, AggregateFunction::ApproxCountDistinct> {
+  typedef ColumnType column_type;
+  typedef int64_t aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Long;
+};
+
+// MIN/MAX on all types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Min || function == AggregateFunction::Max, void>> {
+  typedef ColumnType column_type;
+  typedef ColumnType aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Null;
+};
+
+// AVG on arithmetic types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Avg && std::is_arithmetic<ColumnType>::value, void>> {
+  typedef ColumnType column_type;
+  typedef double aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Double;
+};
+
+// SUM on integers
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_integral<ColumnType>::value, void>> {
+  typedef ColumnType column_type;
+  typedef int64_t aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Long;
+};
+
+// SUM on floating point numbers
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<
+    ColumnType, function,
+    typename std::enable_if_t<function == AggregateFunction::Sum && std::is_floating_point<ColumnType>::value, void>> {
+  typedef ColumnType column_type;
+  typedef double aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Double;
+};
+
+// invalid: AVG on non-arithmetic types
+template <typename ColumnType, AggregateFunction function>
+struct AggregateTraits<ColumnType, function, typename std::enable_if_t<!std::is_arithmetic<ColumnType>::value &&
+                                                                           (function == AggregateFunction::Avg ||
+                                                                            function == AggregateFunction::Sum),
+                                                                       void>> {
+  typedef ColumnType column_type;
+  typedef ColumnType aggregate_type;
+  static constexpr DataType aggregate_data_type = DataType::Null;
+};
+
+/**
+ * The states of one aggregate for a number of groups, kept in arrays that are indexed by the GroupID. The Aggregate
+ * operator computes partial states for the groups of each chunk, which are merged afterwards.
+ */
+class BaseAggregateStates {
+ public:
+  virtual ~BaseAggregateStates() = default;
+
+  virtual void resize(const size_t group_count) = 0;
+
+  // Aggregates the rows of a chunk, where row i belongs to the group group_ids[i]
+  virtual void aggregate(const Chunk& chunk, const std::vector<GroupID>& group_ids) = 0;
+
+  // Aggregates all rows of a chunk into the first group, used if there are no group-by columns
+  virtual void aggregate_ungrouped(const Chunk& chunk) = 0;
+
+  // Merges the group source_group_ids[i] of other into the group target_group_ids[i]. Merged states of other are lost.
+  virtual void merge(BaseAggregateStates& other, const std::vector<GroupID>& source_group_ids,
+                     const std::vector<GroupID>& target_group_ids) = 0;
+
+  virtual DataType output_data_type() const = 0;
+
+  // Creates a column for the aggregates of row_count groups, which are written by one or more calls to write_output()
+  virtual std::shared_ptr<BaseColumn> create_output_column(const size_t row_count) const = 0;
+
+  // Writes the aggregates of all groups to the output column, starting at offset
+  virtual void write_output(BaseColumn& output_column, const size_t offset) const = 0;
+};
+
+template <typename ColumnDataType, AggregateFunction function>
+class AggregateStates : public BaseAggregateStates {
+ public:
+  using AggregateType = typename AggregateTraits<ColumnDataType, function>::aggregate_type;
+
+  static_assert(std::is_arithmetic<ColumnDataType>::value ||
+                    (function != AggregateFunction::Sum && function != AggregateFunction::Avg),
+                "SUM and AVG are only defined on arithmetic types");
+
+  explicit AggregateStates(const ColumnID column_id) : _column_id(column_id) {}
+
+  void resize(const size_t group_count) override {
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      _distinct_values.resize(group_count);
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      _sketches.resize(group_count);
+    } else {
+      _value_counts.resize(group_count);
+    }
+
+    if constexpr (!IS_COUNT) _current_aggregates.resize(group_count);
+  }
+
+  void aggregate(const Chunk& chunk, const std::vector<GroupID>& group_ids) override {
+    resolve_column_type<ColumnDataType>(*chunk.get_column(_column_id), [&](const auto& typed_column) {
+      using ColumnType = std::decay_t<decltype(typed_column)>;
+
+      if constexpr (function == AggregateFunction::ApproxCountDistinct &&
+                    std::is_same<ColumnType, DictionaryColumn<ColumnDataType>>::value) {
+        // Each distinct value is hashed only once
+        const auto value_hashes = _hash_dictionary(*typed_column.dictionary());
+
+        auto iterable = AttributeVectorIterable{*typed_column.attribute_vector()};
+        iterable.for_each([&](const auto& value_id) {
+          if (!value_id.is_null()) _sketches[group_ids[value_id.chunk_offset()]].add(value_hashes[value_id.value()]);
+        });
+        return;
+      }
+
+      auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+
+      ChunkOffset chunk_offset{0};
+      iterable.for_each([&](const auto& value) {
+        const auto group_id = group_ids[chunk_offset++];
+        if (value.is_null()) return;
+
+        if constexpr (function == AggregateFunction::CountDistinct) {
+          _distinct_values[group_id].insert(value.value());
+        } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+          _sketches[group_id].add(hyper_log_log_hash(value.value()));
+        } else {
+          if constexpr (function == AggregateFunction::Min) {
+            if (_value_counts[group_id] == 0 || value.value() < _current_aggregates[group_id]) {
+              _current_aggregates[group_id] = value.value();
+            }
+          } else if constexpr (function == AggregateFunction::Max) {
+            if (_value_counts[group_id] == 0 || value.value() > _current_aggregates[group_id]) {
+              _current_aggregates[group_id] = value.value();
+            }
+          } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+            _current_aggregates[group_id] += value.value();
+          }
+
+          ++_value_counts[group_id];
+        }
+      });
+    });
+  }
+
+  void merge(BaseAggregateStates& base_other, const std::vector<GroupID>& source_group_ids,
+             const std::vector<GroupID>& target_group_ids) override {
+    auto& other = static_cast<AggregateStates&>(base_other);
+
+    for (auto idx = size_t{0}; idx < source_group_ids.size(); ++idx) {
+      const auto source = source_group_ids[idx];
+      const auto target = target_group_ids[idx];
+
+      if constexpr (function == AggregateFunction::CountDistinct) {
+        _distinct_values[target].merge(other._distinct_values[source]);
+      } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+        _sketches[target].merge(other._sketches[source]);
+      } else {
+        _merge_aggregate(target, other._current_aggregates[source], other._value_counts[source]);
+      }
+    }
+  }
+
+  void aggregate_ungrouped(const Chunk& chunk) override {
+    DebugAssert(chunk.size() > 0 && _group_count() == 1, "Expected a single group for a non-empty chunk");
+
+    resolve_column_type<ColumnDataType>(*chunk.get_column(_column_id), [&](const auto& typed_column) {
+      using ColumnType = std::decay_t<decltype(typed_column)>;
+
+      if constexpr (std::is_same<ColumnType, ValueColumn<ColumnDataType>>::value) {
+        _aggregate_ungrouped_values(typed_column);
+      } else if constexpr (std::is_same<ColumnType, DictionaryColumn<ColumnDataType>>::value) {
+        _aggregate_ungrouped_dictionary(typed_column);
+      } else {
+        auto accumulator = Accumulator{};
+        auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+        iterable.for_each([&](const auto& value) {
+          if (!value.is_null()) _accumulate(accumulator, value.value());
+        });
+        _merge_accumulator(accumulator);
+      }
+    });
+  }
+
+  DataType output_data_type() const override {
+    // if not specified, it’s the input column’s type
+    const auto data_type = AggregateTraits<ColumnDataType, function>::aggregate_data_type;
+    return data_type == DataType::Null ? data_type_from_type<ColumnDataType>() : data_type;
+  }
+
+  std::shared_ptr<BaseColumn> create_output_column(const size_t row_count) const override {
+    // COUNT never returns NULL
+    if constexpr (IS_COUNT) {
+      return std::make_shared<ValueColumn<AggregateType>>(pmr_concurrent_vector<AggregateType>(row_count));
+    } else {
+      return std::make_shared<ValueColumn<AggregateType>>(pmr_concurrent_vector<AggregateType>(row_count),
+                                                          pmr_concurrent_vector<bool>(row_count));
+    }
+  }
+
+  void write_output(BaseColumn& output_column, const size_t offset) const override {
+    auto& typed_output_column = static_cast<ValueColumn<AggregateType>&>(output_column);
+    auto& values = typed_output_column.values();
+
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      for (auto group_id = size_t{0}; group_id < _distinct_values.size(); ++group_id) {
+        values[offset + group_id] = _distinct_values[group_id].size();
+      }
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      for (auto group_id = size_t{0}; group_id < _sketches.size(); ++group_id) {
+        values[offset + group_id] = _sketches[group_id].estimate();
+      }
+    } else if constexpr (function == AggregateFunction::Count) {
+      for (auto group_id = size_t{0}; group_id < _value_counts.size(); ++group_id) {
+        values[offset + group_id] = _value_counts[group_id];
+      }
+    } else {
+      auto& null_values = typed_output_column.null_values();
+
+      for (auto group_id = size_t{0}; group_id < _value_counts.size(); ++group_id) {
+        if (_value_counts[group_id] == 0) {
+          // Only NULL values were aggregated
+          null_values[offset + group_id] = true;
+        } else if constexpr (function == AggregateFunction::Avg) {
+          values[offset + group_id] =
+              _current_aggregates[group_id] / static_cast<AggregateType>(_value_counts[group_id]);
+        } else {
+          values[offset + group_id] = _current_aggregates[group_id];
+        }
+      }
+    }
+  }
+
+ protected:
+  static constexpr bool IS_COUNT =
+      (function == AggregateFunction::Count || function == AggregateFunction::CountDistinct ||
+       function == AggregateFunction::ApproxCountDistinct);
+
+  // COUNT(DISTINCT) and APPROX_COUNT_DISTINCT neither keep a current aggregate nor a value count
+  static constexpr bool IS_DISTINCT =
+      (function == AggregateFunction::CountDistinct || function == AggregateFunction::ApproxCountDistinct);
+
+  // The state of the single group of aggregate_ungrouped(), kept in local variables while a chunk is scanned
+  struct Accumulator {
+    AggregateType aggregate{};
+    uint64_t value_count{0};
+  };
+
+  size_t _group_count() const {
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      return _distinct_values.size();
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      return _sketches.size();
+    } else {
+      return _value_counts.size();
+    }
+  }
+
+  void _accumulate(Accumulator& accumulator, const ColumnDataType& value) {
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      _distinct_values.front().insert(value);
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      _sketches.front().add(hyper_log_log_hash(value));
+    } else {
+      if constexpr (function == AggregateFunction::Min) {
+        if (accumulator.value_count == 0 || value < accumulator.aggregate) accumulator.aggregate = value;
+      } else if constexpr (function == AggregateFunction::Max) {
+        if (accumulator.value_count == 0 || value > accumulator.aggregate) accumulator.aggregate = value;
+      } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+        accumulator.aggregate += value;
+      }
+      ++accumulator.value_count;
+    }
+  }
+
+  void _merge_accumulator(Accumulator& accumulator) {
+    if constexpr (!IS_DISTINCT) {
+      _merge_aggregate(GroupID{0}, accumulator.aggregate, accumulator.value_count);
+    }
+  }
+
+  // Merges an aggregate over value_count non-NULL values into the group target
+  void _merge_aggregate(const GroupID target, AggregateType& aggregate, const uint64_t value_count) {
+    if (value_count == 0) return;
+
+    auto& target_aggregate = _current_aggregates[target];
+
+    if constexpr (function == AggregateFunction::Min) {
+      if (_value_counts[target] == 0 || aggregate < target_aggregate) target_aggregate = std::move(aggregate);
+    } else if constexpr (function == AggregateFunction::Max) {
+      if (_value_counts[target] == 0 || aggregate > target_aggregate) target_aggregate = std::move(aggregate);
+    } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+      target_aggregate += aggregate;
+    }
+
+    _value_counts[target] += value_count;
+  }
+
+  // The values are scanned without GroupIDs and, for non-nullable columns, without checking for NULL
+  void _aggregate_ungrouped_values(const ValueColumn<ColumnDataType>& column) {
+    const auto& values = column.values();
+    auto accumulator = Accumulator{};
+
+    if constexpr (function == AggregateFunction::Count) {
+      // COUNT does not look at the values at all
+      if (column.is_nullable()) {
+        const auto& null_values = column.null_values();
+        accumulator.value_count = std::count(null_values.cbegin(), null_values.cend(), false);
+      } else {
+        accumulator.value_count = values.size();
+      }
+    } else if (column.is_nullable()) {
+      const auto& null_values = column.null_values();
+      for (auto chunk_offset = size_t{0}; chunk_offset < values.size(); ++chunk_offset) {
+        if (!null_values[chunk_offset]) _accumulate(accumulator, values[chunk_offset]);
+      }
+    } else {
+      for (const auto& value : values) {
+        _accumulate(accumulator, value);
+      }
+    }
+
+    _merge_accumulator(accumulator);
+  }
+
+  /**
+   * The dictionary of a column contains exactly its distinct non-NULL values in sorted order. Thus, MIN, MAX,
+   * COUNT(DISTINCT), and APPROX_COUNT_DISTINCT are answered from the dictionary alone. COUNT, SUM, and AVG count the
+   * occurrences of each ValueID in the attribute vector, which is scanned as a plain array of its actual width.
+   */
+  void _aggregate_ungrouped_dictionary(const DictionaryColumn<ColumnDataType>& column) {
+    const auto& dictionary = *column.dictionary();
+    if (dictionary.empty()) return;
+
+    if constexpr (function == AggregateFunction::CountDistinct) {
+      _distinct_values.front().insert(dictionary.cbegin(), dictionary.cend());
+    } else if constexpr (function == AggregateFunction::ApproxCountDistinct) {
+      for (const auto hash : _hash_dictionary(dictionary)) {
+        _sketches.front().add(hash);
+      }
+    } else if constexpr (function == AggregateFunction::Min || function == AggregateFunction::Max) {
+      // For MIN and MAX, the value count only tells whether there are non-NULL values
+      auto aggregate = (function == AggregateFunction::Min) ? dictionary.front() : dictionary.back();
+      _merge_aggregate(GroupID{0}, aggregate, 1);
+    } else {
+      const auto& attribute_vector = *column.attribute_vector();
+      switch (attribute_vector.width()) {
+        case 1:
+          _aggregate_attributes(dictionary,
+                                static_cast<const FittedAttributeVector<uint8_t>&>(attribute_vector).attributes());
+          break;
+        case 2:
+          _aggregate_attributes(dictionary,
+                                static_cast<const FittedAttributeVector<uint16_t>&>(attribute_vector).attributes());
+          break;
+        case 4:
+        default:
+          _aggregate_attributes(dictionary,
+                                static_cast<const FittedAttributeVector<uint32_t>&>(attribute_vector).attributes());
+          break;
+      }
+    }
+  }
+
+  template <typename uintX_t>
+  void _aggregate_attributes(const pmr_vector<ColumnDataType>& dictionary, const pmr_vector<uintX_t>& attributes) {
+    constexpr auto null_value_id = FittedAttributeVector<uintX_t>::CLAMPED_NULL_VALUE_ID;
+    auto accumulator = Accumulator{};
+
+    if constexpr (function == AggregateFunction::Count) {
+      accumulator.value_count = attributes.size() - std::count(attributes.cbegin(), attributes.cend(), null_value_id);
+    } else if constexpr (function == AggregateFunction::Sum || function == AggregateFunction::Avg) {
+      auto value_id_counts = std::vector<uint64_t>(dictionary.size());
+      for (const auto value_id : attributes) {
+        if (value_id != null_value_id) ++value_id_counts[value_id];
+      }
+
+      for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+        accumulator.aggregate += dictionary[value_id] * static_cast<AggregateType>(value_id_counts[value_id]);
+        accumulator.value_count += value_id_counts[value_id];
+      }
+    }
+
+    _merge_accumulator(accumulator);
+  }
+
+  std::vector<uint64_t> _hash_dictionary(const pmr_vector<ColumnDataType>& dictionary) const {
+    auto hashes = std::vector<uint64_t>{};
+    hashes.reserve(dictionary.size());
+    for (const auto& value : dictionary) {
+      hashes.emplace_back(hyper_log_log_hash(value));
+    }
+    return hashes;
+  }
+
+  const ColumnID _column_id;
+
+  // The current aggregate (for MIN, MAX, SUM, and AVG) and the number of non-NULL values of each group
+  std::vector<AggregateType> _current_aggregates;
+  std::vector<uint64_t> _value_counts;
+
+  // The distinct values of each group, only used for COUNT(DISTINCT)
+  std::vector<std::unordered_set<ColumnDataType>> _distinct_values;
+
+  // The sketch of the distinct values of each group, only used for APPROX_COUNT_DISTINCT
+  std::vector<HyperLogLog> _sketches;
+};
+
+// COUNT(*) only counts the rows of each group
+class CountStarStates : public BaseAggregateStates {
+ public:
+  void resize(const size_t group_count) override { _row_counts.resize(group_count); }
+
+  void aggregate(const Chunk&, const std::vector<GroupID>& group_ids) override {
+    for (const auto group_id : group_ids) {
+      ++_row_counts[group_id];
+    }
+  }
+
+  void aggregate_ungrouped(const Chunk& chunk) override { _row_counts.front() += chunk.size(); }
+
+  void merge(BaseAggregateStates& base_other, const std::vector<GroupID>& source_group_ids,
+             const std::vector<GroupID>& target_group_ids) override {
+    const auto& other = static_cast<const CountStarStates&>(base_other);
+    for (auto idx = size_t{0}; idx < source_group_ids.size(); ++idx) {
+      _row_counts[target_group_ids[idx]] += other._row_counts[source_group_ids[idx]];
+    }
+  }
+
+  DataType output_data_type() const override { return DataType::Long; }
+
+  std::shared_ptr<BaseColumn> create_output_column(const size_t row_count) const override {
+    return std::make_shared<ValueColumn<int64_t>>(pmr_concurrent_vector<int64_t>(row_count));
+  }
+
+  void write_output(BaseColumn& output_column, const size_t offset) const override {
+    auto& values = static_cast<ValueColumn<int64_t>&>(output_column).values();
+    for (auto group_id = size_t{0}; group_id < _row_counts.size(); ++group_id) {
+      values[offset + group_id] = _row_counts[group_id];
+    }
+  }
+
+ protected:
+  std::vector<int64_t> _row_counts;
+};
+
+}  // namespace opossum
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * The Aggregate operator normalizes group keys into one 64-bit word per group-by column, followed by a word in which
+ * the bit of a group-by column is set if its value is NULL (its value word is 0 then). Integers are stored
+ * sign-extended to 64 bits and floating point numbers in their binary representation. Strings are replaced by ids
+ * that are assigned by a StringKeyDictionary.
+ */
+template <typename T>
+uint64_t encode_key_word(const T value) {
+  auto word = uint64_t{0};
+  if constexpr (std::is_integral<T>::value) {
+    const auto extended_value = static_cast<int64_t>(value);
+    std::memcpy(&word, &extended_value, sizeof(extended_value));
+  } else {
+    static_assert(sizeof(T) <= sizeof(word), "Value does not fit into a key word");
+    // -0.0 equals 0.0, but has a different binary representation
+    const auto normalized_value = (value == T{0}) ? T{0} : value;
+    std::memcpy(&word, &normalized_value, sizeof(normalized_value));
+  }
+  return word;
+}
+
+template <typename T>
+T decode_key_word(const uint64_t word) {
+  if constexpr (std::is_integral<T>::value) {
+    auto value = int64_t{0};
+    std::memcpy(&value, &word, sizeof(value));
+    return static_cast<T>(value);
+  } else {
+    auto value = T{};
+    std::memcpy(&value, &word, sizeof(value));
+    return value;
+  }
+}
+
+/**
+ * Assigns ids to the distinct strings of a group-by column. It is shared by the jobs that aggregate the chunks, which
+ * is why they pass all (distinct) strings of a chunk at once.
+ */
+class StringKeyDictionary {
+ public:
+  template <typename Strings>
+  std::vector<uint64_t> get_or_add_ids(const Strings& strings) {
+    auto ids = std::vector<uint64_t>{};
+    ids.reserve(strings.size());
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& string : strings) {
+      auto it = _ids.find(string);
+      if (it == _ids.end()) {
+        // std::deque does not move its elements when growing, so the string_view stays valid
+        _strings.emplace_back(string);
+        it = _ids.emplace(_strings.back(), _strings.size() - 1).first;
+      }
+      ids.emplace_back(it->second);
+    }
+    return ids;
+  }
+
+  // Not synchronized, only call it once all ids have been assigned
+  const std::string& string(const uint64_t id) const { return _strings[id]; }
+
+ private:
+  std::mutex _mutex;
+  std::unordered_map<std::string_view, uint64_t> _ids;
+  std::deque<std::string> _strings;
+};
+
+}  // namespace opossum
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// Dense id of a group of the Aggregate operator, i.e., the groups of an aggregation are numbered 0, 1, 2, ...
+using GroupID = uint32_t;
+
+constexpr GroupID INVALID_GROUP_ID{std::numeric_limits<GroupID>::max()};
+
+/**
+ * Assigns dense GroupIDs to the distinct group keys of an aggregation. Group keys are normalized into a fixed number of
+ * 64-bit words by the Aggregate operator, so that they can be hashed and compared without knowing the types of the
+ * group-by columns.
+ *
+ * The keys of all groups are stored contiguously in the order of their GroupIDs. The table itself uses open addressing
+ * with linear probing and only stores the GroupID and the upper half of the hash of each key. Thus, slots are small
+ * and most collisions are resolved without looking at the stored keys.
+ */
+class GroupKeyHashTable {
+ public:
+  explicit GroupKeyHashTable(const size_t key_width, const size_t expected_group_count = 0) : _key_width(key_width) {
+    DebugAssert(key_width > 0, "Group keys need at least one word");
+
+    auto capacity = size_t{MIN_CAPACITY};
+    while (capacity < expected_group_count * 2) capacity *= 2;
+
+    _slots.resize(capacity);
+    _keys.reserve(expected_group_count * key_width);
+  }
+
+  // Returns the GroupID of the key, which consists of key_width() words. The group is created if it does not exist yet.
+  GroupID find_or_insert(const uint64_t* key) {
+    const auto key_hash = hash(key);
+    const auto tag = static_cast<uint32_t>(key_hash >> 32);
+    const auto mask = _slots.size() - 1;
+
+    for (auto slot_idx = key_hash & mask;; slot_idx = (slot_idx + 1) & mask) {
+      auto& slot = _slots[slot_idx];
+
+      if (slot.group_id == INVALID_GROUP_ID) {
+        const auto group_id = static_cast<GroupID>(group_count());
+        Assert(group_id != INVALID_GROUP_ID, "Too many groups");
+
+        slot.group_id = group_id;
+        slot.tag = tag;
+        _keys.insert(_keys.end(), key, key + _key_width);
+
+        if (group_count() * 2 > _slots.size()) _grow();
+        return group_id;
+      }
+
+      if (slot.tag == tag && std::equal(key, key + _key_width, group_key(slot.group_id))) return slot.group_id;
+    }
+  }
+
+  size_t group_count() const { return _keys.size() / _key_width; }
+
+  size_t key_width() const { return _key_width; }
+
+  // Returns the key_width() words of the group's key
+  const uint64_t* group_key(const GroupID group_id) const { return &_keys[group_id * _key_width]; }
+
+  // The upper 32 bits of the hash are stored in the slots, the lower bits determine the first slot to probe
+  uint64_t hash(const uint64_t* key) const {
+    auto key_hash = uint64_t{0};
+    for (auto word_idx = size_t{0}; word_idx < _key_width; ++word_idx) {
+      key_hash = (key_hash ^ key[word_idx]) * 0x9E3779B97F4A7C15ull;
+      key_hash ^= key_hash >> 29;
+    }
+
+    // Finalizer of SplitMix64, so that the lower bits used for finding the slot depend on all bits of the key
+    key_hash ^= key_hash >> 30;
+    key_hash *= 0xBF58476D1CE4E5B9ull;
+    key_hash ^= key_hash >> 27;
+    key_hash *= 0x94D049BB133111EBull;
+    key_hash ^= key_hash >> 31;
+    return key_hash;
+  }
+
+ protected:
+  static constexpr size_t MIN_CAPACITY = 16;
+
+  struct Slot {
+    GroupID group_id{INVALID_GROUP_ID};
+    uint32_t tag{0};
+  };
+
+  // Doubles the number of slots and reinserts all groups
+  void _grow() {
+    _slots = std::vector<Slot>(_slots.size() * 2);
+    const auto mask = _slots.size() - 1;
+
+    for (GroupID group_id{0}; group_id < group_count(); ++group_id) {
+      const auto key_hash = hash(group_key(group_id));
+
+      auto slot_idx = key_hash & mask;
+      while (_slots[slot_idx].group_id != INVALID_GROUP_ID) slot_idx = (slot_idx + 1) & mask;
+
+      _slots[slot_idx].group_id = group_id;
+      _slots[slot_idx].tag = static_cast<uint32_t>(key_hash >> 32);
+    }
+  }
+
+  size_t _key_width;
+  std::vector<Slot> _slots;
+  std::vector<uint64_t> _keys;
+};
+
+}  // namespace opossum
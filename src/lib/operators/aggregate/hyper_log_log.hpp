@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "group_key_encoding.hpp"
+
+namespace opossum {
+
+/**
+ * Hashes a value for a HyperLogLog sketch. The bits of the hash have to be independent of each other, which is why
+ * the hash is passed through the finalizer of SplitMix64.
+ */
+template <typename T>
+uint64_t hyper_log_log_hash(const T& value) {
+  auto hash = uint64_t{0};
+  if constexpr (std::is_same<T, std::string>::value) {
+    hash = std::hash<std::string>{}(value);
+  } else {
+    hash = encode_key_word(value);
+  }
+
+  hash ^= hash >> 30;
+  hash *= 0xBF58476D1CE4E5B9ull;
+  hash ^= hash >> 27;
+  hash *= 0x94D049BB133111EBull;
+  hash ^= hash >> 31;
+  return hash;
+}
+
+/**
+ * Estimates the number of distinct values of a multiset in constant memory, as used by APPROX_COUNT_DISTINCT. The
+ * relative standard error of the estimate is about 1.6%. Sketches of disjoint parts of the multiset (e.g., of chunks)
+ * are merged without losing accuracy.
+ *
+ * As an aggregation usually has many groups with few distinct values, a sketch starts out with the sorted list of the
+ * distinct hashes it has seen, which also gives exact results. Only when this list grows too long, the
+ * REGISTER_COUNT registers of the actual HyperLogLog are allocated.
+ *
+ * See Flajolet et al., "HyperLogLog: the analysis of a near-optimal cardinality estimation algorithm" (2007)
+ */
+class HyperLogLog {
+ public:
+  static constexpr auto PRECISION = uint32_t{12};
+  static constexpr auto REGISTER_COUNT = size_t{1} << PRECISION;
+  static constexpr auto MAX_SPARSE_HASH_COUNT = REGISTER_COUNT / 32;
+
+  // Adds a hash obtained from hyper_log_log_hash()
+  void add(const uint64_t hash) {
+    if (!_registers.empty()) {
+      _add_to_registers(hash);
+      return;
+    }
+
+    const auto it = std::lower_bound(_sparse_hashes.begin(), _sparse_hashes.end(), hash);
+    if (it != _sparse_hashes.end() && *it == hash) return;
+
+    _sparse_hashes.insert(it, hash);
+    if (_sparse_hashes.size() > MAX_SPARSE_HASH_COUNT) _densify();
+  }
+
+  void merge(const HyperLogLog& other) {
+    if (other._registers.empty()) {
+      for (const auto hash : other._sparse_hashes) {
+        add(hash);
+      }
+      return;
+    }
+
+    if (_registers.empty()) _densify();
+    for (auto register_idx = size_t{0}; register_idx < REGISTER_COUNT; ++register_idx) {
+      _registers[register_idx] = std::max(_registers[register_idx], other._registers[register_idx]);
+    }
+  }
+
+  uint64_t estimate() const {
+    if (_registers.empty()) return _sparse_hashes.size();
+
+    auto inverse_sum = 0.0;
+    auto zero_register_count = size_t{0};
+    for (const auto register_value : _registers) {
+      inverse_sum += std::ldexp(1.0, -static_cast<int>(register_value));
+      if (register_value == 0) ++zero_register_count;
+    }
+
+    const auto register_count = static_cast<double>(REGISTER_COUNT);
+    const auto alpha = 0.7213 / (1.0 + 1.079 / register_count);
+    const auto raw_estimate = alpha * register_count * register_count / inverse_sum;
+
+    // For small cardinalities, linear counting on the empty registers is more accurate. With 64-bit hashes, no
+    // correction for large cardinalities is needed.
+    if (raw_estimate <= 2.5 * register_count && zero_register_count > 0) {
+      return static_cast<uint64_t>(
+          std::llround(register_count * std::log(register_count / static_cast<double>(zero_register_count))));
+    }
+    return static_cast<uint64_t>(std::llround(raw_estimate));
+  }
+
+ protected:
+  void _densify() {
+    _registers.resize(REGISTER_COUNT);
+    for (const auto hash : _sparse_hashes) {
+      _add_to_registers(hash);
+    }
+    _sparse_hashes = std::vector<uint64_t>{};
+  }
+
+  // The upper PRECISION bits select the register, which keeps the maximum position of the first set bit in the rest
+  void _add_to_registers(const uint64_t hash) {
+    const auto register_idx = hash >> (64 - PRECISION);
+    const auto remaining_bits = hash << PRECISION;
+    const auto rank = remaining_bits == 0 ? static_cast<uint8_t>(64 - PRECISION + 1)
+                                          : static_cast<uint8_t>(__builtin_clzll(remaining_bits) + 1);
+    _registers[register_idx] = std::max(_registers[register_idx], rank);
+  }
+
+  std::vector<uint64_t> _sparse_hashes;
+  std::vector<uint8_t> _registers;
+};
+
+}  // namespace opossum
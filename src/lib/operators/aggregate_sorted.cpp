@@ -0,0 +1,215 @@
+#include "aggregate_sorted.hpp"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "storage/value_column.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+AggregateSorted::AggregateSorted(const std::shared_ptr<AbstractOperator> in,
+                                 const std::vector<AggregateDefinition> aggregates,
+                                 const std::vector<ColumnID> groupby_column_ids)
+    : Aggregate(in, aggregates, groupby_column_ids) {}
+
+const std::string AggregateSorted::name() const { return "AggregateSorted"; }
+
+std::shared_ptr<AbstractOperator> AggregateSorted::recreate(const std::vector<AllParameterVariant>& args) const {
+  return std::make_shared<AggregateSorted>(_input_left->recreate(args), _aggregates, _groupby_column_ids);
+}
+
+std::shared_ptr<const Table> AggregateSorted::_on_execute() {
+  const auto input_table = _input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  _validate_aggregates();
+
+  auto chunk_groups = std::vector<ChunkGroups>(chunk_count);
+
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(chunk_count);
+
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(
+        std::make_shared<JobTask>([&, chunk_id]() { chunk_groups[chunk_id] = _aggregate_chunk(chunk_id); }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // A group that continues in the next chunk is merged into the first group of that chunk, so it is output only once
+  auto previous_chunk_id = std::optional<ChunkID>{};
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    auto& groups = chunk_groups[chunk_id];
+    if (groups.group_begins.empty()) continue;
+
+    if (previous_chunk_id && _continues_group(*previous_chunk_id, chunk_id)) {
+      auto& previous_groups = chunk_groups[*previous_chunk_id];
+      const auto last_group_id = static_cast<GroupID>(previous_groups.group_begins.size() - 1);
+
+      for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+        groups.states[aggregate_idx]->merge(*previous_groups.states[aggregate_idx], {last_group_id}, {GroupID{0}});
+        previous_groups.states[aggregate_idx]->resize(last_group_id);
+      }
+      previous_groups.group_begins.pop_back();
+    }
+
+    previous_chunk_id = chunk_id;
+  }
+
+  auto output_chunks = std::vector<Chunk>(chunk_count);
+
+  jobs.clear();
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (chunk_groups[chunk_id].group_begins.empty()) continue;
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      output_chunks[chunk_id] = _write_output_chunk(chunk_id, chunk_groups[chunk_id]);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  auto output = std::make_shared<Table>();
+  _add_output_column_definitions(*output);
+
+  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+    if (output_chunks[chunk_id].column_count() > 0) output->emplace_chunk(std::move(output_chunks[chunk_id]));
+  }
+
+  if (output->row_count() == 0) {
+    Chunk empty_chunk;
+    for (const auto& output_column : _create_output_columns(0)) {
+      empty_chunk.add_column(output_column);
+    }
+    output->emplace_chunk(std::move(empty_chunk));
+  }
+
+  return output;
+}
+
+AggregateSorted::ChunkGroups AggregateSorted::_aggregate_chunk(const ChunkID chunk_id) const {
+  const auto input_table = _input_table_left();
+  const auto& chunk = input_table->get_chunk(chunk_id);
+
+  auto chunk_groups = ChunkGroups{};
+
+  if (chunk.size() > 0) {
+    // A group begins at the first row and wherever the value of any group-by column changes
+    auto is_group_begin = std::vector<uint8_t>(chunk.size());
+    is_group_begin[0] = true;
+
+    for (const auto column_id : _groupby_column_ids) {
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        resolve_column_type<ColumnDataType>(*chunk.get_column(column_id), [&](const auto& typed_column) {
+          auto previous_value = ColumnDataType{};
+          auto previous_is_null = false;
+
+          auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+          iterable.for_each([&](const auto& value) {
+            const auto is_null = value.is_null();
+            if (value.chunk_offset() > 0 && is_null == previous_is_null &&
+                (is_null || value.value() == previous_value)) {
+              return;
+            }
+
+            is_group_begin[value.chunk_offset()] = true;
+            previous_is_null = is_null;
+            if (!is_null) previous_value = value.value();
+          });
+        });
+      });
+    }
+
+    auto group_ids = std::vector<GroupID>(chunk.size());
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      if (is_group_begin[chunk_offset]) chunk_groups.group_begins.emplace_back(chunk_offset);
+      group_ids[chunk_offset] = static_cast<GroupID>(chunk_groups.group_begins.size() - 1);
+    }
+
+    for (const auto& aggregate : _aggregates) {
+      auto states = _create_aggregate_states(aggregate);
+      states->resize(chunk_groups.group_begins.size());
+      states->aggregate(chunk, group_ids);
+      chunk_groups.states.emplace_back(std::move(states));
+    }
+  }
+
+  return chunk_groups;
+}
+
+bool AggregateSorted::_continues_group(const ChunkID previous_chunk_id, const ChunkID chunk_id) const {
+  const auto input_table = _input_table_left();
+
+  for (const auto column_id : _groupby_column_ids) {
+    const auto& previous_column = *input_table->get_chunk(previous_chunk_id).get_column(column_id);
+    const auto last_value = previous_column[static_cast<ChunkOffset>(previous_column.size() - 1)];
+    const auto first_value = (*input_table->get_chunk(chunk_id).get_column(column_id))[0];
+
+    if (variant_is_null(last_value) != variant_is_null(first_value)) return false;
+    if (!variant_is_null(last_value) && !(last_value == first_value)) return false;
+  }
+
+  return true;
+}
+
+Chunk AggregateSorted::_write_output_chunk(const ChunkID chunk_id, const ChunkGroups& chunk_groups) const {
+  const auto input_table = _input_table_left();
+  const auto& chunk = input_table->get_chunk(chunk_id);
+  const auto& group_begins = chunk_groups.group_begins;
+
+  const auto output_columns = _create_output_columns(group_begins.size());
+
+  // The group-by values of a group are those of its first row
+  for (auto groupby_column_idx = size_t{0}; groupby_column_idx < _groupby_column_ids.size(); ++groupby_column_idx) {
+    const auto column_id = _groupby_column_ids[groupby_column_idx];
+
+    resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      auto& output_column = static_cast<ValueColumn<ColumnDataType>&>(*output_columns[groupby_column_idx]);
+      auto& values = output_column.values();
+      auto& null_values = output_column.null_values();
+
+      resolve_column_type<ColumnDataType>(*chunk.get_column(column_id), [&](const auto& typed_column) {
+        auto group_id = size_t{0};
+
+        auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+        iterable.for_each([&](const auto& value) {
+          if (group_id == group_begins.size() || value.chunk_offset() != group_begins[group_id]) return;
+
+          if (value.is_null()) {
+            null_values[group_id] = true;
+          } else {
+            values[group_id] = value.value();
+          }
+          ++group_id;
+        });
+      });
+    });
+  }
+
+  for (auto aggregate_idx = size_t{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+    chunk_groups.states[aggregate_idx]->write_output(*output_columns[_groupby_column_ids.size() + aggregate_idx], 0);
+  }
+
+  Chunk output_chunk;
+  for (const auto& output_column : output_columns) {
+    output_chunk.add_column(output_column);
+  }
+  return output_chunk;
+}
+
+}  // namespace opossum
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "aggregate.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Aggregate for inputs in which the rows of each group are adjacent, e.g., because the input is sorted by the group-by
+ * columns. A new group starts wherever the group-by values differ from those of the previous row, so that no hashing
+ * takes place and the states of only the groups of the current chunk are kept. The output has one chunk for each
+ * input chunk in which groups end, and the groups are in the order of the input.
+ *
+ * It is a drop-in replacement for Aggregate, which the LQPTranslator uses if the input of an AggregateNode is a
+ * SortNode on the group-by columns. If the rows of a group are not adjacent, the group is output several times.
+ */
+class AggregateSorted : public Aggregate {
+ public:
+  AggregateSorted(const std::shared_ptr<AbstractOperator> in, const std::vector<AggregateDefinition> aggregates,
+                  const std::vector<ColumnID> groupby_column_ids);
+
+  const std::string name() const override;
+  std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args) const override;
+
+ protected:
+  // The groups that start in a chunk and the states of the aggregates for them
+  struct ChunkGroups {
+    std::vector<ChunkOffset> group_begins;
+    std::vector<std::unique_ptr<BaseAggregateStates>> states;
+  };
+
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Splits the rows of a chunk into groups of adjacent rows with equal group-by values and aggregates them
+  ChunkGroups _aggregate_chunk(const ChunkID chunk_id) const;
+
+  // Whether the first row of a chunk has the same group-by values as the last row of another one
+  bool _continues_group(const ChunkID previous_chunk_id, const ChunkID chunk_id) const;
+
+  Chunk _write_output_chunk(const ChunkID chunk_id, const ChunkGroups& chunk_groups) const;
+};
+
+}  // namespace opossum
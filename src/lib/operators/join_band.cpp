@@ -0,0 +1,259 @@
+#include "join_band.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "constant_mappings.hpp"
+#include "resolve_type.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+/**
+ * Returns the values of a column in the order of the table's rows, i.e., the value of the row RowID{c, o} is found at
+ * the position of o plus the sizes of all chunks before c. NULL values are returned as std::nullopt.
+ */
+template <typename T>
+std::vector<std::optional<T>> materialize_values(const Table& table, const ColumnID column_id) {
+  auto values = std::vector<std::optional<T>>{};
+  values.reserve(table.row_count());
+
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto column = table.get_chunk(chunk_id).get_column(column_id);
+    const auto chunk_begin = values.size();
+    values.resize(chunk_begin + column->size());
+
+    resolve_column_type<T>(*column, [&](auto& typed_column) {
+      auto iterable = create_iterable_from_column<T>(typed_column);
+      iterable.for_each([&](const auto& value) {
+        if (!value.is_null()) values[chunk_begin + value.chunk_offset()] = value.value();
+      });
+    });
+  }
+
+  return values;
+}
+
+// Calls func(row_index, row_id) for every row of the table, with row_index as used by materialize_values()
+template <typename Functor>
+void for_each_row(const Table& table, const Functor& func) {
+  auto row_index = size_t{0};
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto chunk_size = table.get_chunk(chunk_id).size();
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset, ++row_index) {
+      func(row_index, RowID{chunk_id, chunk_offset});
+    }
+  }
+}
+
+}  // namespace
+
+JoinBand::JoinBand(const std::shared_ptr<const AbstractOperator> left,
+                   const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                   const std::pair<ColumnID, ColumnID>& column_ids, const ColumnID upper_bound_column_id)
+    : AbstractJoinOperator(left, right, mode, column_ids, ScanType::Between),
+      _upper_bound_column_id(upper_bound_column_id) {
+  Assert(mode != JoinMode::Self, "JoinBand does not support self joins");
+}
+
+const std::string JoinBand::name() const { return "JoinBand"; }
+
+const std::string JoinBand::description() const {
+  const auto column_name = [](const std::shared_ptr<const Table>& table, const ColumnID column_id) {
+    if (table) return table->column_name(column_id);
+    return std::string("Col #") + std::to_string(column_id);
+  };
+
+  return name() + "\\n(" + join_mode_to_string.at(_mode) + " Join where " +
+         column_name(_input_table_left(), _column_ids.first) + " BETWEEN " +
+         column_name(_input_table_right(), _column_ids.second) + " AND " +
+         column_name(_input_table_right(), _upper_bound_column_id) + ")";
+}
+
+std::shared_ptr<AbstractOperator> JoinBand::recreate(const std::vector<AllParameterVariant>& args) const {
+  return std::make_shared<JoinBand>(_input_left->recreate(args), _input_right->recreate(args), _mode, _column_ids,
+                                    _upper_bound_column_id);
+}
+
+ColumnID JoinBand::upper_bound_column_id() const { return _upper_bound_column_id; }
+
+std::shared_ptr<const Table> JoinBand::_on_execute() {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+
+  const auto point_type = left_table->column_type(_column_ids.first);
+  const auto bound_type = right_table->column_type(_column_ids.second);
+  Assert(bound_type == right_table->column_type(_upper_bound_column_id),
+         "Lower and upper bound of a band join must have the same type");
+
+  auto output_table = std::make_shared<Table>();
+
+  const auto is_semi_or_anti = (_mode == JoinMode::Semi || _mode == JoinMode::Anti);
+  const auto left_may_be_null = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
+  const auto right_may_be_null = (_mode == JoinMode::Left || _mode == JoinMode::Outer);
+
+  for (ColumnID column_id{0}; column_id < left_table->column_count(); ++column_id) {
+    const auto nullable = (left_may_be_null || left_table->column_is_nullable(column_id));
+    output_table->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id),
+                                        nullable);
+  }
+
+  // Semi and Anti joins only return the rows of the left input
+  if (!is_semi_or_anti) {
+    for (ColumnID column_id{0}; column_id < right_table->column_count(); ++column_id) {
+      const auto nullable = (right_may_be_null || right_table->column_is_nullable(column_id));
+      output_table->add_column_definition(right_table->column_name(column_id), right_table->column_type(column_id),
+                                          nullable);
+    }
+  }
+
+  auto pos_list_left = std::make_shared<PosList>();
+  auto pos_list_right = std::make_shared<PosList>();
+
+  resolve_data_type(point_type, [&](auto point_data_type) {
+    using PointType = typename decltype(point_data_type)::type;
+
+    resolve_data_type(bound_type, [&](auto bound_data_type) {
+      using BoundType = typename decltype(bound_data_type)::type;
+
+      // Only compile valid combinations: strings can only be compared with strings
+      if constexpr (std::is_same<PointType, std::string>{} == std::is_same<BoundType, std::string>{}) {
+        _sort_and_sweep<PointType, BoundType>(*pos_list_left, *pos_list_right);
+      } else {
+        Fail("Cannot join a string column with a non-string column.");
+      }
+    });
+  });
+
+  auto output_chunk = Chunk{};
+  _write_output_columns(output_chunk, left_table, pos_list_left);
+  if (!is_semi_or_anti) {
+    _write_output_columns(output_chunk, right_table, pos_list_right);
+  }
+  output_table->emplace_chunk(std::move(output_chunk));
+
+  return output_table;
+}
+
+template <typename PointType, typename BoundType>
+void JoinBand::_sort_and_sweep(PosList& pos_list_left, PosList& pos_list_right) const {
+  const auto& left_table = *_input_table_left();
+  const auto& right_table = *_input_table_right();
+
+  const auto left_outer = (_mode == JoinMode::Left || _mode == JoinMode::Outer);
+  const auto right_outer = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
+
+  struct Point {
+    PointType value;
+    RowID row_id;
+  };
+
+  struct Interval {
+    BoundType lower;
+    BoundType upper;
+    RowID row_id;
+  };
+
+  // Rows with a NULL point or bound cannot match, but outer joins add them to the output. As in JoinHash, left rows
+  // with a NULL point are not part of the output of an Anti join.
+  auto null_points = PosList{};
+  auto null_intervals = PosList{};
+
+  auto points = std::vector<Point>{};
+  points.reserve(left_table.row_count());
+  {
+    const auto values = materialize_values<PointType>(left_table, _column_ids.first);
+    for_each_row(left_table, [&](const size_t row_index, const RowID row_id) {
+      if (values[row_index]) {
+        points.emplace_back(Point{*values[row_index], row_id});
+      } else {
+        null_points.emplace_back(row_id);
+      }
+    });
+  }
+
+  auto intervals = std::vector<Interval>{};
+  intervals.reserve(right_table.row_count());
+  {
+    const auto lower_bounds = materialize_values<BoundType>(right_table, _column_ids.second);
+    const auto upper_bounds = materialize_values<BoundType>(right_table, _upper_bound_column_id);
+    for_each_row(right_table, [&](const size_t row_index, const RowID row_id) {
+      if (lower_bounds[row_index] && upper_bounds[row_index]) {
+        intervals.emplace_back(Interval{*lower_bounds[row_index], *upper_bounds[row_index], row_id});
+      } else {
+        null_intervals.emplace_back(row_id);
+      }
+    });
+  }
+
+  std::sort(points.begin(), points.end(), [](const auto& lhs, const auto& rhs) { return lhs.value < rhs.value; });
+  std::sort(intervals.begin(), intervals.end(),
+            [](const auto& lhs, const auto& rhs) { return lhs.lower < rhs.lower; });
+
+  // Indices of the intervals that start at or before the current point, as a min-heap on their upper bounds
+  auto active_intervals = std::vector<size_t>{};
+  const auto ends_later = [&](const size_t lhs, const size_t rhs) {
+    return intervals[lhs].upper > intervals[rhs].upper;
+  };
+
+  auto interval_matched = std::vector<bool>(right_outer ? intervals.size() : 0);
+  auto next_interval = size_t{0};
+
+  for (const auto& point : points) {
+    while (next_interval < intervals.size() && !(point.value < intervals[next_interval].lower)) {
+      active_intervals.emplace_back(next_interval++);
+      std::push_heap(active_intervals.begin(), active_intervals.end(), ends_later);
+    }
+
+    while (!active_intervals.empty() && intervals[active_intervals.front()].upper < point.value) {
+      std::pop_heap(active_intervals.begin(), active_intervals.end(), ends_later);
+      active_intervals.pop_back();
+    }
+
+    if (_mode == JoinMode::Semi || _mode == JoinMode::Anti) {
+      if (active_intervals.empty() == (_mode == JoinMode::Anti)) pos_list_left.emplace_back(point.row_id);
+      continue;
+    }
+
+    if (active_intervals.empty() && left_outer) {
+      pos_list_left.emplace_back(point.row_id);
+      pos_list_right.emplace_back(NULL_ROW_ID);
+    }
+
+    for (const auto interval_idx : active_intervals) {
+      pos_list_left.emplace_back(point.row_id);
+      pos_list_right.emplace_back(intervals[interval_idx].row_id);
+      if (right_outer) interval_matched[interval_idx] = true;
+    }
+  }
+
+  if (left_outer) {
+    for (const auto row_id : null_points) {
+      pos_list_left.emplace_back(row_id);
+      pos_list_right.emplace_back(NULL_ROW_ID);
+    }
+  }
+
+  if (right_outer) {
+    for (auto interval_idx = size_t{0}; interval_idx < intervals.size(); ++interval_idx) {
+      if (interval_matched[interval_idx]) continue;
+      pos_list_left.emplace_back(NULL_ROW_ID);
+      pos_list_right.emplace_back(intervals[interval_idx].row_id);
+    }
+
+    for (const auto row_id : null_intervals) {
+      pos_list_left.emplace_back(NULL_ROW_ID);
+      pos_list_right.emplace_back(row_id);
+    }
+  }
+}
+
+}  // namespace opossum
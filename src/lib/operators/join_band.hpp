@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * This is a band join for predicates of the form `left.point BETWEEN right.lower AND right.upper` (both bounds are
+ * inclusive), e.g., for assigning events to the time windows they fall into. Evaluating such a predicate with a
+ * Product or a JoinNestedLoop compares every pair of rows, and a JoinSortMerge on one of the bounds still produces all
+ * rows that only satisfy that bound.
+ *
+ * Instead, the points of the left input are sorted by their value and the intervals of the right input by their lower
+ * bound. Both are then swept in ascending order: Before a point is processed, all intervals starting at or before it
+ * are added to a min-heap on their upper bound, and all intervals ending before it are removed from the heap. As the
+ * points are visited in ascending order, removed intervals cannot match any later point, and all intervals left in the
+ * heap contain the current point. Thus, the join runs in O(n log n + m log m + output size).
+ *
+ * column_ids contains the point column of the left input and the lower bound column of the right input. The upper
+ * bound column of the right input has to have the same type as the lower bound column. All join modes except for
+ * Cross, Natural, and Self are supported. Rows with a NULL point or a NULL bound never match. Like in JoinHash, rows
+ * with a NULL point are not part of the output of an Anti join.
+ */
+class JoinBand : public AbstractJoinOperator {
+ public:
+  JoinBand(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+           const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ColumnID upper_bound_column_id);
+
+  const std::string name() const override;
+  const std::string description() const override;
+  std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
+
+  ColumnID upper_bound_column_id() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Sorts both inputs and sweeps over them, writing the matching (and, for outer joins, unmatched) rows
+  template <typename PointType, typename BoundType>
+  void _sort_and_sweep(PosList& pos_list_left, PosList& pos_list_right) const;
+
+  const ColumnID _upper_bound_column_id;
+};
+
+}  // namespace opossum
@@ -1,8 +1,13 @@
 #include "join_hash.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -12,28 +17,75 @@
 #include "scheduler/job_task.hpp"
 #include "storage/column_visitable.hpp"
 #include "storage/dictionary_column.hpp"
+#include "storage/iterables/attribute_vector_iterable.hpp"
 #include "storage/iterables/create_iterable_from_column.hpp"
 #include "storage/reference_column.hpp"
 #include "storage/value_column.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
+#include "utils/bloom_filter.hpp"
+#include "utils/cache_size.hpp"
 #include "utils/cuckoo_hashtable.hpp"
 #include "utils/murmur_hash.hpp"
+#include "utils/performance_warning.hpp"
+#include "utils/physical_memory.hpp"
+#include "utils/spill_file.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Returns the DictionaryColumns of the given column or an empty vector if not all of its chunks are dictionary-encoded
+template <typename T>
+std::vector<std::shared_ptr<const DictionaryColumn<T>>> get_dictionary_columns(const Table& table,
+                                                                               const ColumnID column_id) {
+  auto dictionary_columns = std::vector<std::shared_ptr<const DictionaryColumn<T>>>{};
+  dictionary_columns.reserve(table.chunk_count());
+
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    auto dictionary_column =
+        std::dynamic_pointer_cast<const DictionaryColumn<T>>(table.get_chunk(chunk_id).get_column(column_id));
+    if (!dictionary_column) return {};
+
+    dictionary_columns.emplace_back(std::move(dictionary_column));
+  }
+
+  return dictionary_columns;
+}
+
+}  // namespace
+
 JoinHash::JoinHash(const std::shared_ptr<const AbstractOperator> left,
                    const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                   const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
-    : AbstractJoinOperator(left, right, mode, column_ids, scan_type) {
+                   const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                   const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids,
+                   const std::optional<size_t>& radix_bits, const std::optional<size_t>& memory_budget)
+    : AbstractJoinOperator(left, right, mode, column_ids, scan_type, additional_column_ids),
+      _radix_bits(radix_bits),
+      _memory_budget(memory_budget) {
   DebugAssert(scan_type == ScanType::Equals, "Operator not supported by Hash Join.");
+  DebugAssert(!radix_bits || *radix_bits <= MAX_RADIX_BITS, "Too many radix bits requested.");
 }
 
 const std::string JoinHash::name() const { return "JoinHash"; }
 
 std::shared_ptr<AbstractOperator> JoinHash::recreate(const std::vector<AllParameterVariant>& args) const {
   return std::make_shared<JoinHash>(_input_left->recreate(args), _input_right->recreate(args), _mode, _column_ids,
-                                    _scan_type);
+                                    _scan_type, _additional_column_ids, _radix_bits, _memory_budget);
+}
+
+size_t JoinHash::calculate_radix_bits(const size_t build_relation_size, const size_t cache_size) {
+  if (build_relation_size <= cache_size) return 0;
+
+  // We need at least build_relation_size / cache_size partitions, rounded up to the next power of two
+  const auto partition_count = static_cast<double>(build_relation_size) / static_cast<double>(cache_size);
+  const auto radix_bits = static_cast<size_t>(std::ceil(std::log2(partition_count)));
+
+  return std::min(radix_bits, MAX_RADIX_BITS);
+}
+
+size_t JoinHash::default_memory_budget() {
+  return static_cast<size_t>(DEFAULT_MEMORY_BUDGET_FRACTION * physical_memory_size());
 }
 
 std::shared_ptr<const Table> JoinHash::_on_execute() {
@@ -43,11 +95,11 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
   ColumnID probe_column_id;
 
   // This is the expected implementation for swapping tables:
-  // (1) if left or right outer join, outer relation becomes probe relation (we have to swap only for left outer)
-  // (2) for a semi and anti join the inputs are always swapped
-  bool inputs_swapped = (_mode == JoinMode::Left || _mode == JoinMode::Anti || _mode == JoinMode::Semi);
+  // (1) for a semi and anti join the inputs are always swapped
+  bool inputs_swapped = (_mode == JoinMode::Anti || _mode == JoinMode::Semi);
 
-  // (3) else the smaller relation will become build relation, the larger probe relation
+  // (2) else the smaller relation will become build relation, the larger probe relation. For outer joins, either
+  // relation can be the outer one, as unmatched rows of the build relation are tracked in the hash tables.
   if (!inputs_swapped && _input_left->get_output()->row_count() > _input_right->get_output()->row_count()) {
     inputs_swapped = true;
   }
@@ -71,14 +123,142 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
   auto build_input = build_operator->get_output();
   auto probe_input = probe_operator->get_output();
 
+  auto build_column_type = build_input->column_type(build_column_id);
+  auto probe_column_type = probe_input->column_type(probe_column_id);
+
+  // Composite-key and dictionary-encoded joins build and probe on key tables, the output still references the inputs
+  auto key_tables = std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>>{};
+  if (!_additional_column_ids.empty()) {
+    key_tables = _create_composite_key_tables();
+    build_column_type = DataType::String;
+    probe_column_type = DataType::String;
+  } else {
+    key_tables = _create_value_id_key_tables();
+    if (key_tables.first) {
+      build_column_type = DataType::Int;
+      probe_column_type = DataType::Int;
+    }
+  }
+
+  if (key_tables.first) {
+    if (inputs_swapped) std::swap(key_tables.first, key_tables.second);
+    adjusted_column_ids = std::make_pair(ColumnID{0}, ColumnID{0});
+  }
+
   _impl = make_unique_by_data_types<AbstractReadOnlyOperatorImpl, JoinHashImpl>(
-      build_input->column_type(build_column_id), probe_input->column_type(probe_column_id), build_operator,
-      probe_operator, _mode, adjusted_column_ids, _scan_type, inputs_swapped);
+      build_column_type, probe_column_type, build_operator, probe_operator, _mode, adjusted_column_ids, _scan_type,
+      inputs_swapped, _radix_bits, _memory_budget ? *_memory_budget : default_memory_budget(), key_tables);
   return _impl->_on_execute();
 }
 
 void JoinHash::_on_cleanup() { _impl.reset(); }
 
+std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>> JoinHash::_create_value_id_key_tables() const {
+  const auto left_input = _input_table_left();
+  const auto right_input = _input_table_right();
+
+  if (left_input->column_type(_column_ids.first) != DataType::String ||
+      right_input->column_type(_column_ids.second) != DataType::String) {
+    return {};
+  }
+
+  const auto left_columns = get_dictionary_columns<std::string>(*left_input, _column_ids.first);
+  const auto right_columns = get_dictionary_columns<std::string>(*right_input, _column_ids.second);
+  if (left_columns.empty() || right_columns.empty()) return {};
+
+  /*
+  Translate each dictionary into join keys once: every value of the left dictionaries is assigned a join key, the
+  values of the right dictionaries look up the join key of the same value. Values that do not occur on the left side
+  get a key that never matches. Chunks that share their dictionary, e.g., in a self join, reuse its translation.
+  */
+  using DictionaryColumns = std::vector<std::shared_ptr<const DictionaryColumn<std::string>>>;
+  using Dictionary = pmr_vector<std::string>;
+  using Translation = std::vector<int32_t>;
+  constexpr auto NO_JOIN_PARTNER_KEY = int32_t{-1};
+
+  auto join_keys_by_value = std::unordered_map<std::string, int32_t>{};
+  auto translations_by_dictionary = std::unordered_map<const Dictionary*, std::shared_ptr<const Translation>>{};
+
+  const auto translate_dictionaries = [&](const DictionaryColumns& columns, const bool assign_join_keys) {
+    auto translations = std::vector<std::shared_ptr<const Translation>>{};
+    translations.reserve(columns.size());
+
+    for (const auto& column : columns) {
+      const auto& dictionary = *column->dictionary();
+      auto& translation = translations_by_dictionary[&dictionary];
+
+      if (!translation) {
+        auto new_translation = std::make_shared<Translation>();
+        new_translation->reserve(dictionary.size());
+
+        for (const auto& value : dictionary) {
+          if (assign_join_keys) {
+            const auto next_join_key = static_cast<int32_t>(join_keys_by_value.size());
+            new_translation->emplace_back(join_keys_by_value.emplace(value, next_join_key).first->second);
+          } else {
+            const auto join_key_it = join_keys_by_value.find(value);
+            new_translation->emplace_back(join_key_it != join_keys_by_value.end() ? join_key_it->second
+                                                                                   : NO_JOIN_PARTNER_KEY);
+          }
+        }
+
+        translation = std::move(new_translation);
+      }
+
+      translations.emplace_back(translation);
+    }
+
+    return translations;
+  };
+
+  const auto left_translations = translate_dictionaries(left_columns, true);
+  const auto right_translations = translate_dictionaries(right_columns, false);
+
+  // Replace the ValueIDs of each chunk with their join keys
+  const auto create_key_table = [&](const DictionaryColumns& columns,
+                                    const std::vector<std::shared_ptr<const Translation>>& translations) {
+    auto key_table = std::make_shared<Table>();
+    key_table->add_column("value_id_key", DataType::Int, true);
+
+    // Create the chunks upfront. Table::emplace_chunk would drop an empty first chunk and thus shift the ChunkIDs.
+    for (ChunkID chunk_id{1}; chunk_id < columns.size(); ++chunk_id) {
+      key_table->create_new_chunk();
+    }
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(columns.size());
+
+    for (ChunkID chunk_id{0}; chunk_id < columns.size(); ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto& translation = *translations[chunk_id];
+        const auto& attribute_vector = *columns[chunk_id]->attribute_vector();
+
+        auto key_values = pmr_concurrent_vector<int32_t>(attribute_vector.size());
+        auto key_null_values = pmr_concurrent_vector<bool>(attribute_vector.size());
+
+        auto iterable = AttributeVectorIterable{attribute_vector};
+        iterable.for_each([&](const auto& value_id) {
+          if (value_id.is_null()) {
+            key_null_values[value_id.chunk_offset()] = true;
+          } else {
+            key_values[value_id.chunk_offset()] = translation[value_id.value()];
+          }
+        });
+
+        key_table->get_chunk(chunk_id).replace_column(
+            0, std::make_shared<ValueColumn<int32_t>>(std::move(key_values), std::move(key_null_values)));
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    return std::const_pointer_cast<const Table>(key_table);
+  };
+
+  return {create_key_table(left_columns, left_translations), create_key_table(right_columns, right_translations)};
+}
+
 // currently using 32bit Murmur
 using Hash = uint32_t;
 
@@ -88,14 +268,45 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
  public:
   JoinHashImpl(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
                const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
-               const bool inputs_swapped)
+               const bool inputs_swapped, const std::optional<size_t>& radix_bits, const size_t memory_budget,
+               const std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>>& key_tables)
       : _left(left),
         _right(right),
         _mode(mode),
         _column_ids(column_ids),
         _scan_type(scan_type),
         _inputs_swapped(inputs_swapped),
-        _output_table(std::make_shared<Table>()) {}
+        _build_side_outer(mode == JoinMode::Outer || (mode == JoinMode::Left && !inputs_swapped) ||
+                          (mode == JoinMode::Right && inputs_swapped)),
+        _probe_side_outer(mode == JoinMode::Outer || (mode == JoinMode::Left && inputs_swapped) ||
+                          (mode == JoinMode::Right && !inputs_swapped)),
+        _memory_budget(memory_budget),
+        _key_tables(key_tables),
+        _output_table(std::make_shared<Table>()) {
+    /*
+    Rough estimate of the memory a build element occupies during the build phase: the partitioned element itself
+    and its share of the cuckoo hash table, i.e., one slot per hash function plus the element and its PosList.
+    */
+    _bytes_per_build_element = sizeof(PartitionedElement<LeftType>) + sizeof(LeftType) +
+                               4 * sizeof(std::shared_ptr<void>) + sizeof(PosList) + sizeof(RowID);
+    _build_relation_size = _left->get_output()->row_count() * _bytes_per_build_element;
+
+    // The radix partitions are assigned based on hash values, so matching keys of different types would end up in
+    // different partitions. Joins of columns with different types are not partitioned.
+    auto total_radix_bits = size_t{0};
+    if constexpr (std::is_same<LeftType, RightType>{}) {
+      total_radix_bits =
+          radix_bits ? *radix_bits : JoinHash::calculate_radix_bits(_build_relation_size, l2_cache_size());
+    }
+
+    // Distribute the radix bits evenly over the partitioning passes
+    if (total_radix_bits > MAX_RADIX_BITS_PER_PASS) {
+      _radix_bits_first_pass = (total_radix_bits + 1) / 2;
+      _radix_bits_second_pass = total_radix_bits / 2;
+    } else {
+      _radix_bits_first_pass = total_radix_bits;
+    }
+  }
 
   virtual ~JoinHashImpl() = default;
 
@@ -106,10 +317,33 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
   const ScanType _scan_type;
 
   const bool _inputs_swapped;
+
+  // Whether the rows of the build or the probe relation without a join partner are part of the output
+  const bool _build_side_outer;
+  const bool _probe_side_outer;
+
+  // Maximum size of the build relation (including its hash table) in bytes before the Grace hash join is used
+  const size_t _memory_budget;
+
+  // For composite-key joins, the tables holding the encoded keys of the (build, probe) inputs. The join columns in
+  // _column_ids then refer to these tables instead of the inputs.
+  const std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>> _key_tables;
+
   const std::shared_ptr<Table> _output_table;
 
   const unsigned int _partitioning_seed = 13;
-  const size_t _radix_bits = 9;
+
+  // Estimated memory a single element of the build relation occupies during the build phase and the estimated size
+  // of the whole build relation, both in bytes
+  size_t _bytes_per_build_element = 0;
+  size_t _build_relation_size = 0;
+
+  /*
+  Number of radix bits used in the first and the (optional) second partitioning pass. If no radix bits are used at
+  all, the build relation fits into the cache and partitioning is skipped.
+  */
+  size_t _radix_bits_first_pass = 0;
+  size_t _radix_bits_second_pass = 0;
 
   /*
   This is how elements of the input relations are saved after materialization.
@@ -136,12 +370,44 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
   struct RadixContainer {
     std::shared_ptr<Partition<T>> elements;
     std::vector<size_t> partition_offsets;
+
+    // If skewed partitions of the probe relation were split up, the hash table that each partition is probed against
+    std::vector<size_t> hashtable_ids;
   };
 
+  // Returns the hash table that a partition of the probe relation is probed against
+  template <typename T>
+  static size_t _hashtable_id(const RadixContainer<T>& radix_container, const size_t hashtable_count,
+                              const size_t partition_id) {
+    if (!radix_container.hashtable_ids.empty()) return radix_container.hashtable_ids[partition_id];
+
+    // Without partitioning, all ranges of the probe relation are probed against the same hash table
+    return hashtable_count == 1 ? 0 : partition_id;
+  }
+
+  /*
+  Returns the partition of a hash value for a partitioning pass, which uses the next `radix_bits` most significant
+  bits after skipping the `previous_radix_bits` bits already used by previous passes.
+  */
+  static size_t _radix(const Hash hash, const size_t previous_radix_bits, const size_t radix_bits) {
+    if (radix_bits == 0) return 0;
+    return (hash >> (32 - previous_radix_bits - radix_bits)) & ((size_t{1} << radix_bits) - 1);
+  }
+
+  /*
+  Materializes the join column of the input relation and hashes the values for the first partitioning pass.
+  NULL values never find a join partner and are not materialized. If `null_rows` is set, their RowIDs are collected
+  instead, so that outer joins can add them to the output.
+  If `bloom_filter_to_fill` is set, the hash values of all materialized rows are inserted into it. If
+  `bloom_filter_to_check` is set, rows whose hash values are not contained in it are dropped, as they cannot find a
+  join partner.
+  */
   template <typename T>
   std::shared_ptr<Partition<T>> _materialize_input(const std::shared_ptr<const Table> in_table, ColumnID column_id,
                                                    std::vector<std::shared_ptr<std::vector<size_t>>>& histograms,
-                                                   bool keep_nulls = false) {
+                                                   PosList* null_rows = nullptr,
+                                                   BloomFilter* bloom_filter_to_fill = nullptr,
+                                                   const BloomFilter* bloom_filter_to_check = nullptr) {
     // list of all elements that will be partitioned
     auto elements = std::make_shared<Partition<T>>();
     elements->resize(in_table->row_count());
@@ -149,12 +415,8 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     // arbitrary seed for the first hash iteration
     unsigned int seed = _partitioning_seed;
 
-    // fan-out
-    const size_t num_partitions = 1 << _radix_bits;
-
-    // currently, we just do one pass
-    size_t pass = 0;
-    size_t mask = static_cast<uint32_t>(pow(2, _radix_bits * (pass + 1)) - 1);
+    // fan-out of the first pass
+    const size_t num_partitions = size_t{1} << _radix_bits_first_pass;
 
     auto chunk_offsets = std::vector<size_t>(in_table->chunk_count());
 
@@ -171,6 +433,8 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     histograms = std::vector<std::shared_ptr<std::vector<size_t>>>();
     histograms.resize(chunk_offsets.size());
 
+    auto null_rows_per_chunk = std::vector<PosList>(null_rows ? in_table->chunk_count() : 0);
+
     std::vector<std::shared_ptr<AbstractTask>> jobs;
     jobs.reserve(in_table->chunk_count());
 
@@ -189,13 +453,15 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         auto materialized_chunk = std::vector<std::pair<RowID, T>>();
 
         // Materialize the chunk
-        resolve_column_type<T>(*column, [&, chunk_id, keep_nulls](auto& typed_column) {
+        resolve_column_type<T>(*column, [&, chunk_id](auto& typed_column) {
           auto iterable = create_iterable_from_column<T>(typed_column);
 
-          iterable.for_each([&, chunk_id, keep_nulls](const auto& value) {
-            if (!value.is_null() || keep_nulls) {
+          iterable.for_each([&, chunk_id](const auto& value) {
+            if (!value.is_null()) {
               materialized_chunk.emplace_back(RowID{chunk_id, value.chunk_offset()}, value.value());
             } else {
+              if (null_rows) null_rows_per_chunk[chunk_id].emplace_back(RowID{chunk_id, value.chunk_offset()});
+
               // We need to add this to avoid gaps in the list of offsets when we iterate later on
               materialized_chunk.emplace_back(RowID{chunk_id, INVALID_CHUNK_OFFSET}, T{});
             }
@@ -210,18 +476,26 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         values from different inputs (important for Multi Joins).
         For performance reasons this if statement is around the for loop.
         */
+        // Returns whether a row with the given hash value needs to be materialized
+        const auto apply_bloom_filters = [&](const Hash hash) {
+          if (bloom_filter_to_fill) bloom_filter_to_fill->insert(hash);
+          return !bloom_filter_to_check || bloom_filter_to_check->contains(hash);
+        };
+
         if (auto ref_column = std::dynamic_pointer_cast<const ReferenceColumn>(column)) {
           // hash and add to the other elements
           ChunkOffset offset = 0;
           for (auto&& elem : materialized_chunk) {
             if (elem.first.chunk_offset != INVALID_CHUNK_OFFSET) {
-              output[row_id] =
-                  PartitionedElement<T>{RowID{chunk_id, offset}, murmur2<T>(elem.second, seed), elem.second};
+              const auto hash = murmur2<T>(elem.second, seed);
 
-              const Hash radix = (output[row_id].partition_hash >> (32 - _radix_bits * (pass + 1))) & mask;
-              histogram[radix]++;
+              if (apply_bloom_filters(hash)) {
+                output[row_id] = PartitionedElement<T>{RowID{chunk_id, offset}, hash, elem.second};
 
-              row_id++;
+                histogram[_radix(hash, 0, _radix_bits_first_pass)]++;
+
+                row_id++;
+              }
             }
 
             offset++;
@@ -231,10 +505,12 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
           for (auto&& elem : materialized_chunk) {
             if (elem.first.chunk_offset == INVALID_CHUNK_OFFSET) continue;
 
-            output[row_id] = PartitionedElement<T>{elem.first, murmur2<T>(elem.second, seed), elem.second};
+            const auto hash = murmur2<T>(elem.second, seed);
+            if (!apply_bloom_filters(hash)) continue;
 
-            const Hash radix = (output[row_id].partition_hash >> (32 - _radix_bits * (pass + 1))) & mask;
-            histogram[radix]++;
+            output[row_id] = PartitionedElement<T>{elem.first, hash, elem.second};
+
+            histogram[_radix(hash, 0, _radix_bits_first_pass)]++;
 
             row_id++;
           }
@@ -245,20 +521,19 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
     CurrentScheduler::wait_for_tasks(jobs);
 
+    for (const auto& chunk_null_rows : null_rows_per_chunk) {
+      null_rows->insert(null_rows->end(), chunk_null_rows.begin(), chunk_null_rows.end());
+    }
+
     return elements;
   }
 
   template <typename T>
   RadixContainer<T> _partition_radix_parallel(std::shared_ptr<Partition<T>> materialized,
                                               std::shared_ptr<std::vector<size_t>> chunk_offsets,
-                                              std::vector<std::shared_ptr<std::vector<size_t>>>& histograms,
-                                              bool keep_nulls = false) {
-    // fan-out
-    const size_t num_partitions = 1 << _radix_bits;
-
-    // currently, we just do one pass
-    size_t pass = 0;
-    size_t mask = static_cast<uint32_t>(pow(2, _radix_bits * (pass + 1)) - 1);
+                                              std::vector<std::shared_ptr<std::vector<size_t>>>& histograms) {
+    // fan-out of the first pass
+    const size_t num_partitions = size_t{1} << _radix_bits_first_pass;
 
     // allocate new (shared) output
     auto output = std::make_shared<Partition<T>>();
@@ -329,11 +604,11 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         for (size_t column_offset = input_offset; column_offset < input_offset + input_size; ++column_offset) {
           auto& element = (*materialized)[column_offset];
 
-          if (!keep_nulls && element.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+          if (element.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
             continue;
           }
 
-          const size_t radix = (element.partition_hash >> (32 - _radix_bits * (pass + 1))) & mask;
+          const auto radix = _radix(element.partition_hash, 0, _radix_bits_first_pass);
 
           out[output_offsets[radix]++] = element;
         }
@@ -346,6 +621,146 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     return radix_output;
   }
 
+  /*
+  Second partitioning pass for large relations. Each partition of the first pass is refined independently using the
+  next radix bits. As the partitions of the first pass are contiguous, the refined partitions are written to the same
+  range of a new buffer, so that the final partitions are ordered by the combined radix bits of both passes.
+  */
+  template <typename T>
+  RadixContainer<T> _refine_partitions(const RadixContainer<T>& input) {
+    const size_t input_partition_count = input.partition_offsets.size() - 1;
+    const size_t fan_out = size_t{1} << _radix_bits_second_pass;
+
+    RadixContainer<T> radix_output;
+    radix_output.elements = std::make_shared<Partition<T>>(input.elements->size());
+    radix_output.partition_offsets.resize(input_partition_count * fan_out + 1);
+    radix_output.partition_offsets.back() = input.partition_offsets.back();
+
+    std::vector<std::shared_ptr<AbstractTask>> jobs;
+    jobs.reserve(input_partition_count);
+
+    for (size_t input_partition_id = 0; input_partition_id < input_partition_count; ++input_partition_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, input_partition_id]() {
+        const auto& in = static_cast<const Partition<T>&>(*input.elements);
+        auto& out = static_cast<Partition<T>&>(*radix_output.elements);
+        const auto partition_begin = input.partition_offsets[input_partition_id];
+        const auto partition_end = input.partition_offsets[input_partition_id + 1];
+
+        auto histogram = std::vector<size_t>(fan_out, 0);
+        for (auto offset = partition_begin; offset < partition_end; ++offset) {
+          ++histogram[_radix(in[offset].partition_hash, _radix_bits_first_pass, _radix_bits_second_pass)];
+        }
+
+        // Each job writes the offsets of its own sub-partitions, so no synchronization is needed
+        auto output_offsets = std::vector<size_t>(fan_out);
+        auto output_offset = partition_begin;
+        for (size_t sub_partition_id = 0; sub_partition_id < fan_out; ++sub_partition_id) {
+          output_offsets[sub_partition_id] = output_offset;
+          radix_output.partition_offsets[input_partition_id * fan_out + sub_partition_id] = output_offset;
+          output_offset += histogram[sub_partition_id];
+        }
+
+        for (auto offset = partition_begin; offset < partition_end; ++offset) {
+          const auto& element = in[offset];
+          out[output_offsets[_radix(element.partition_hash, _radix_bits_first_pass, _radix_bits_second_pass)]++] =
+              element;
+        }
+      }));
+      jobs.back()->schedule();
+    }
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    return radix_output;
+  }
+
+  /*
+  If partitioning is skipped, the materialized elements are used as they are. The build relation forms a single
+  partition. The probe relation is split up along its input chunks so that probing can still be parallelized; all of
+  these ranges are probed against the single hash table. Gaps that the materialization leaves for NULL values carry an
+  invalid RowID and are skipped by the build and probe phases.
+  */
+  template <typename T>
+  RadixContainer<T> _skip_partitioning(std::shared_ptr<Partition<T>> materialized,
+                                       const std::vector<size_t>& chunk_offsets, const bool split_by_chunks) {
+    RadixContainer<T> radix_output;
+    radix_output.elements = materialized;
+
+    if (split_by_chunks) {
+      radix_output.partition_offsets = chunk_offsets;
+    } else {
+      radix_output.partition_offsets = {0};
+    }
+    radix_output.partition_offsets.emplace_back(materialized->size());
+
+    return radix_output;
+  }
+
+  /*
+  Skew handling: If a join key dominates one of the relations, e.g., a default value or a popular product, its radix
+  partition holds a large share of the work, and the job probing it would delay the whole join. The partition sizes
+  obtained from the histograms reveal such heavy hitters. The work of probing a partition is estimated as its size in
+  the probe relation, weighted by how much larger than average the partition is in the build relation (every probe row
+  of a hot build key produces many output rows). Partitions with more than SKEW_FACTOR times the average work are
+  split into ranges of average work, which are probed in separate jobs against the same, shared hash table.
+  */
+  static constexpr double SKEW_FACTOR = 2.0;
+  static constexpr size_t MIN_PROBE_RANGE_SIZE = 1'000;
+
+  static RadixContainer<RightType> _split_skewed_partitions(const RadixContainer<RightType>& probe_container,
+                                                            const RadixContainer<LeftType>& build_container) {
+    const auto& probe_offsets = probe_container.partition_offsets;
+    const auto& build_offsets = build_container.partition_offsets;
+    const auto partition_count = probe_offsets.size() - 1;
+
+    const auto average_build_size = static_cast<double>(build_offsets.back()) / partition_count;
+
+    auto work = std::vector<double>(partition_count);
+    auto total_work = 0.0;
+    for (size_t partition_id = 0; partition_id < partition_count; ++partition_id) {
+      const auto probe_size = static_cast<double>(probe_offsets[partition_id + 1] - probe_offsets[partition_id]);
+      const auto build_size = static_cast<double>(build_offsets[partition_id + 1] - build_offsets[partition_id]);
+
+      const auto build_weight = average_build_size > 0 ? std::max(1.0, build_size / average_build_size) : 1.0;
+      work[partition_id] = probe_size * build_weight;
+      total_work += work[partition_id];
+    }
+
+    const auto average_work = total_work / partition_count;
+    const auto is_skewed = [&](const size_t partition_id) {
+      return work[partition_id] > SKEW_FACTOR * average_work &&
+             probe_offsets[partition_id + 1] - probe_offsets[partition_id] >= 2 * MIN_PROBE_RANGE_SIZE;
+    };
+
+    auto skewed_partition_count = size_t{0};
+    for (size_t partition_id = 0; partition_id < partition_count; ++partition_id) {
+      if (is_skewed(partition_id)) ++skewed_partition_count;
+    }
+    if (skewed_partition_count == 0) return probe_container;
+
+    RadixContainer<RightType> radix_output;
+    radix_output.elements = probe_container.elements;
+
+    for (size_t partition_id = 0; partition_id < partition_count; ++partition_id) {
+      const auto partition_begin = probe_offsets[partition_id];
+      const auto partition_size = probe_offsets[partition_id + 1] - partition_begin;
+
+      auto range_count = size_t{1};
+      if (is_skewed(partition_id)) {
+        range_count = static_cast<size_t>(std::ceil(work[partition_id] / average_work));
+        range_count = std::min(range_count, partition_size / MIN_PROBE_RANGE_SIZE);
+      }
+
+      for (size_t range_id = 0; range_id < range_count; ++range_id) {
+        radix_output.partition_offsets.emplace_back(partition_begin + partition_size * range_id / range_count);
+        radix_output.hashtable_ids.emplace_back(partition_id);
+      }
+    }
+    radix_output.partition_offsets.emplace_back(probe_offsets.back());
+
+    return radix_output;
+  }
+
   /*
   Build all the hash tables for the partitions of Left. We parallelize this process for all partitions of Left
   */
@@ -372,6 +787,10 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         for (size_t partition_offset = partition_left_begin; partition_offset < partition_left_end;
              ++partition_offset) {
           auto& element = partition_left[partition_offset];
+
+          // Skip gaps that remain if partitioning was skipped
+          if (element.row_id.chunk_offset == INVALID_CHUNK_OFFSET) continue;
+
           hashtable->put(element.value, element.row_id);
         }
 
@@ -418,19 +837,22 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
         PosList pos_list_left_local;
         PosList pos_list_right_local;
 
-        if (hashtables[current_partition_id]) {
-          auto& hashtable = hashtables.at(current_partition_id);
+        const auto hashtable_id = _hashtable_id(radix_container, hashtables.size(), current_partition_id);
+
+        if (hashtables[hashtable_id]) {
+          auto& hashtable = hashtables[hashtable_id];
 
           for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
             auto& row = partition[partition_offset];
 
-            if (_mode == JoinMode::Inner && row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
+            // Skip rows that were not materialized (NULL values or rows dropped by the Bloom filter)
+            if (row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) {
               continue;
             }
 
             // This is where the actual comparison happens. `get` only returns values that match and eliminates hash
-            // collisions.
-            auto row_ids = hashtable->get(row.value);
+            // collisions. If unmatched rows of the build relation are needed, matched values are marked.
+            auto row_ids = _build_side_outer ? hashtable->get_and_mark(row.value) : hashtable->get(row.value);
 
             if (row_ids) {
               for (const auto& row_id : *row_ids) {
@@ -439,18 +861,13 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
                   pos_list_right_local.emplace_back(row.row_id);
                 }
               }
-              // We assume that the relations have been swapped previously,
-              // so that the outer relation is the probing relation.
-            } else if (_mode == JoinMode::Left || _mode == JoinMode::Right) {
+            } else if (_probe_side_outer) {
               pos_list_left_local.emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
               pos_list_right_local.emplace_back(row.row_id);
             }
           }
-        } else if (_mode == JoinMode::Left || _mode == JoinMode::Right) {
+        } else if (_probe_side_outer) {
           /*
-          We assume that the relations have been swapped previously,
-          so that the outer relation is the probing relation.
-
           Since we did not find a proper hash table,
           we know that there is no match in Left for this partition.
           Hence we are going to write NULL values for each row.
@@ -458,6 +875,7 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
           for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
             auto& row = partition[partition_offset];
+            if (row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) continue;
             pos_list_left_local.emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
             pos_list_right_local.emplace_back(row.row_id);
           }
@@ -474,6 +892,42 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     CurrentScheduler::wait_for_tasks(jobs);
   }
 
+  /*
+  For outer joins on the build relation: After probing, every value in the hash tables that was not marked has no
+  join partner. Its rows are added to the output with NULL values for the probe relation.
+  */
+  void _add_unmatched_build_rows(const std::vector<std::shared_ptr<HashTable<LeftType>>>& hashtables,
+                                 std::vector<PosList>& pos_lists_left, std::vector<PosList>& pos_lists_right) {
+    PosList pos_list_left;
+    for (const auto& hashtable : hashtables) {
+      if (!hashtable) continue;
+
+      hashtable->for_each_unmarked([&](const PosList& row_ids) {
+        pos_list_left.insert(pos_list_left.end(), row_ids.begin(), row_ids.end());
+      });
+    }
+
+    _add_null_extended_rows(std::move(pos_list_left), true, pos_lists_left, pos_lists_right);
+  }
+
+  /*
+  Adds rows without a join partner, e.g., rows with NULL values in the join column, to the output of an outer join.
+  The columns of the other relation are filled with NULL values.
+  */
+  static void _add_null_extended_rows(PosList&& rows, const bool rows_from_build_side,
+                                      std::vector<PosList>& pos_lists_left, std::vector<PosList>& pos_lists_right) {
+    if (rows.empty()) return;
+
+    auto null_rows = PosList(rows.size(), RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
+    if (rows_from_build_side) {
+      pos_lists_left.emplace_back(std::move(rows));
+      pos_lists_right.emplace_back(std::move(null_rows));
+    } else {
+      pos_lists_left.emplace_back(std::move(null_rows));
+      pos_lists_right.emplace_back(std::move(rows));
+    }
+  }
+
   void _probe_semi_anti(const RadixContainer<RightType>& radix_container,
                         const std::vector<std::shared_ptr<HashTable<LeftType>>>& hashtables,
                         std::vector<PosList>& pos_lists) {
@@ -495,7 +949,9 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
 
         PosList pos_list_local;
 
-        if (auto& hashtable = hashtables[current_partition_id]) {
+        const auto hashtable_id = _hashtable_id(radix_container, hashtables.size(), current_partition_id);
+
+        if (auto& hashtable = hashtables[hashtable_id]) {
           // Valid hashtable found, so there is at least one match in this partition
 
           for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
@@ -517,6 +973,7 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
           // no hashtable on other side, but we are in Anti mode
           for (size_t partition_offset = partition_begin; partition_offset < partition_end; ++partition_offset) {
             auto& row = partition[partition_offset];
+            if (row.row_id.chunk_offset == INVALID_CHUNK_OFFSET) continue;
             pos_list_local.emplace_back(row.row_id);
           }
         }
@@ -531,6 +988,204 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     CurrentScheduler::wait_for_tasks(jobs);
   }
 
+  /*
+  Grace hash join: If the build relation exceeds the memory budget, both relations are partitioned by their join keys
+  into spill files. As matching rows always end up in partitions with the same index, the partition pairs are joined
+  one after another, each using an in-memory hash table. Partitions of the build relation that still exceed the
+  budget, e.g., because of skew, are recursively split up again using a different hash seed.
+  */
+  template <typename T>
+  struct SpilledPartitions {
+    // A file is only created once a row is written to its partition, so that empty partitions do not hold open files
+    std::vector<std::unique_ptr<SpillFile>> files;
+    std::vector<size_t> row_counts;
+  };
+
+  // Each level of recursive partitioning hashes with a different seed. The limits bound the recursion in case of heavy
+  // skew, where a single join key exceeds the memory budget, and the number of open files: While a partition is split
+  // up, the files of the partitions that are not joined yet stay open. The maximum number of partitions is therefore
+  // divided by four on each level, so that at most 2 * (128 + 32 + 8 + 2) = 340 files are open at the same time.
+  static constexpr unsigned int SPILLING_SEED = 31;
+  static constexpr size_t MAX_SPILL_PARTITION_COUNT = 128;
+  static constexpr size_t MAX_SPILL_RECURSION_DEPTH = 3;
+
+  // Without radix partitioning, the probe relation is split into ranges of this size to parallelize probing
+  static constexpr size_t SPILLED_PROBE_RANGE_SIZE = 65'536;
+
+  // Returns the number of spill partitions (a power of two) needed so that each build partition fits into the budget,
+  // limited by the maximum for the recursion level
+  size_t _spill_partition_count(const size_t build_row_count, const size_t level) const {
+    const auto required_partition_count = build_row_count * _bytes_per_build_element / _memory_budget + 1;
+    const auto max_partition_count = std::max(MAX_SPILL_PARTITION_COUNT >> (2 * level), size_t{2});
+
+    auto partition_count = size_t{2};
+    while (partition_count < required_partition_count && partition_count < max_partition_count) {
+      partition_count *= 2;
+    }
+    return partition_count;
+  }
+
+  template <typename T>
+  static SpilledPartitions<T> _create_spilled_partitions(const size_t partition_count) {
+    SpilledPartitions<T> partitions;
+    partitions.files.resize(partition_count);
+    partitions.row_counts.resize(partition_count);
+    return partitions;
+  }
+
+  template <typename T>
+  static void _spill_element(SpilledPartitions<T>& partitions, const size_t level, const RowID& row_id,
+                             const T& value) {
+    const auto partition_id = murmur2<T>(value, SPILLING_SEED + level) & (partitions.files.size() - 1);
+
+    auto& file_ptr = partitions.files[partition_id];
+    if (!file_ptr) file_ptr = std::make_unique<SpillFile>();
+
+    auto& file = *file_ptr;
+    file.write(row_id);
+    file.write(value);
+    ++partitions.row_counts[partition_id];
+  }
+
+  /*
+  Writes the join column of the input relation to spill files, one chunk after another. Like _materialize_input, it
+  uses the index within ReferenceColumns as the RowID, optionally collects the rows with NULL values, and optionally
+  fills or checks a Bloom filter.
+  */
+  template <typename T>
+  SpilledPartitions<T> _spill_input(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
+                                    const size_t partition_count, PosList* null_rows = nullptr,
+                                    BloomFilter* bloom_filter_to_fill = nullptr,
+                                    const BloomFilter* bloom_filter_to_check = nullptr) {
+    auto partitions = _create_spilled_partitions<T>(partition_count);
+
+    for (ChunkID chunk_id{0}; chunk_id < in_table->chunk_count(); ++chunk_id) {
+      const auto column = in_table->get_chunk(chunk_id).get_column(column_id);
+
+      resolve_column_type<T>(*column, [&](auto& typed_column) {
+        auto iterable = create_iterable_from_column<T>(typed_column);
+
+        iterable.for_each([&](const auto& value) {
+          if (value.is_null()) {
+            if (null_rows) null_rows->emplace_back(RowID{chunk_id, value.chunk_offset()});
+            return;
+          }
+
+          if (bloom_filter_to_fill || bloom_filter_to_check) {
+            const auto hash = murmur2<T>(value.value(), _partitioning_seed);
+            if (bloom_filter_to_fill) bloom_filter_to_fill->insert(hash);
+            if (bloom_filter_to_check && !bloom_filter_to_check->contains(hash)) return;
+          }
+
+          _spill_element(partitions, 0, RowID{chunk_id, value.chunk_offset()}, value.value());
+        });
+      });
+    }
+
+    return partitions;
+  }
+
+  // Splits up a spilled partition using the hash seed of the next recursion level. file is null for an empty partition.
+  template <typename T>
+  static SpilledPartitions<T> _repartition(SpillFile* file, const size_t row_count, const size_t partition_count,
+                                           const size_t level) {
+    auto partitions = _create_spilled_partitions<T>(partition_count);
+    if (row_count == 0) return partitions;
+
+    auto row_id = RowID{};
+    auto value = T{};
+
+    file->rewind();
+    for (size_t row = 0; row < row_count; ++row) {
+      file->read(row_id);
+      file->read(value);
+      _spill_element(partitions, level, row_id, value);
+    }
+
+    return partitions;
+  }
+
+  // file is null for an empty partition
+  template <typename T>
+  static std::shared_ptr<Partition<T>> _read_spilled_partition(SpillFile* file, const size_t row_count) {
+    auto elements = std::make_shared<Partition<T>>(row_count);
+    if (row_count == 0) return elements;
+
+    file->rewind();
+    for (auto& element : *elements) {
+      file->read(element.row_id);
+      file->read(element.value);
+    }
+
+    return elements;
+  }
+
+  void _join_spilled_partitions(SpilledPartitions<LeftType>& build_partitions,
+                                SpilledPartitions<RightType>& probe_partitions, const size_t level,
+                                std::vector<PosList>& left_pos_lists, std::vector<PosList>& right_pos_lists) {
+    // Without rows in one of the partitions, only outer joins on the other relation (or anti joins, which keep the
+    // rows of the probe relation) can produce output
+    const auto needs_build_rows = !_probe_side_outer && _mode != JoinMode::Anti;
+    const auto needs_probe_rows = !_build_side_outer;
+
+    for (size_t partition_id = 0; partition_id < build_partitions.files.size(); ++partition_id) {
+      const auto build_row_count = build_partitions.row_counts[partition_id];
+      const auto probe_row_count = probe_partitions.row_counts[partition_id];
+
+      // Release the files of each partition as soon as it is joined
+      auto build_file = std::move(build_partitions.files[partition_id]);
+      auto probe_file = std::move(probe_partitions.files[partition_id]);
+
+      if ((probe_row_count == 0 && needs_probe_rows) || (build_row_count == 0 && needs_build_rows)) continue;
+
+      if (build_row_count * _bytes_per_build_element > _memory_budget && level < MAX_SPILL_RECURSION_DEPTH) {
+        const auto partition_count = _spill_partition_count(build_row_count, level + 1);
+        auto build_sub_partitions =
+            _repartition<LeftType>(build_file.get(), build_row_count, partition_count, level + 1);
+        build_file.reset();
+        auto probe_sub_partitions =
+            _repartition<RightType>(probe_file.get(), probe_row_count, partition_count, level + 1);
+        probe_file.reset();
+
+        _join_spilled_partitions(build_sub_partitions, probe_sub_partitions, level + 1, left_pos_lists,
+                                 right_pos_lists);
+        continue;
+      }
+
+      const auto build_elements = _read_spilled_partition<LeftType>(build_file.get(), build_row_count);
+      build_file.reset();
+      const auto probe_elements = _read_spilled_partition<RightType>(probe_file.get(), probe_row_count);
+      probe_file.reset();
+
+      auto probe_range_offsets = std::vector<size_t>{};
+      for (size_t offset = 0; offset < probe_row_count; offset += SPILLED_PROBE_RANGE_SIZE) {
+        probe_range_offsets.emplace_back(offset);
+      }
+
+      const auto radix_left = _skip_partitioning<LeftType>(build_elements, {}, false);
+      const auto radix_right = _skip_partitioning<RightType>(probe_elements, probe_range_offsets, true);
+
+      auto hashtables = std::vector<std::shared_ptr<HashTable<LeftType>>>(1);
+      _build(radix_left, hashtables);
+
+      auto partition_left_pos_lists = std::vector<PosList>(probe_range_offsets.size());
+      auto partition_right_pos_lists = std::vector<PosList>(probe_range_offsets.size());
+
+      if (_mode == JoinMode::Semi || _mode == JoinMode::Anti) {
+        _probe_semi_anti(radix_right, hashtables, partition_right_pos_lists);
+      } else {
+        _probe(radix_right, hashtables, partition_left_pos_lists, partition_right_pos_lists);
+        if (_build_side_outer) {
+          _add_unmatched_build_rows(hashtables, partition_left_pos_lists, partition_right_pos_lists);
+        }
+      }
+
+      std::move(partition_left_pos_lists.begin(), partition_left_pos_lists.end(), std::back_inserter(left_pos_lists));
+      std::move(partition_right_pos_lists.begin(), partition_right_pos_lists.end(),
+                std::back_inserter(right_pos_lists));
+    }
+  }
+
   /*
   Copy the column meta-data from input to output table.
   */
@@ -563,11 +1218,56 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     }
 
     /*
-     * This flag is used in the materialization and probing phases.
-     * When dealing with an OUTER join, we need to make sure that we keep the NULL values for the outer relation.
-     * In the current implementation, the relation on the right is always the outer relation.
-     */
-    auto keep_nulls = (_mode == JoinMode::Left || _mode == JoinMode::Right);
+    Rows with NULL values in the join column never find a join partner. For the outer relation(s), they are collected
+    while materializing the inputs and added to the output at the end.
+    */
+    PosList left_null_rows;
+    PosList right_null_rows;
+
+    const auto left_key_table = _key_tables.first ? _key_tables.first : _left_in_table;
+    const auto right_key_table = _key_tables.second ? _key_tables.second : _right_in_table;
+
+    /*
+    Semi-join reduction: In inner and semi joins, rows of the probe relation without a join partner do not contribute
+    to the output. A Bloom filter on the join keys of the build relation drops most of them while materializing the
+    probe relation, i.e., before they are partitioned and probed. As the filter works on hash values, it can only be
+    used if both join columns have the same type.
+    */
+    std::unique_ptr<BloomFilter> bloom_filter;
+    if constexpr (std::is_same<LeftType, RightType>{}) {
+      if (_mode == JoinMode::Inner || _mode == JoinMode::Self || _mode == JoinMode::Semi) {
+        bloom_filter = std::make_unique<BloomFilter>(left_key_table->row_count());
+      }
+    }
+
+    /*
+    The spill partitions are assigned based on hash values, so matching keys of different types would end up in
+    different partitions. Joins of columns with different types are always executed in memory.
+    */
+    if constexpr (std::is_same<LeftType, RightType>{}) {
+      if (_build_relation_size > _memory_budget) {
+        PerformanceWarning("JoinHash exceeds its memory budget and spills to disk");
+
+        const auto partition_count = _spill_partition_count(left_key_table->row_count(), 0);
+        auto build_partitions =
+            _spill_input<LeftType>(left_key_table, _column_ids.first, partition_count,
+                                   _build_side_outer ? &left_null_rows : nullptr, bloom_filter.get());
+        auto probe_partitions =
+            _spill_input<RightType>(right_key_table, _column_ids.second, partition_count,
+                                    _probe_side_outer ? &right_null_rows : nullptr, nullptr, bloom_filter.get());
+        bloom_filter.reset();
+
+        std::vector<PosList> left_pos_lists;
+        std::vector<PosList> right_pos_lists;
+        _join_spilled_partitions(build_partitions, probe_partitions, 0, left_pos_lists, right_pos_lists);
+
+        _add_null_extended_rows(std::move(left_null_rows), true, left_pos_lists, right_pos_lists);
+        _add_null_extended_rows(std::move(right_null_rows), false, left_pos_lists, right_pos_lists);
+
+        _write_output(left_pos_lists, right_pos_lists);
+        return _output_table;
+      }
+    }
 
     // Pre-partitioning
     // Save chunk offsets into the input relation
@@ -602,10 +1302,12 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     This helps choosing a scheduler node for the radix phase (see below).
     */
     // Scheduler note: parallelize this at some point. Currently, the amount of jobs would be too high
-    auto materialized_left = _materialize_input<LeftType>(_left_in_table, _column_ids.first, histograms_left);
-    // 'keep_nulls' makes sure that the relation on the right materializes NULL values when executing an OUTER join.
+    auto materialized_left =
+        _materialize_input<LeftType>(left_key_table, _column_ids.first, histograms_left,
+                                     _build_side_outer ? &left_null_rows : nullptr, bloom_filter.get());
     auto materialized_right =
-        _materialize_input<RightType>(_right_in_table, _column_ids.second, histograms_right, keep_nulls);
+        _materialize_input<RightType>(right_key_table, _column_ids.second, histograms_right,
+                                      _probe_side_outer ? &right_null_rows : nullptr, nullptr, bloom_filter.get());
 
     // Radix Partitioning phase
     /*
@@ -617,11 +1319,24 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
     only two radix partitions A and B, the partitions leftA and rightA should be on the same node, and the
     partitions leftB and leftB should also be on the same node.
     */
-    // Scheduler note: parallelize this at some point. Currently, the amount of jobs would be too high
-    auto radix_left = _partition_radix_parallel<LeftType>(materialized_left, left_chunk_offsets, histograms_left);
-    // 'keep_nulls' makes sure that the relation on the right keeps NULL values when executing an OUTER join.
-    auto radix_right =
-        _partition_radix_parallel<RightType>(materialized_right, right_chunk_offsets, histograms_right, keep_nulls);
+    RadixContainer<LeftType> radix_left;
+    RadixContainer<RightType> radix_right;
+
+    if (_radix_bits_first_pass == 0) {
+      radix_left = _skip_partitioning<LeftType>(materialized_left, *left_chunk_offsets, false);
+      radix_right = _skip_partitioning<RightType>(materialized_right, *right_chunk_offsets, true);
+    } else {
+      // Scheduler note: parallelize this at some point. Currently, the amount of jobs would be too high
+      radix_left = _partition_radix_parallel<LeftType>(materialized_left, left_chunk_offsets, histograms_left);
+      radix_right = _partition_radix_parallel<RightType>(materialized_right, right_chunk_offsets, histograms_right);
+
+      if (_radix_bits_second_pass > 0) {
+        radix_left = _refine_partitions(radix_left);
+        radix_right = _refine_partitions(radix_right);
+      }
+
+      radix_right = _split_skewed_partitions(radix_right, radix_left);
+    }
 
     // Build phase
     std::vector<std::shared_ptr<HashTable<LeftType>>> hashtables;
@@ -646,88 +1361,47 @@ class JoinHash::JoinHashImpl : public AbstractJoinOperatorImpl {
       _probe_semi_anti(radix_right, hashtables, right_pos_lists);
     } else {
       _probe(radix_right, hashtables, left_pos_lists, right_pos_lists);
+      if (_build_side_outer) _add_unmatched_build_rows(hashtables, left_pos_lists, right_pos_lists);
     }
 
-    /*
-    Add columns to output chunk.
-    We assume that either all Chunks contain ReferenceColumns or all Chunk contain Value/DictionaryColumns.
-    But we expect that it is not possible to have both ReferenceColumns and Value/DictionaryColumn in one table.
-    */
-    auto ref_col_left =
-        std::dynamic_pointer_cast<const ReferenceColumn>(_left_in_table->get_chunk(ChunkID{0}).get_column(ColumnID{0}))
-            ? true
-            : false;
-    auto ref_col_right =
-        std::dynamic_pointer_cast<const ReferenceColumn>(_right_in_table->get_chunk(ChunkID{0}).get_column(ColumnID{0}))
-            ? true
-            : false;
+    _add_null_extended_rows(std::move(left_null_rows), true, left_pos_lists, right_pos_lists);
+    _add_null_extended_rows(std::move(right_null_rows), false, left_pos_lists, right_pos_lists);
 
-    for (size_t partition_id = 0; partition_id < left_pos_lists.size(); ++partition_id) {
-      auto& left = left_pos_lists[partition_id];
-      auto& right = right_pos_lists[partition_id];
+    _write_output(left_pos_lists, right_pos_lists);
+
+    return _output_table;
+  }
 
-      if (left.empty() && right.empty()) {
+  // Writes an output chunk for each pair of pos lists
+  void _write_output(std::vector<PosList>& left_pos_lists, std::vector<PosList>& right_pos_lists) {
+    auto _right_in_table = _right->get_output();
+    auto _left_in_table = _left->get_output();
+
+    for (size_t partition_id = 0; partition_id < left_pos_lists.size(); ++partition_id) {
+      if (left_pos_lists[partition_id].empty() && right_pos_lists[partition_id].empty()) {
         continue;
       }
 
+      // The pos lists are not needed anymore, so they can be shared by the output columns instead of being copied
+      const auto left = std::make_shared<const PosList>(std::move(left_pos_lists[partition_id]));
+      const auto right = std::make_shared<const PosList>(std::move(right_pos_lists[partition_id]));
+
       Chunk output_chunk;
 
       // we need to swap back the inputs, so that the order of the output columns is not harmed
       if (_inputs_swapped) {
-        write_output_chunks(output_chunk, _right_in_table, right, ref_col_right);
+        _write_output_columns(output_chunk, _right_in_table, right);
 
         // Semi/Anti joins are always swapped but do not need the outer relation
         if (_mode != JoinMode::Semi && _mode != JoinMode::Anti) {
-          write_output_chunks(output_chunk, _left_in_table, left, ref_col_left);
+          _write_output_columns(output_chunk, _left_in_table, left);
         }
       } else {
-        write_output_chunks(output_chunk, _left_in_table, left, ref_col_left);
-        write_output_chunks(output_chunk, _right_in_table, right, ref_col_right);
+        _write_output_columns(output_chunk, _left_in_table, left);
+        _write_output_columns(output_chunk, _right_in_table, right);
       }
       _output_table->emplace_chunk(std::move(output_chunk));
     }
-
-    return _output_table;
-  }
-
-  static void write_output_chunks(Chunk& output_chunk, const std::shared_ptr<const Table> input_table,
-                                  PosList& pos_list, bool is_ref_column) {
-    if (pos_list.empty()) return;
-
-    // Add columns from input table to output chunk
-    for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-      std::shared_ptr<BaseColumn> column;
-
-      if (is_ref_column) {
-        auto ref_col =
-            std::dynamic_pointer_cast<const ReferenceColumn>(input_table->get_chunk(ChunkID{0}).get_column(column_id));
-
-        // Get all the input pos lists so that we only have to pointer cast the columns once
-        auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>();
-        for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); chunk_id++) {
-          // This works because we assume that the columns have to be either all ReferenceColumns or none.
-          auto ref_column =
-              std::dynamic_pointer_cast<const ReferenceColumn>(input_table->get_chunk(chunk_id).get_column(column_id));
-          input_pos_lists.push_back(ref_column->pos_list());
-        }
-
-        // Get the row ids that are referenced
-        auto new_pos_list = std::make_shared<PosList>();
-        for (const auto& row : pos_list) {
-          if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
-            new_pos_list->push_back(row);
-          } else {
-            new_pos_list->push_back(input_pos_lists.at(row.chunk_id)->at(row.chunk_offset));
-          }
-        }
-        column = std::make_shared<ReferenceColumn>(ref_col->referenced_table(), ref_col->referenced_column_id(),
-                                                   new_pos_list);
-      } else {
-        column = std::make_shared<ReferenceColumn>(input_table, column_id, std::make_shared<PosList>(pos_list));
-      }
-
-      output_chunk.add_column(column);
-    }
   }
 };
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -14,27 +15,72 @@ namespace opossum {
 /**
  * This operator joins two tables using one column of each table.
  * The output is a new table with referenced columns for all columns of the two inputs and filtered pos_lists.
- * If you want to filter by multiple criteria, you can chain this operator.
+ * If you want to filter by multiple criteria, you can chain this operator or pass `additional_column_ids`, in which
+ * case the rows are matched on a composite key of all join columns (see AbstractJoinOperator).
  *
  * As with most operators, we do not guarantee a stable operation with regards to positions -
  * i.e., your sorting order might be disturbed.
  *
- * Note: JoinHash does not support null values at the moment
+ * All join modes are supported. For outer joins, either input can become the build relation: while probing, the
+ * hash tables mark the values that found a join partner, so that the unmatched rows of the build relation can be added
+ * to the output afterwards. Rows with NULL values in the join column never find a join partner.
+ *
+ * Joins on dictionary-encoded string columns hash and compare integer keys derived from the ValueIDs instead of the
+ * strings (see _create_value_id_key_tables).
+ *
+ * The number of radix bits, i.e., the fan-out of the partitioning phase, is chosen based on the size of the build
+ * relation and the size of the L2 cache (see calculate_radix_bits). It can be overridden by passing `radix_bits`.
+ * Partitions that hold much more work than average, e.g., because of a dominating join key, are split up and probed by
+ * multiple jobs that share the partition's hash table.
+ *
+ * If the build relation is estimated to exceed the `memory_budget` (in bytes, by default a fraction of the main
+ * memory), JoinHash turns into a Grace hash join: both relations are partitioned into temporary files, which are then
+ * joined pairwise, so that only one partition of the build relation has to be kept in memory at a time.
  *
  * Find more information in our Wiki: https://github.com/hyrise/hyrise/wiki/Radix-Partitioned-and-Hash-Based-Join
  */
 class JoinHash : public AbstractJoinOperator {
  public:
   JoinHash(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
-           const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+           const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+           const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids = {},
+           const std::optional<size_t>& radix_bits = std::nullopt,
+           const std::optional<size_t>& memory_budget = std::nullopt);
 
   const std::string name() const override;
   std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
 
+  // Partitioning a relation with more radix bits than this in a single pass thrashes the TLB. Larger fan-outs are
+  // achieved with two partitioning passes.
+  static constexpr size_t MAX_RADIX_BITS_PER_PASS = 9;
+  static constexpr size_t MAX_RADIX_BITS = 2 * MAX_RADIX_BITS_PER_PASS;
+
+  /**
+   * Returns the number of radix bits needed so that each partition of a build relation of the given size (in bytes,
+   * including its hash table) fits into a cache of the given size. Returns 0 if the build relation fits into the cache
+   * as a whole, in which case partitioning is skipped.
+   */
+  static size_t calculate_radix_bits(const size_t build_relation_size, const size_t cache_size);
+
+  // Fraction of the main memory that a single JoinHash may use for its build relation if no budget is passed
+  static constexpr double DEFAULT_MEMORY_BUDGET_FRACTION = 0.25;
+
+  static size_t default_memory_budget();
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
   void _on_cleanup() override;
 
+  /**
+   * If both join columns are dictionary-encoded string columns, returns tables holding an integer join key per row,
+   * which replace the join columns during the join. The keys are obtained by translating each dictionary once, so
+   * that neither the strings have to be materialized nor hashed. Returns empty pointers otherwise.
+   */
+  std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>> _create_value_id_key_tables() const;
+
+  const std::optional<size_t> _radix_bits;
+  const std::optional<size_t> _memory_budget;
+
   std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
 
   template <typename LeftType, typename RightType>
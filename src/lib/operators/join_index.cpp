@@ -0,0 +1,275 @@
+#include "join_index.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/index/base_index.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "type_comparison.hpp"
+#include "utils/assert.hpp"
+#include "utils/performance_warning.hpp"
+
+namespace opossum {
+
+namespace {
+
+/**
+ * Calls func for the ChunkOffset of every indexed row whose value satisfies `left_value <scan_type> indexed_value`.
+ * As the indexed column is the right operand of the predicate, the ranges are mirrored compared to IndexScan.
+ */
+template <typename Functor>
+void for_each_index_match(const BaseIndex& index, const ScanType scan_type, const std::vector<AllTypeVariant>& values,
+                          const Functor& func) {
+  auto range_begin = BaseIndex::Iterator{};
+  auto range_end = BaseIndex::Iterator{};
+
+  switch (scan_type) {
+    case ScanType::Equals: {
+      range_begin = index.lower_bound(values);
+      range_end = index.upper_bound(values);
+      break;
+    }
+    case ScanType::NotEquals: {
+      // first, get all indexed values less than the left value
+      std::for_each(index.cbegin(), index.lower_bound(values), func);
+
+      // set range for second half to all indexed values greater than the left value
+      range_begin = index.upper_bound(values);
+      range_end = index.cend();
+      break;
+    }
+    case ScanType::LessThan: {
+      range_begin = index.upper_bound(values);
+      range_end = index.cend();
+      break;
+    }
+    case ScanType::LessThanEquals: {
+      range_begin = index.lower_bound(values);
+      range_end = index.cend();
+      break;
+    }
+    case ScanType::GreaterThan: {
+      range_begin = index.cbegin();
+      range_end = index.lower_bound(values);
+      break;
+    }
+    case ScanType::GreaterThanEquals: {
+      range_begin = index.cbegin();
+      range_end = index.upper_bound(values);
+      break;
+    }
+    default:
+      Fail("Unsupported scan type for JoinIndex");
+  }
+
+  std::for_each(range_begin, range_end, func);
+}
+
+}  // namespace
+
+JoinIndex::JoinIndex(const std::shared_ptr<const AbstractOperator> left,
+                     const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
+                     const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
+    : AbstractJoinOperator(left, right, mode, column_ids, scan_type) {
+  Assert(mode == JoinMode::Inner || mode == JoinMode::Left || mode == JoinMode::Semi || mode == JoinMode::Anti,
+         "JoinIndex only supports Inner, Left, Semi, and Anti joins");
+  Assert(scan_type != ScanType::Like && scan_type != ScanType::NotLike && scan_type != ScanType::Between,
+         "JoinIndex does not support this scan type");
+}
+
+const std::string JoinIndex::name() const { return "JoinIndex"; }
+
+std::shared_ptr<AbstractOperator> JoinIndex::recreate(const std::vector<AllParameterVariant>& args) const {
+  return std::make_shared<JoinIndex>(_input_left->recreate(args), _input_right->recreate(args), _mode, _column_ids,
+                                     _scan_type);
+}
+
+std::shared_ptr<const Table> JoinIndex::_on_execute() {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+
+  auto output_table = std::make_shared<Table>();
+
+  const auto is_semi_or_anti = (_mode == JoinMode::Semi || _mode == JoinMode::Anti);
+
+  for (ColumnID column_id{0}; column_id < left_table->column_count(); ++column_id) {
+    output_table->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id),
+                                        left_table->column_is_nullable(column_id));
+  }
+
+  // Semi and Anti joins only return the rows of the left input
+  if (!is_semi_or_anti) {
+    for (ColumnID column_id{0}; column_id < right_table->column_count(); ++column_id) {
+      const auto nullable = (_mode == JoinMode::Left || right_table->column_is_nullable(column_id));
+      output_table->add_column_definition(right_table->column_name(column_id), right_table->column_type(column_id),
+                                          nullable);
+    }
+  }
+
+  /**
+   * Look up the index of every right chunk once. The indices are only used if the lookup values do not need to be
+   * cast and if the indexed column cannot contain NULLs, which the indices do not support.
+   */
+  auto right_indices = std::vector<std::shared_ptr<BaseIndex>>(right_table->chunk_count());
+
+  const auto indices_usable = left_table->column_type(_column_ids.first) ==
+                                  right_table->column_type(_column_ids.second) &&
+                              !right_table->column_is_nullable(_column_ids.second);
+
+  auto all_chunks_indexed = indices_usable;
+  if (indices_usable) {
+    for (ChunkID chunk_id{0}; chunk_id < right_table->chunk_count(); ++chunk_id) {
+      const auto indices = right_table->get_chunk(chunk_id).get_indices(std::vector<ColumnID>{_column_ids.second});
+      if (indices.empty()) {
+        all_chunks_indexed = false;
+      } else {
+        right_indices[chunk_id] = indices.front();
+      }
+    }
+  }
+
+  if (!all_chunks_indexed) {
+    PerformanceWarning("JoinIndex falls back to a nested loop for chunks without a usable index");
+  }
+
+  // Join each chunk of the left input in its own job, producing one output chunk
+  auto pos_lists_left = std::vector<std::shared_ptr<PosList>>(left_table->chunk_count());
+  auto pos_lists_right = std::vector<std::shared_ptr<PosList>>(left_table->chunk_count());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(left_table->chunk_count());
+
+  for (ChunkID chunk_id_left{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
+    pos_lists_left[chunk_id_left] = std::make_shared<PosList>();
+    pos_lists_right[chunk_id_left] = std::make_shared<PosList>();
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id_left]() {
+      _join_chunk(chunk_id_left, right_indices, *pos_lists_left[chunk_id_left], *pos_lists_right[chunk_id_left]);
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  for (ChunkID chunk_id_left{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
+    if (pos_lists_left[chunk_id_left]->empty()) continue;
+
+    auto output_chunk = Chunk{};
+    _write_output_columns(output_chunk, left_table, pos_lists_left[chunk_id_left]);
+    if (!is_semi_or_anti) {
+      _write_output_columns(output_chunk, right_table, pos_lists_right[chunk_id_left]);
+    }
+    output_table->emplace_chunk(std::move(output_chunk));
+  }
+
+  return output_table;
+}
+
+void JoinIndex::_join_chunk(const ChunkID chunk_id_left, const std::vector<std::shared_ptr<BaseIndex>>& right_indices,
+                            PosList& pos_list_left, PosList& pos_list_right) const {
+  const auto left_table = _input_table_left();
+  const auto right_table = _input_table_right();
+
+  const auto left_column = left_table->get_chunk(chunk_id_left).get_column(_column_ids.first);
+  const auto left_data_type = left_table->column_type(_column_ids.first);
+  const auto right_data_type = right_table->column_type(_column_ids.second);
+
+  // Semi and Anti joins only need to know whether a left row has a partner, all other modes need every pair
+  const auto emit_pairs = (_mode == JoinMode::Inner || _mode == JoinMode::Left);
+  auto left_matches = std::vector<bool>(left_column->size());
+
+  // As in JoinHash, left rows with a NULL key are not part of the output of an Anti join
+  auto left_nulls = std::vector<bool>(_mode == JoinMode::Anti ? left_column->size() : 0);
+
+  resolve_data_and_column_type(left_data_type, *left_column, [&](auto left_type, auto& typed_left_column) {
+    using LeftType = typename decltype(left_type)::type;
+
+    auto iterable_left = create_iterable_from_column<LeftType>(typed_left_column);
+
+    if (_mode == JoinMode::Anti) {
+      iterable_left.for_each([&](const auto& left_value) {
+        if (left_value.is_null()) left_nulls[left_value.chunk_offset()] = true;
+      });
+    }
+
+    // The indices are probed with one value at a time, which is written into this vector instead of a new one per row
+    auto index_values = std::vector<AllTypeVariant>(1);
+
+    for (ChunkID chunk_id_right{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
+      const auto add_match = [&](const ChunkOffset left_chunk_offset, const ChunkOffset right_chunk_offset) {
+        left_matches[left_chunk_offset] = true;
+
+        if (emit_pairs) {
+          pos_list_left.emplace_back(RowID{chunk_id_left, left_chunk_offset});
+          pos_list_right.emplace_back(RowID{chunk_id_right, right_chunk_offset});
+        }
+      };
+
+      const auto& index = right_indices[chunk_id_right];
+
+      if (index) {
+        iterable_left.for_each([&](const auto& left_value) {
+          if (left_value.is_null()) return;
+
+          const auto left_chunk_offset = left_value.chunk_offset();
+          if (!emit_pairs && left_matches[left_chunk_offset]) return;
+
+          index_values[0] = left_value.value();
+          for_each_index_match(*index, _scan_type, index_values, [&](const ChunkOffset right_chunk_offset) {
+            add_match(left_chunk_offset, right_chunk_offset);
+          });
+        });
+        continue;
+      }
+
+      const auto right_column = right_table->get_chunk(chunk_id_right).get_column(_column_ids.second);
+
+      resolve_data_and_column_type(right_data_type, *right_column, [&](auto right_type, auto& typed_right_column) {
+        using RightType = typename decltype(right_type)::type;
+
+        // make sure that we do not compile invalid versions of these lambdas
+        constexpr auto left_is_string_column = (std::is_same<LeftType, std::string>{});
+        constexpr auto right_is_string_column = (std::is_same<RightType, std::string>{});
+
+        // clang-format off
+        if constexpr (left_is_string_column == right_is_string_column) {
+          auto iterable_right = create_iterable_from_column<RightType>(typed_right_column);
+
+          with_comparator(_scan_type, [&](auto comparator) {
+            iterable_left.for_each([&](const auto& left_value) {
+              if (left_value.is_null()) return;
+
+              iterable_right.for_each([&](const auto& right_value) {
+                if (right_value.is_null()) return;
+
+                if (comparator(left_value.value(), right_value.value())) {
+                  add_match(left_value.chunk_offset(), right_value.chunk_offset());
+                }
+              });
+            });
+          });
+        }
+        // clang-format on
+      });
+    }
+  });
+
+  for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+    if (_mode == JoinMode::Left && !left_matches[chunk_offset]) {
+      pos_list_left.emplace_back(RowID{chunk_id_left, chunk_offset});
+      pos_list_right.emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
+    } else if ((_mode == JoinMode::Semi && left_matches[chunk_offset]) ||
+               (_mode == JoinMode::Anti && !left_matches[chunk_offset] && !left_nulls[chunk_offset])) {
+      pos_list_left.emplace_back(RowID{chunk_id_left, chunk_offset});
+    }
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "abstract_join_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseIndex;
+
+/**
+ * This is an index nested loop join. For every value of the left input, it looks up the matching rows in the indices
+ * of the right input's chunks (GroupKeyIndex, CompositeGroupKeyIndex, or AdaptiveRadixTreeIndex) instead of building
+ * a hash table or sorting both inputs. This pays off if the left input is small and the right input is a large, indexed
+ * table, because only the matching rows of the right input are ever touched.
+ *
+ * Supported are the join modes Inner, Left, Semi, and Anti (i.e., all modes that are driven by the left input) and
+ * all scan types except for Between, Like, and NotLike.
+ *
+ * Chunks of the right input without an index on the join column, e.g., because the right input is a reference table,
+ * are joined using a nested loop. The same is done if the join columns differ in their types (the index lookup would
+ * cast the left values to the type of the right column) or if the right join column is nullable.
+ */
+class JoinIndex : public AbstractJoinOperator {
+ public:
+  JoinIndex(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
+            const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+
+  const std::string name() const override;
+  std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Joins one chunk of the left input with all chunks of the right input
+  void _join_chunk(const ChunkID chunk_id_left, const std::vector<std::shared_ptr<BaseIndex>>& right_indices,
+                   PosList& pos_list_left, PosList& pos_list_right) const;
+};
+
+}  // namespace opossum
@@ -1,14 +1,17 @@
 #include "join_nested_loop.hpp"
 
-#include <map>
+#include <algorithm>
 #include <memory>
-#include <numeric>
-#include <set>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/iterables/create_iterable_from_column.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
@@ -16,23 +19,68 @@
 
 namespace opossum {
 
+namespace {
+
+// A non-NULL value of the join column, decoded once so that it can be compared in tight loops
+template <typename T>
+struct DecodedValue {
+  ChunkOffset chunk_offset;
+  T value;
+};
+
+template <typename T>
+using DecodedChunk = std::vector<DecodedValue<T>>;
+
+// Decodes the join column of every chunk in parallel. For ReferenceColumns, the offsets within the column are used.
+template <typename T>
+std::vector<DecodedChunk<T>> decode_chunks(const Table& table, const ColumnID column_id) {
+  auto decoded_chunks = std::vector<DecodedChunk<T>>(table.chunk_count());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(table.chunk_count());
+
+  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto column = table.get_chunk(chunk_id).get_column(column_id);
+      auto& decoded_chunk = decoded_chunks[chunk_id];
+      decoded_chunk.reserve(column->size());
+
+      resolve_column_type<T>(*column, [&](auto& typed_column) {
+        auto iterable = create_iterable_from_column<T>(typed_column);
+        iterable.for_each([&](const auto& value) {
+          if (value.is_null()) return;
+          decoded_chunk.emplace_back(DecodedValue<T>{value.chunk_offset(), value.value()});
+        });
+      });
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  return decoded_chunks;
+}
+
+}  // namespace
+
 /*
- * This is a Nested Loop Join implementation completely based on iterables.
+ * This is a Nested Loop Join implementation based on decoded join columns.
  * It supports all current join and scan types, as well as NULL values.
- * Because this is a Nested Loop Join, the performance is going to be far inferior to JoinHash and JoinSortMerge,
- * so only use this for testing or benchmarking purposes.
+ * Because this is a Nested Loop Join, the performance is going to be far inferior to JoinHash and JoinSortMerge for
+ * equi joins. It is parallelized over the pairs of input chunks, so that it is still usable for non-equi joins.
  */
 
 JoinNestedLoop::JoinNestedLoop(const std::shared_ptr<const AbstractOperator> left,
                                const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                               const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type)
-    : AbstractJoinOperator(left, right, mode, column_ids, scan_type) {}
+                               const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                               const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids)
+    : AbstractJoinOperator(left, right, mode, column_ids, scan_type, additional_column_ids) {}
 
 const std::string JoinNestedLoop::name() const { return "JoinNestedLoop"; }
 
 std::shared_ptr<AbstractOperator> JoinNestedLoop::recreate(const std::vector<AllParameterVariant>& args) const {
   return std::make_shared<JoinNestedLoop>(_input_left->recreate(args), _input_right->recreate(args), _mode, _column_ids,
-                                          _scan_type);
+                                          _scan_type, _additional_column_ids);
 }
 
 std::shared_ptr<const Table> JoinNestedLoop::_on_execute() {
@@ -54,6 +102,16 @@ void JoinNestedLoop::_create_table_structure() {
   _left_column_id = _column_ids.first;
   _right_column_id = _column_ids.second;
 
+  _left_key_table = _left_in_table;
+  _right_key_table = _right_in_table;
+
+  // Composite-key join: compare the encoded keys, the output still references the input tables
+  if (!_additional_column_ids.empty()) {
+    std::tie(_left_key_table, _right_key_table) = _create_composite_key_tables();
+    _left_column_id = ColumnID{0};
+    _right_column_id = ColumnID{0};
+  }
+
   const bool left_may_produce_null = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
   const bool right_may_produce_null = (_mode == JoinMode::Left || _mode == JoinMode::Outer);
 
@@ -72,39 +130,13 @@ void JoinNestedLoop::_create_table_structure() {
   }
 }
 
-// inner join loop that joins two columns via their iterators
-template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-void JoinNestedLoop::_join_two_columns(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                                       RightIterator right_begin, RightIterator right_end, const ChunkID chunk_id_left,
-                                       const ChunkID chunk_id_right, std::vector<bool>& left_matches) {
-  for (; left_it != left_end; ++left_it) {
-    const auto left_value = *left_it;
-    if (left_value.is_null()) continue;
-
-    for (auto right_it = right_begin; right_it != right_end; ++right_it) {
-      const auto right_value = *right_it;
-      if (right_value.is_null()) continue;
-
-      if (func(left_value.value(), right_value.value())) {
-        _pos_list_left->emplace_back(RowID{chunk_id_left, left_value.chunk_offset()});
-        _pos_list_right->emplace_back(RowID{chunk_id_right, right_value.chunk_offset()});
-
-        if (_is_outer_join) {
-          left_matches[left_value.chunk_offset()] = true;
-        }
-
-        if (_mode == JoinMode::Outer) {
-          _right_matches.insert(RowID{chunk_id_right, right_value.chunk_offset()});
-        }
-      }
-    }
-  }
-}
-
 void JoinNestedLoop::_perform_join() {
   auto left_table = _left_in_table;
   auto right_table = _right_in_table;
 
+  auto left_key_table = _left_key_table;
+  auto right_key_table = _right_key_table;
+
   auto left_column_id = _left_column_id;
   auto right_column_id = _right_column_id;
 
@@ -113,145 +145,198 @@ void JoinNestedLoop::_perform_join() {
     left_table = _right_in_table;
     right_table = _left_in_table;
 
+    left_key_table = _right_key_table;
+    right_key_table = _left_key_table;
+
     left_column_id = _right_column_id;
     right_column_id = _left_column_id;
   }
 
-  auto left_data_type = left_table->column_type(left_column_id);
-  auto right_data_type = right_table->column_type(right_column_id);
+  auto left_data_type = left_key_table->column_type(left_column_id);
+  auto right_data_type = right_key_table->column_type(right_column_id);
 
-  _pos_list_left = std::make_shared<PosList>();
-  _pos_list_right = std::make_shared<PosList>();
+  auto pos_list_left = std::make_shared<PosList>();
+  auto pos_list_right = std::make_shared<PosList>();
 
   _is_outer_join = (_mode == JoinMode::Left || _mode == JoinMode::Right || _mode == JoinMode::Outer);
 
-  // Scan all chunks from left input
-  for (ChunkID chunk_id_left = ChunkID{0}; chunk_id_left < left_table->chunk_count(); ++chunk_id_left) {
-    auto column_left = left_table->get_chunk(chunk_id_left).get_column(left_column_id);
+  resolve_data_type(left_data_type, [&](auto left_type) {
+    resolve_data_type(right_data_type, [&](auto right_type) {
+      using LeftType = typename decltype(left_type)::type;
+      using RightType = typename decltype(right_type)::type;
 
-    // for Outer joins, remember matches on the left side
+      // make sure that we do not compile invalid versions of these lambdas
+      constexpr auto left_is_string_column = (std::is_same<LeftType, std::string>{});
+      constexpr auto right_is_string_column = (std::is_same<RightType, std::string>{});
+
+      if constexpr (left_is_string_column == right_is_string_column) {
+        _join_columns<LeftType, RightType>(*left_key_table, left_column_id, *right_key_table, right_column_id,
+                                           *pos_list_left, *pos_list_right);
+      }
+    });
+  });
+
+  // write output chunks
+  auto output_chunk = Chunk();
+
+  if (_mode == JoinMode::Right) {
+    _write_output_columns(output_chunk, right_table, pos_list_right);
+    _write_output_columns(output_chunk, left_table, pos_list_left);
+  } else {
+    _write_output_columns(output_chunk, left_table, pos_list_left);
+    _write_output_columns(output_chunk, right_table, pos_list_right);
+  }
+
+  _output_table->emplace_chunk(std::move(output_chunk));
+}
+
+template <typename LeftType, typename RightType>
+void JoinNestedLoop::_join_columns(const Table& left_key_table, const ColumnID left_column_id,
+                                   const Table& right_key_table, const ColumnID right_column_id,
+                                   PosList& pos_list_left, PosList& pos_list_right) const {
+  const auto left_chunks = decode_chunks<LeftType>(left_key_table, left_column_id);
+  const auto right_chunks = decode_chunks<RightType>(right_key_table, right_column_id);
+
+  const auto track_right_matches = (_mode == JoinMode::Outer);
+
+  /*
+  Split the matrix of chunk pairs into jobs. Each job joins one chunk of the left input with a range of chunks of the
+  right input and writes its matches to its own PosLists, so that no synchronization is needed.
+  */
+  struct Job {
+    ChunkID chunk_id_left;
+    ChunkID chunk_id_right_begin;
+    ChunkID chunk_id_right_end;
+
+    PosList pos_list_left;
+    PosList pos_list_right;
+
+    // for Outer joins, the matched rows of the left chunk and (for Full Outer) of the right chunks
     std::vector<bool> left_matches;
+    std::vector<std::vector<bool>> right_matches;
+  };
 
-    if (_is_outer_join) {
-      left_matches.resize(column_left->size());
-    }
+  auto jobs = std::vector<Job>{};
+  for (ChunkID chunk_id_left{0}; chunk_id_left < left_chunks.size(); ++chunk_id_left) {
+    auto chunk_id_right_begin = ChunkID{0};
+    auto comparison_count = size_t{0};
 
-    // Scan all chunks for right input
-    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
-      auto column_right = right_table->get_chunk(chunk_id_right).get_column(right_column_id);
-
-      resolve_data_and_column_type(left_data_type, *column_left, [&](auto left_type, auto& typed_left_column) {
-        resolve_data_and_column_type(right_data_type, *column_right, [&](auto right_type, auto& typed_right_column) {
-          using LeftType = typename decltype(left_type)::type;
-          using RightType = typename decltype(right_type)::type;
-
-          // make sure that we do not compile invalid versions of these lambdas
-          constexpr auto left_is_string_column = (std::is_same<LeftType, std::string>{});
-          constexpr auto right_is_string_column = (std::is_same<RightType, std::string>{});
-
-          constexpr auto neither_is_string_column = !left_is_string_column && !right_is_string_column;
-          constexpr auto both_are_string_columns = left_is_string_column && right_is_string_column;
-
-          // clang-format off
-          if constexpr (neither_is_string_column || both_are_string_columns) {
-            auto iterable_left = create_iterable_from_column<LeftType>(typed_left_column);
-            auto iterable_right = create_iterable_from_column<RightType>(typed_right_column);
-
-            iterable_left.with_iterators([&](auto left_it, auto left_end) {
-              iterable_right.with_iterators([&](auto right_it, auto right_end) {
-                with_comparator(_scan_type, [&](auto comparator) {
-                  this->_join_two_columns(comparator, left_it, left_end, right_it, right_end, chunk_id_left,
-                                          chunk_id_right, left_matches);
-                });
-              });
-            });
-          }
-          // clang-format on
-        });
-      });
-    }
+    for (ChunkID chunk_id_right{0}; chunk_id_right < right_chunks.size(); ++chunk_id_right) {
+      comparison_count += left_chunks[chunk_id_left].size() * right_chunks[chunk_id_right].size();
 
-    if (_is_outer_join) {
-      // add unmatched rows on the left for Left and Full Outer joins
-      for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
-        if (!left_matches[chunk_offset]) {
-          _pos_list_left->emplace_back(RowID{chunk_id_left, chunk_offset});
-          _pos_list_right->emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
-        }
+      if (comparison_count >= MIN_COMPARISONS_PER_JOB || chunk_id_right + 1 == right_chunks.size()) {
+        jobs.emplace_back(Job{chunk_id_left, chunk_id_right_begin, ChunkID{chunk_id_right + 1u}, {}, {}, {}, {}});
+        chunk_id_right_begin = ChunkID{chunk_id_right + 1u};
+        comparison_count = 0;
       }
     }
   }
 
-  // For Full Outer we need to add all unmatched rows for the right side.
-  // Unmatched rows on the left side are already added in the main loop above
-  if (_mode == JoinMode::Outer) {
-    for (ChunkID chunk_id_right = ChunkID{0}; chunk_id_right < right_table->chunk_count(); ++chunk_id_right) {
-      auto column_right = right_table->get_chunk(chunk_id_right).get_column(right_column_id);
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  tasks.reserve(jobs.size());
+
+  for (auto& job : jobs) {
+    tasks.emplace_back(std::make_shared<JobTask>([&]() {
+      const auto& left_values = left_chunks[job.chunk_id_left];
+
+      if (_is_outer_join) {
+        job.left_matches.resize(left_key_table.get_chunk(job.chunk_id_left).size());
+      }
+
+      for (auto chunk_id_right = job.chunk_id_right_begin; chunk_id_right < job.chunk_id_right_end; ++chunk_id_right) {
+        const auto& right_values = right_chunks[chunk_id_right];
 
-      resolve_data_and_column_type(right_data_type, *column_right, [&](auto right_type, auto& typed_right_column) {
-        using RightType = typename decltype(right_type)::type;
+        auto* right_matches = static_cast<std::vector<bool>*>(nullptr);
+        if (track_right_matches) {
+          job.right_matches.emplace_back(right_key_table.get_chunk(chunk_id_right).size());
+          right_matches = &job.right_matches.back();
+        }
+
+        with_comparator(_scan_type, [&](auto comparator) {
+          // Block nested loop: compare blocks of both inputs that fit into the cache with each other
+          for (size_t left_block_begin = 0; left_block_begin < left_values.size(); left_block_begin += BLOCK_SIZE) {
+            const auto left_block_end = std::min(left_block_begin + BLOCK_SIZE, left_values.size());
+
+            for (size_t right_block_begin = 0; right_block_begin < right_values.size();
+                 right_block_begin += BLOCK_SIZE) {
+              const auto right_block_end = std::min(right_block_begin + BLOCK_SIZE, right_values.size());
+
+              for (auto left_index = left_block_begin; left_index < left_block_end; ++left_index) {
+                const auto& left_value = left_values[left_index];
+
+                for (auto right_index = right_block_begin; right_index < right_block_end; ++right_index) {
+                  const auto& right_value = right_values[right_index];
+                  if (!comparator(left_value.value, right_value.value)) continue;
 
-        auto iterable_right = create_iterable_from_column<RightType>(typed_right_column);
+                  job.pos_list_left.emplace_back(RowID{job.chunk_id_left, left_value.chunk_offset});
+                  job.pos_list_right.emplace_back(RowID{chunk_id_right, right_value.chunk_offset});
 
-        iterable_right.for_each([&](const auto& right_value) {
-          const auto row_id = RowID{chunk_id_right, right_value.chunk_offset()};
-          if (!_right_matches.count(row_id)) {
-            _pos_list_left->emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
-            _pos_list_right->emplace_back(row_id);
+                  if (_is_outer_join) job.left_matches[left_value.chunk_offset] = true;
+                  if (right_matches) (*right_matches)[right_value.chunk_offset] = true;
+                }
+              }
+            }
           }
         });
-      });
-    }
+      }
+    }));
+    tasks.back()->schedule();
   }
 
-  // write output chunks
-  auto output_chunk = Chunk();
+  CurrentScheduler::wait_for_tasks(tasks);
 
-  if (_mode == JoinMode::Right) {
-    _write_output_chunks(output_chunk, right_table, _pos_list_right);
-    _write_output_chunks(output_chunk, left_table, _pos_list_left);
-  } else {
-    _write_output_chunks(output_chunk, left_table, _pos_list_left);
-    _write_output_chunks(output_chunk, right_table, _pos_list_right);
+  // Merge the results of the jobs, which are ordered by the left chunk
+  auto right_matches = std::vector<std::vector<bool>>(track_right_matches ? right_chunks.size() : 0);
+  for (ChunkID chunk_id_right{0}; chunk_id_right < right_matches.size(); ++chunk_id_right) {
+    right_matches[chunk_id_right].resize(right_key_table.get_chunk(chunk_id_right).size());
   }
 
-  _output_table->emplace_chunk(std::move(output_chunk));
-}
+  auto left_matches = std::vector<bool>{};
 
-void JoinNestedLoop::_write_output_chunks(Chunk& output_chunk, const std::shared_ptr<const Table> input_table,
-                                          std::shared_ptr<PosList> pos_list) {
-  // Add columns from table to output chunk
-  for (ColumnID column_id{0}; column_id < input_table->column_count(); ++column_id) {
-    std::shared_ptr<BaseColumn> column;
+  for (size_t job_id = 0; job_id < jobs.size(); ++job_id) {
+    auto& job = jobs[job_id];
 
-    if (auto reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(
-            input_table->get_chunk(ChunkID{0}).get_column(column_id))) {
-      auto new_pos_list = std::make_shared<PosList>();
+    pos_list_left.insert(pos_list_left.end(), job.pos_list_left.begin(), job.pos_list_left.end());
+    pos_list_right.insert(pos_list_right.end(), job.pos_list_right.begin(), job.pos_list_right.end());
 
-      ChunkID current_chunk_id{0};
+    for (size_t range_index = 0; range_index < job.right_matches.size(); ++range_index) {
+      auto& matches = right_matches[job.chunk_id_right_begin + range_index];
+      for (ChunkOffset chunk_offset{0}; chunk_offset < matches.size(); ++chunk_offset) {
+        if (job.right_matches[range_index][chunk_offset]) matches[chunk_offset] = true;
+      }
+    }
 
-      // de-reference to the correct RowID so the output can be used in a Multi Join
-      for (const auto row : *pos_list) {
-        if (row.chunk_id != current_chunk_id) {
-          current_chunk_id = row.chunk_id;
+    if (!_is_outer_join) continue;
 
-          reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(
-              input_table->get_chunk(current_chunk_id).get_column(column_id));
-        }
-        if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
-          new_pos_list->push_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
-        } else {
-          new_pos_list->push_back(reference_column->pos_list()->at(row.chunk_offset));
-        }
+    if (left_matches.empty()) {
+      left_matches = std::move(job.left_matches);
+    } else {
+      for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+        if (job.left_matches[chunk_offset]) left_matches[chunk_offset] = true;
       }
+    }
 
-      column = std::make_shared<ReferenceColumn>(reference_column->referenced_table(),
-                                                 reference_column->referenced_column_id(), new_pos_list);
-    } else {
-      column = std::make_shared<ReferenceColumn>(input_table, column_id, pos_list);
+    // add unmatched rows on the left for Left and Full Outer joins once all jobs of the left chunk are merged
+    if (job_id + 1 == jobs.size() || jobs[job_id + 1].chunk_id_left != job.chunk_id_left) {
+      for (ChunkOffset chunk_offset{0}; chunk_offset < left_matches.size(); ++chunk_offset) {
+        if (!left_matches[chunk_offset]) {
+          pos_list_left.emplace_back(RowID{job.chunk_id_left, chunk_offset});
+          pos_list_right.emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
+        }
+      }
+      left_matches.clear();
     }
+  }
 
-    output_chunk.add_column(column);
+  // For Full Outer we need to add all unmatched rows for the right side.
+  // Unmatched rows on the left side are already added above
+  for (ChunkID chunk_id_right{0}; chunk_id_right < right_matches.size(); ++chunk_id_right) {
+    for (ChunkOffset chunk_offset{0}; chunk_offset < right_matches[chunk_id_right].size(); ++chunk_offset) {
+      if (!right_matches[chunk_id_right][chunk_offset]) {
+        pos_list_left.emplace_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
+        pos_list_right.emplace_back(RowID{chunk_id_right, chunk_offset});
+      }
+    }
   }
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 
 #include <memory>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -15,7 +14,8 @@ class JoinNestedLoop : public AbstractJoinOperator {
  public:
   JoinNestedLoop(const std::shared_ptr<const AbstractOperator> left,
                  const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                 const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type);
+                 const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                 const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids = {});
 
   const std::string name() const override;
   std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
@@ -23,30 +23,31 @@ class JoinNestedLoop : public AbstractJoinOperator {
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
+  // Values compared block-wise, so that a block of each input stays in the L1 cache
+  static constexpr size_t BLOCK_SIZE = 1'024;
+
+  // Chunk pairs are grouped into jobs of at least this many comparisons to limit the scheduling overhead
+  static constexpr size_t MIN_COMPARISONS_PER_JOB = 1'000'000;
+
   void _perform_join();
 
-  template <typename BinaryFunctor, typename LeftIterator, typename RightIterator>
-  void _join_two_columns(const BinaryFunctor& func, LeftIterator left_it, LeftIterator left_end,
-                         RightIterator right_begin, RightIterator right_end, const ChunkID chunk_id_left,
-                         const ChunkID chunk_id_right, std::vector<bool>& left_matches);
+  // Joins all pairs of chunks in parallel and writes the matching (and, for outer joins, unmatched) rows
+  template <typename LeftType, typename RightType>
+  void _join_columns(const Table& left_key_table, const ColumnID left_column_id, const Table& right_key_table,
+                     const ColumnID right_column_id, PosList& pos_list_left, PosList& pos_list_right) const;
 
   void _create_table_structure();
 
-  void _write_output_chunks(Chunk& output_chunk, const std::shared_ptr<const Table> input_table,
-                            std::shared_ptr<PosList> pos_list);
-
   std::shared_ptr<Table> _output_table;
   std::shared_ptr<const Table> _left_in_table;
   std::shared_ptr<const Table> _right_in_table;
+  // the tables holding the join columns, i.e., the input tables or the encoded keys of a composite-key join
+  std::shared_ptr<const Table> _left_key_table;
+  std::shared_ptr<const Table> _right_key_table;
   ColumnID _left_column_id;
   ColumnID _right_column_id;
 
   bool _is_outer_join;
-  std::shared_ptr<PosList> _pos_list_left;
-  std::shared_ptr<PosList> _pos_list_right;
-
-  // for Full Outer, remember the matches on the right side
-  std::set<RowID> _right_matches;
 };
 
 }  // namespace opossum
@@ -36,8 +36,9 @@ namespace opossum {
 **/
 JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator> left,
                              const std::shared_ptr<const AbstractOperator> right, const JoinMode mode,
-                             const std::pair<ColumnID, ColumnID>& column_ids, const ScanType op)
-    : AbstractJoinOperator(left, right, mode, column_ids, op) {
+                             const std::pair<ColumnID, ColumnID>& column_ids, const ScanType op,
+                             const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids)
+    : AbstractJoinOperator(left, right, mode, column_ids, op, additional_column_ids) {
   // Validate the parameters
   DebugAssert(mode != JoinMode::Cross, "This operator does not support cross joins.");
   DebugAssert(left != nullptr, "The left input operator is null.");
@@ -52,18 +53,27 @@ JoinSortMerge::JoinSortMerge(const std::shared_ptr<const AbstractOperator> left,
 
 std::shared_ptr<AbstractOperator> JoinSortMerge::recreate(const std::vector<AllParameterVariant>& args) const {
   return std::make_shared<JoinSortMerge>(_input_left->recreate(args), _input_right->recreate(args), _mode, _column_ids,
-                                         _scan_type);
+                                         _scan_type, _additional_column_ids);
 }
 
 std::shared_ptr<const Table> JoinSortMerge::_on_execute() {
+  auto join_tables = std::make_pair(_input_table_left(), _input_table_right());
+  auto join_column_ids = _column_ids;
+
+  // Composite-key join: sort and merge the encoded keys, the output still references the input tables
+  if (!_additional_column_ids.empty()) {
+    join_tables = _create_composite_key_tables();
+    join_column_ids = std::make_pair(ColumnID{0}, ColumnID{0});
+  }
+
   // Check column types
-  const auto& left_column_type = _input_table_left()->column_type(_column_ids.first);
-  DebugAssert(left_column_type == _input_table_right()->column_type(_column_ids.second),
+  const auto& left_column_type = join_tables.first->column_type(join_column_ids.first);
+  DebugAssert(left_column_type == join_tables.second->column_type(join_column_ids.second),
               "Left and right column types do not match. The sort merge join requires matching column types");
 
   // Create implementation to compute the join result
   _impl = make_unique_by_data_type<AbstractJoinOperatorImpl, JoinSortMergeImpl>(
-      left_column_type, *this, _column_ids.first, _column_ids.second, _scan_type, _mode);
+      left_column_type, *this, join_tables, join_column_ids, _scan_type, _mode);
 
   return _impl->_on_execute();
 }
@@ -78,11 +88,13 @@ const std::string JoinSortMerge::name() const { return "JoinSortMerge"; }
 template <typename T>
 class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
  public:
-  JoinSortMergeImpl<T>(JoinSortMerge& sort_merge_join, ColumnID left_column_id, ColumnID right_column_id,
-                       const ScanType op, JoinMode mode)
+  JoinSortMergeImpl<T>(JoinSortMerge& sort_merge_join,
+                       const std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>>& join_tables,
+                       const std::pair<ColumnID, ColumnID>& column_ids, const ScanType op, JoinMode mode)
       : _sort_merge_join{sort_merge_join},
-        _left_column_id{left_column_id},
-        _right_column_id{right_column_id},
+        _join_tables{join_tables},
+        _left_column_id{column_ids.first},
+        _right_column_id{column_ids.second},
         _op{op},
         _mode{mode} {
     _cluster_count = _determine_number_of_clusters();
@@ -93,6 +105,10 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
  protected:
   JoinSortMerge& _sort_merge_join;
 
+  // The tables holding the join columns. These are the input tables or, for composite-key joins, the tables holding
+  // the encoded keys. Both have the same chunk layout, so the output can reference the input tables in either case.
+  const std::pair<std::shared_ptr<const Table>, std::shared_ptr<const Table>> _join_tables;
+
   // Contains the materialized sorted input tables
   std::unique_ptr<MaterializedColumnList<T>> _sorted_left_table;
   std::unique_ptr<MaterializedColumnList<T>> _sorted_right_table;
@@ -575,53 +591,13 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
                            std::shared_ptr<const PosList> pos_list) {
     auto column_count = input_table->column_count();
     for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
-      // Add the column definition
       auto column_name = input_table->column_name(column_id);
       auto column_type = input_table->column_type(column_id);
       output_table->add_column_definition(column_name, column_type);
-
-      // Add the column data (in the form of a poslist)
-      // Check whether the referenced column is already a reference column
-      const auto base_column = input_table->get_chunk(ChunkID{0}).get_column(column_id);
-      const auto ref_column = std::dynamic_pointer_cast<const ReferenceColumn>(base_column);
-      if (ref_column) {
-        // Create a pos_list referencing the original column instead of the reference column
-        auto new_pos_list = _dereference_pos_list(input_table, column_id, pos_list);
-        auto new_ref_column = std::make_shared<ReferenceColumn>(ref_column->referenced_table(),
-                                                                ref_column->referenced_column_id(), new_pos_list);
-        output_table->get_chunk(ChunkID{0}).add_column(new_ref_column);
-      } else {
-        auto new_ref_column = std::make_shared<ReferenceColumn>(input_table, column_id, pos_list);
-        output_table->get_chunk(ChunkID{0}).add_column(new_ref_column);
-      }
-    }
-  }
-
-  /**
-  * Turns a pos list that is pointing to reference column entries into a pos list pointing to the original table.
-  * This is done because there should not be any reference columns referencing reference columns.
-  **/
-  std::shared_ptr<PosList> _dereference_pos_list(std::shared_ptr<const Table> input_table, ColumnID column_id,
-                                                 std::shared_ptr<const PosList> pos_list) {
-    // Get all the input pos lists so that we only have to pointer cast the columns once
-    auto input_pos_lists = std::vector<std::shared_ptr<const PosList>>();
-    for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
-      auto b_column = input_table->get_chunk(chunk_id).get_column(column_id);
-      auto r_column = std::dynamic_pointer_cast<const ReferenceColumn>(b_column);
-      input_pos_lists.push_back(r_column->pos_list());
-    }
-
-    // Get the row ids that are referenced
-    auto new_pos_list = std::make_shared<PosList>();
-    for (const auto& row : *pos_list) {
-      if (row.chunk_offset == INVALID_CHUNK_OFFSET) {
-        new_pos_list->push_back(RowID{ChunkID{0}, INVALID_CHUNK_OFFSET});
-      } else {
-        new_pos_list->push_back((*input_pos_lists[row.chunk_id])[row.chunk_offset]);
-      }
     }
 
-    return new_pos_list;
+    // Add the column data (in the form of a shared poslist)
+    _write_output_columns(output_table->get_chunk(ChunkID{0}), input_table, pos_list);
   }
 
  public:
@@ -631,9 +607,10 @@ class JoinSortMerge::JoinSortMergeImpl : public AbstractJoinOperatorImpl {
   std::shared_ptr<const Table> _on_execute() {
     bool include_null_left = (_mode == JoinMode::Left || _mode == JoinMode::Outer);
     bool include_null_right = (_mode == JoinMode::Right || _mode == JoinMode::Outer);
-    auto radix_clusterer = RadixClusterSort<T>(
-        _sort_merge_join._input_table_left(), _sort_merge_join._input_table_right(), _sort_merge_join._column_ids,
-        _op == ScanType::Equals, include_null_left, include_null_right, _cluster_count);
+    auto radix_clusterer = RadixClusterSort<T>(_join_tables.first, _join_tables.second,
+                                               std::make_pair(_left_column_id, _right_column_id),
+                                               _op == ScanType::Equals, include_null_left, include_null_right,
+                                               _cluster_count);
     // Sort and cluster the input tables
     auto sort_output = radix_clusterer.execute();
     _sorted_left_table = std::move(sort_output.clusters_left);
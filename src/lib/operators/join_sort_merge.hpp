@@ -20,11 +20,13 @@ namespace opossum {
    * Note: SortMergeJoin does not support null values in the input at the moment.
    * Note: Cross joins are not supported. Use the product operator instead.
    * Note: Outer joins are only implemented for the equi-join case, i.e. the "=" operator.
+   * Note: Joins on additional pairs of columns (composite keys) are only supported for the equi-join case.
 **/
 class JoinSortMerge : public AbstractJoinOperator {
  public:
   JoinSortMerge(const std::shared_ptr<const AbstractOperator> left, const std::shared_ptr<const AbstractOperator> right,
-                const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType op);
+                const JoinMode mode, const std::pair<ColumnID, ColumnID>& column_ids, const ScanType op,
+                const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids = {});
 
   std::shared_ptr<const Table> _on_execute() override;
   void _on_cleanup() override;
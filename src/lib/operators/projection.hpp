@@ -3,7 +3,6 @@
 #include <cstdint>
 
 #include <algorithm>
-#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -22,7 +21,7 @@ namespace opossum {
 /**
  * Operator to select a subset of the set of all columns found in the table
  *
- * Note: Projection does not support null values at the moment
+ * Arithmetic expressions are evaluated batch by batch by an ExpressionBatchEvaluator.
  */
 class Projection : public AbstractReadOnlyOperator {
  public:
@@ -55,36 +54,30 @@ class Projection : public AbstractReadOnlyOperator {
 
   static std::shared_ptr<Table> dummy_table();
 
- protected:
-  ColumnExpressions _column_expressions;
+  // The type of the column that an expression computes on the table, DataType::Null for a NULL literal
+  static DataType get_type_of_expression(const std::shared_ptr<Expression>& expression,
+                                         const std::shared_ptr<const Table>& table);
 
-  template <typename T>
-  static void _create_column(boost::hana::basic_type<T> type, Chunk& chunk, const ChunkID chunk_id,
-                             const std::shared_ptr<Expression>& expression,
-                             std::shared_ptr<const Table> input_table_left);
-
-  static DataType _get_type_of_expression(const std::shared_ptr<Expression>& expression,
-                                          const std::shared_ptr<const Table>& table);
+  // The name of the column that an expression computes on the table, as it appears in the output of a Projection
+  static std::string get_name_of_expression(const std::shared_ptr<Expression>& expression,
+                                            const std::shared_ptr<const Table>& table);
 
   /**
-   * This function evaluates the given expression on a single chunk.
-   * It returns a vector containing the materialized values resulting from the expression.
+   * Evaluates an expression on a single chunk of the table and returns the resulting column. Column references are
+   * passed through without copying. This allows other operators, e.g., Aggregate, to compute their inputs chunk by
+   * chunk instead of having a Projection materialize them all.
    */
-  template <typename T>
-  static const pmr_concurrent_vector<std::optional<T>> _evaluate_expression(
-      const std::shared_ptr<Expression>& expression, const std::shared_ptr<const Table> table, const ChunkID chunk_id);
+  static std::shared_ptr<BaseColumn> evaluate_expression_on_chunk(const std::shared_ptr<Expression>& expression,
+                                                                  const std::shared_ptr<const Table>& table,
+                                                                  const ChunkID chunk_id);
 
-  /**
-   * Operators that all numerical types support.
-   */
-  template <typename T>
-  static std::function<T(const T&, const T&)> _get_base_operator_function(ExpressionType type);
+ protected:
+  ColumnExpressions _column_expressions;
 
-  /**
-   * Operators that integral types support.
-   */
   template <typename T>
-  static std::function<T(const T&, const T&)> _get_operator_function(ExpressionType type);
+  static void _create_column(boost::hana::basic_type<T> type, Chunk& chunk, const ChunkID chunk_id,
+                             const std::shared_ptr<Expression>& expression,
+                             std::shared_ptr<const Table> input_table_left);
 
   std::shared_ptr<const Table> _on_execute() override;
 };
@@ -0,0 +1,353 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "import_export/binary.hpp"
+#include "optimizer/expression.hpp"
+#include "resolve_type.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "storage/table.hpp"
+#include "storage/value_column.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Evaluates an arithmetic expression, in which all literals and columns have the type T, on a chunk of a table.
+ *
+ * Instead of computing one row after another, each operator is applied to a batch of rows at once in a tight loop
+ * over plain arrays, which the compiler turns into SIMD instructions. The columns that the expression references are
+ * materialized once into such arrays, and each operator owns a buffer for the results of a batch. Batches are small
+ * enough for these buffers to stay in the cache.
+ *
+ * Literals are not materialized. An operator with a literal operand applies the literal to each row of the other
+ * operand, and an operator on two literals is evaluated before the first batch. NULLs are tracked in byte masks, which
+ * are only created for columns that contain NULLs. An operator ORs the masks of its operands. With a NULL literal as
+ * an operand, all of its results are NULL.
+ */
+template <typename T>
+class ExpressionBatchEvaluator {
+ public:
+  // Rows per batch
+  static constexpr size_t BATCH_SIZE = 1'024;
+
+  ExpressionBatchEvaluator(const std::shared_ptr<Expression>& expression, const std::shared_ptr<const Table>& table,
+                           const ChunkID chunk_id);
+
+  // Evaluates the expression on all rows of the chunk. The column is nullable, regardless of the expression.
+  std::shared_ptr<ValueColumn<T>> evaluate();
+
+ protected:
+  /**
+   * An expression of the tree. The nodes are stored in post-order, so that the operands of an operator are evaluated
+   * before the operator.
+   *
+   * values and null_values hold a single value for a constant, the values of all rows of the chunk for a column, and
+   * the results of the current batch for an operator. null_values is empty if none of them is NULL.
+   */
+  struct Node {
+    enum class Kind { Constant, Column, Operator };
+
+    Kind kind;
+    ExpressionType type = ExpressionType::Literal;
+    size_t left_node_idx = 0;
+    size_t right_node_idx = 0;
+
+    std::vector<T> values;
+    std::vector<BoolAsByteType> null_values;
+  };
+
+  // The values of a node for the current batch. values and null_values point to a single value for a constant.
+  struct Operand {
+    const T* values;
+    const BoolAsByteType* null_values;
+    bool is_constant;
+  };
+
+  // Adds the node of an expression after the nodes of its operands and returns its index
+  size_t _add_node(const std::shared_ptr<Expression>& expression);
+
+  void _materialize_column(Node& node, const ColumnID column_id) const;
+
+  Operand _operand(const size_t node_idx, const size_t batch_begin) const;
+
+  // Computes the results of an operator for the rows [batch_begin, batch_begin + batch_size) into the given arrays,
+  // which are its own buffers or the output. Returns whether any result is NULL.
+  bool _evaluate_operator(const Node& node, const size_t batch_begin, const size_t batch_size, T* values,
+                          BoolAsByteType* null_values) const;
+
+  static T _apply_to_constants(const ExpressionType type, const T& left, const T& right);
+
+  template <typename Functor>
+  static void _apply(const Operand& left, const Operand& right, const size_t size, T* values, const Functor& functor);
+
+  template <typename Functor>
+  static void _apply_operator(const ExpressionType type, const Functor& functor);
+
+  const std::shared_ptr<const Table> _table;
+  const ChunkID _chunk_id;
+  const size_t _row_count;
+
+  std::vector<Node> _nodes;
+};
+
+template <typename T>
+ExpressionBatchEvaluator<T>::ExpressionBatchEvaluator(const std::shared_ptr<Expression>& expression,
+                                                      const std::shared_ptr<const Table>& table,
+                                                      const ChunkID chunk_id)
+    : _table(table), _chunk_id(chunk_id), _row_count(table->get_chunk(chunk_id).size()) {
+  _add_node(expression);
+}
+
+template <typename T>
+std::shared_ptr<ValueColumn<T>> ExpressionBatchEvaluator<T>::evaluate() {
+  auto values = pmr_concurrent_vector<T>(_row_count);
+  auto null_values = pmr_concurrent_vector<bool>(_row_count);
+
+  const auto& root = _nodes.back();
+
+  if (root.kind != Node::Kind::Operator) {
+    // A constant is broadcast to all rows, a column is copied
+    for (auto row_idx = size_t{0}; row_idx < _row_count; ++row_idx) {
+      const auto operand = _operand(_nodes.size() - 1, row_idx);
+      values[row_idx] = operand.values[0];
+      null_values[row_idx] = operand.null_values && operand.null_values[0];
+    }
+    return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+  }
+
+  // The results of the root are written into a buffer of its own, as pmr_concurrent_vector is not contiguous
+  auto batch_values = std::vector<T>(BATCH_SIZE);
+  auto batch_null_values = std::vector<BoolAsByteType>(BATCH_SIZE);
+
+  for (auto batch_begin = size_t{0}; batch_begin < _row_count; batch_begin += BATCH_SIZE) {
+    const auto batch_size = std::min(BATCH_SIZE, _row_count - batch_begin);
+
+    for (auto& node : _nodes) {
+      if (&node == &root || node.kind != Node::Kind::Operator) continue;
+
+      // An empty mask marks that no result of the batch is NULL. Clearing it keeps its memory for the next batch.
+      node.null_values.resize(BATCH_SIZE);
+      const auto has_nulls =
+          _evaluate_operator(node, batch_begin, batch_size, node.values.data(), node.null_values.data());
+      if (!has_nulls) node.null_values.clear();
+    }
+
+    const auto has_nulls =
+        _evaluate_operator(root, batch_begin, batch_size, batch_values.data(), batch_null_values.data());
+
+    std::move(batch_values.begin(), batch_values.begin() + batch_size, values.begin() + batch_begin);
+    if (has_nulls) {
+      std::copy(batch_null_values.cbegin(), batch_null_values.cbegin() + batch_size,
+                null_values.begin() + batch_begin);
+    }
+  }
+
+  return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+}
+
+template <typename T>
+size_t ExpressionBatchEvaluator<T>::_add_node(const std::shared_ptr<Expression>& expression) {
+  auto node = Node{};
+
+  if (expression->type() == ExpressionType::Literal) {
+    node.kind = Node::Kind::Constant;
+    if (expression->is_null_literal()) {
+      node.values.emplace_back();
+      node.null_values.emplace_back(true);
+    } else {
+      node.values.emplace_back(boost::get<T>(expression->value()));
+    }
+  } else if (expression->type() == ExpressionType::Column) {
+    node.kind = Node::Kind::Column;
+    _materialize_column(node, expression->column_id());
+  } else {
+    Assert(expression->is_arithmetic_operator(), "Projection only supports literals, column refs and arithmetics");
+
+    const auto left_node_idx = _add_node(expression->left_child());
+    const auto right_node_idx = _add_node(expression->right_child());
+    const auto& left = _nodes[left_node_idx];
+    const auto& right = _nodes[right_node_idx];
+
+    if (left.kind == Node::Kind::Constant && right.kind == Node::Kind::Constant) {
+      // Both operands are known before the first batch, so the operator is replaced by its result
+      node.kind = Node::Kind::Constant;
+      if (!left.null_values.empty() || !right.null_values.empty()) {
+        node.values.emplace_back();
+        node.null_values.emplace_back(true);
+      } else {
+        node.values.emplace_back(_apply_to_constants(expression->type(), left.values[0], right.values[0]));
+      }
+      _nodes.resize(std::min(left_node_idx, right_node_idx));
+    } else {
+      node.kind = Node::Kind::Operator;
+      node.type = expression->type();
+      node.left_node_idx = left_node_idx;
+      node.right_node_idx = right_node_idx;
+      node.values.resize(BATCH_SIZE);
+
+      // Fails early for operators that the type does not support
+      _apply_operator(node.type, [](const auto&) {});
+    }
+  }
+
+  _nodes.emplace_back(std::move(node));
+  return _nodes.size() - 1;
+}
+
+template <typename T>
+void ExpressionBatchEvaluator<T>::_materialize_column(Node& node, const ColumnID column_id) const {
+  node.values.resize(_row_count);
+
+  auto has_nulls = false;
+  auto null_values = std::vector<BoolAsByteType>(_row_count);
+
+  const auto& column = *_table->get_chunk(_chunk_id).get_column(column_id);
+  resolve_column_type<T>(column, [&](const auto& typed_column) {
+    auto iterable = create_iterable_from_column<T>(typed_column);
+    iterable.for_each([&](const auto& value) {
+      if (value.is_null()) {
+        null_values[value.chunk_offset()] = true;
+        has_nulls = true;
+      } else {
+        node.values[value.chunk_offset()] = value.value();
+      }
+    });
+  });
+
+  if (has_nulls) node.null_values = std::move(null_values);
+}
+
+template <typename T>
+typename ExpressionBatchEvaluator<T>::Operand ExpressionBatchEvaluator<T>::_operand(const size_t node_idx,
+                                                                                  const size_t batch_begin) const {
+  const auto& node = _nodes[node_idx];
+  const auto* null_values = node.null_values.empty() ? nullptr : node.null_values.data();
+
+  switch (node.kind) {
+    case Node::Kind::Constant:
+      return {node.values.data(), null_values, true};
+    case Node::Kind::Column:
+      return {node.values.data() + batch_begin, null_values ? null_values + batch_begin : nullptr, false};
+    case Node::Kind::Operator:
+      return {node.values.data(), null_values, false};
+  }
+  Fail("Unknown node kind");
+  return {};
+}
+
+template <typename T>
+bool ExpressionBatchEvaluator<T>::_evaluate_operator(const Node& node, const size_t batch_begin,
+                                                     const size_t batch_size, T* values,
+                                                     BoolAsByteType* null_values) const {
+  const auto left = _operand(node.left_node_idx, batch_begin);
+  const auto right = _operand(node.right_node_idx, batch_begin);
+
+  // A NULL literal makes all results NULL
+  if ((left.is_constant && left.null_values) || (right.is_constant && right.null_values)) {
+    std::fill(values, values + batch_size, T{});
+    std::fill(null_values, null_values + batch_size, true);
+    return true;
+  }
+
+  // NULL rows have the value zero, by which integers must not be divided. Their results are NULL anyway.
+  auto divides_by_nulls = false;
+  if constexpr (std::is_integral<T>::value) {
+    divides_by_nulls = right.null_values &&
+                       (node.type == ExpressionType::Division || node.type == ExpressionType::Modulo);
+  }
+
+  if (divides_by_nulls) {
+    _apply_operator(node.type, [&](const auto& functor) {
+      _apply(left, right, batch_size, values, [&](const T& left_value, const T& right_value) {
+        return right_value == T{0} ? T{0} : functor(left_value, right_value);
+      });
+    });
+  } else {
+    _apply_operator(node.type, [&](const auto& functor) { _apply(left, right, batch_size, values, functor); });
+  }
+
+  if (!left.null_values && !right.null_values) return false;
+
+  // The results of the rows that are NULL in either operand are NULL. Constants are never NULL here.
+  const auto* left_null_values = left.is_constant ? nullptr : left.null_values;
+  const auto* right_null_values = right.is_constant ? nullptr : right.null_values;
+
+  if (left_null_values && right_null_values) {
+    for (auto row_idx = size_t{0}; row_idx < batch_size; ++row_idx) {
+      null_values[row_idx] = left_null_values[row_idx] | right_null_values[row_idx];
+    }
+  } else {
+    const auto* operand_null_values = left_null_values ? left_null_values : right_null_values;
+    std::copy(operand_null_values, operand_null_values + batch_size, null_values);
+  }
+  return true;
+}
+
+template <typename T>
+T ExpressionBatchEvaluator<T>::_apply_to_constants(const ExpressionType type, const T& left, const T& right) {
+  auto result = T{};
+  _apply_operator(type, [&](const auto& functor) { result = functor(left, right); });
+  return result;
+}
+
+template <typename T>
+template <typename Functor>
+void ExpressionBatchEvaluator<T>::_apply(const Operand& left, const Operand& right, const size_t size, T* values,
+                                         const Functor& functor) {
+  // Separate loops for constant operands let the compiler keep the constant in a register
+  if (left.is_constant) {
+    const auto left_value = left.values[0];
+    for (auto row_idx = size_t{0}; row_idx < size; ++row_idx) {
+      values[row_idx] = functor(left_value, right.values[row_idx]);
+    }
+  } else if (right.is_constant) {
+    const auto right_value = right.values[0];
+    for (auto row_idx = size_t{0}; row_idx < size; ++row_idx) {
+      values[row_idx] = functor(left.values[row_idx], right_value);
+    }
+  } else {
+    for (auto row_idx = size_t{0}; row_idx < size; ++row_idx) {
+      values[row_idx] = functor(left.values[row_idx], right.values[row_idx]);
+    }
+  }
+}
+
+template <typename T>
+template <typename Functor>
+void ExpressionBatchEvaluator<T>::_apply_operator(const ExpressionType type, const Functor& functor) {
+  if constexpr (std::is_same<T, std::string>::value) {
+    Assert(type == ExpressionType::Addition, "Arithmetic operator except for addition not defined for std::string");
+    functor(std::plus<T>());
+  } else {
+    switch (type) {
+      case ExpressionType::Addition:
+        return functor(std::plus<T>());
+      case ExpressionType::Subtraction:
+        return functor(std::minus<T>());
+      case ExpressionType::Multiplication:
+        return functor(std::multiplies<T>());
+      case ExpressionType::Division:
+        return functor(std::divides<T>());
+      case ExpressionType::Modulo:
+        // Modulo on floating point numbers isn't defined
+        if constexpr (std::is_integral<T>::value) {
+          return functor(std::modulus<T>());
+        }
+        Fail("Modulo is only defined for integral types");
+        return;
+
+      default:
+        Fail("Unknown arithmetic operator");
+    }
+  }
+}
+
+}  // namespace opossum
@@ -1,56 +1,231 @@
 #include "sort.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "import_export/binary.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_scheduler.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
+#include "sort/parallel_merge_sort.hpp"
 #include "storage/base_attribute_vector.hpp"
-#include "storage/column_visitable.hpp"
-#include "storage/iterables/chunk_offset_mapping.hpp"
-#include "storage/iterables/dictionary_column_iterable.hpp"
-#include "storage/iterables/value_column_iterable.hpp"
+#include "storage/dictionary_column.hpp"
 #include "storage/reference_column.hpp"
 #include "storage/value_column.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+#include "utils/physical_memory.hpp"
+#include "utils/spill_file.hpp"
 
 namespace opossum {
 
+namespace {
+
+// Smaller inputs are sorted in fewer runs, as the jobs would cost more than they save
+constexpr auto MIN_RUN_SIZE = size_t{10'000};
+
+// A value or dictionary column from which values are gathered
+template <typename T>
+struct GatherSource {
+  const ValueColumn<T>* value_column = nullptr;
+  const DictionaryColumn<T>* dictionary_column = nullptr;
+
+  // Returns true if the value at chunk_offset is NULL and writes it to value otherwise
+  bool get(const ChunkOffset chunk_offset, T& value) const {
+    if (value_column) {
+      if (value_column->is_nullable() && value_column->null_values()[chunk_offset]) return true;
+      value = value_column->values()[chunk_offset];
+      return false;
+    }
+
+    const auto value_id = dictionary_column->attribute_vector()->get(chunk_offset);
+    if (value_id == NULL_VALUE_ID) return true;
+    value = (*dictionary_column->dictionary())[value_id];
+    return false;
+  }
+};
+
+// Gathers the values of a column at RowIDs into ValueColumns. ReferenceColumns are resolved to the value and
+// dictionary columns they reference, once for each chunk.
+template <typename T>
+class ColumnGatherer {
+ public:
+  ColumnGatherer(const Table& table, const ColumnID column_id)
+      : _sources(table.chunk_count()), _pos_lists(table.chunk_count()), _referenced_sources(table.chunk_count()) {
+    for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& column = *table.get_chunk(chunk_id).get_column(column_id);
+
+      if (const auto* reference_column = dynamic_cast<const ReferenceColumn*>(&column)) {
+        _pos_lists[chunk_id] = reference_column->pos_list().get();
+
+        const auto& referenced_table = *reference_column->referenced_table();
+        const auto referenced_column_id = reference_column->referenced_column_id();
+        auto& referenced_sources = _sources_by_referenced_column[{&referenced_table, referenced_column_id}];
+        if (referenced_sources.empty()) {
+          for (ChunkID referenced_chunk_id{0}; referenced_chunk_id < referenced_table.chunk_count();
+               ++referenced_chunk_id) {
+            referenced_sources.emplace_back(
+                _resolve_source(*referenced_table.get_chunk(referenced_chunk_id).get_column(referenced_column_id)));
+          }
+        }
+        _referenced_sources[chunk_id] = &referenced_sources;
+      } else {
+        _sources[chunk_id] = _resolve_source(column);
+      }
+    }
+  }
+
+  std::shared_ptr<BaseColumn> gather(const RowID* begin, const RowID* end, const bool nullable) const {
+    const auto row_count = static_cast<size_t>(std::distance(begin, end));
+    auto values = pmr_concurrent_vector<T>(row_count);
+    auto null_values = pmr_concurrent_vector<bool>(nullable ? row_count : 0);
+
+    for (auto row_idx = size_t{0}; row_idx < row_count; ++row_idx) {
+      const auto& row_id = begin[row_idx];
+
+      const auto* source = &_sources[row_id.chunk_id];
+      auto chunk_offset = row_id.chunk_offset;
+      if (const auto* pos_list = _pos_lists[row_id.chunk_id]) {
+        const auto& referenced_row_id = (*pos_list)[row_id.chunk_offset];
+        if (referenced_row_id == NULL_ROW_ID) {
+          DebugAssert(nullable, "NULL in a column that is not nullable");
+          null_values[row_idx] = true;
+          continue;
+        }
+        source = &(*_referenced_sources[row_id.chunk_id])[referenced_row_id.chunk_id];
+        chunk_offset = referenced_row_id.chunk_offset;
+      }
+
+      if (source->get(chunk_offset, values[row_idx])) {
+        DebugAssert(nullable, "NULL in a column that is not nullable");
+        null_values[row_idx] = true;
+      }
+    }
+
+    if (nullable) return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+    return std::make_shared<ValueColumn<T>>(std::move(values));
+  }
+
+ private:
+  static GatherSource<T> _resolve_source(const BaseColumn& column) {
+    auto source = GatherSource<T>{};
+    source.value_column = dynamic_cast<const ValueColumn<T>*>(&column);
+    source.dictionary_column = dynamic_cast<const DictionaryColumn<T>*>(&column);
+    Assert(source.value_column || source.dictionary_column, "Expected a value or dictionary column");
+    return source;
+  }
+
+  // For each chunk of the table, either its column or the position list of its ReferenceColumn and the columns of
+  // the referenced table
+  std::vector<GatherSource<T>> _sources;
+  std::vector<const PosList*> _pos_lists;
+  std::vector<const std::vector<GatherSource<T>>*> _referenced_sources;
+
+  // std::map does not move its elements, so that the pointers in _referenced_sources stay valid
+  std::map<std::pair<const Table*, ColumnID>, std::vector<GatherSource<T>>> _sources_by_referenced_column;
+};
+
+// A run is spilled in blocks of rows. During the merge, the current block of each run is held in memory.
+constexpr auto SPILL_BLOCK_SIZE = size_t{4'096};
+
+// The number of runs is limited to bound the number of open files, see Sort::_sort_spilled()
+constexpr auto MAX_SPILL_RUN_COUNT = size_t{256};
+
+// Writes a gathered column of a block in the layout of ExportBinary's value columns: the NULL values as bytes (if the
+// column is nullable), followed by the values. Strings are prefixed with their length.
+template <typename T>
+void write_spilled_column(const ValueColumn<T>& column, SpillFile& file) {
+  if (column.is_nullable()) {
+    for (const auto is_null : column.null_values()) {
+      file.write(static_cast<BoolAsByteType>(is_null));
+    }
+  }
+  for (const auto& value : column.values()) {
+    file.write(value);
+  }
+}
+
+// Reads the next row_count values written by write_spilled_column()
+template <typename T>
+std::shared_ptr<ValueColumn<T>> read_spilled_column(SpillFile& file, const size_t row_count, const bool nullable) {
+  auto null_values = pmr_concurrent_vector<bool>(nullable ? row_count : 0);
+  for (auto row_idx = size_t{0}; row_idx < null_values.size(); ++row_idx) {
+    auto is_null = BoolAsByteType{0};
+    file.read(is_null);
+    null_values[row_idx] = is_null;
+  }
+
+  auto values = pmr_concurrent_vector<T>(row_count);
+  for (auto& value : values) {
+    file.read(value);
+  }
+
+  if (nullable) return std::make_shared<ValueColumn<T>>(std::move(values), std::move(null_values));
+  return std::make_shared<ValueColumn<T>>(std::move(values));
+}
+
+// A sorted run in a spill file and its current block, from which the merge takes one row after another
+struct SpilledRun {
+  std::unique_ptr<SpillFile> file;
+  size_t remaining_row_count = 0;
+
+  size_t block_row_count = 0;
+  size_t row_idx = 0;
+  std::vector<uint8_t> keys;
+  std::vector<std::shared_ptr<BaseColumn>> columns;
+};
+
+}  // namespace
+
 Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id, const OrderByMode order_by_mode,
            const size_t output_chunk_size)
+    : Sort(in, std::vector<SortColumnDefinition>{{column_id, order_by_mode}}, output_chunk_size) {}
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t output_chunk_size, const std::optional<size_t>& memory_budget)
     : AbstractReadOnlyOperator(in),
-      _column_id(column_id),
-      _order_by_mode(order_by_mode),
-      _output_chunk_size(output_chunk_size) {}
+      _sort_definitions(sort_definitions),
+      _output_chunk_size(output_chunk_size),
+      _memory_budget(memory_budget) {
+  Assert(!_sort_definitions.empty(), "Expected at least one column to sort by");
+}
 
-ColumnID Sort::column_id() const { return _column_id; }
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
 
-OrderByMode Sort::order_by_mode() const { return _order_by_mode; }
+ColumnID Sort::column_id() const { return _sort_definitions.front().column_id; }
+
+OrderByMode Sort::order_by_mode() const { return _sort_definitions.front().order_by_mode; }
 
 const std::string Sort::name() const { return "Sort"; }
 
 std::shared_ptr<AbstractOperator> Sort::recreate(const std::vector<AllParameterVariant>& args) const {
-  return std::make_shared<Sort>(_input_left->recreate(args), _column_id, _order_by_mode, _output_chunk_size);
+  return std::make_shared<Sort>(_input_left->recreate(args), _sort_definitions, _output_chunk_size, _memory_budget);
 }
 
-std::shared_ptr<const Table> Sort::_on_execute() {
-  _impl = make_unique_by_data_type<AbstractReadOnlyOperatorImpl, SortImpl>(_input_table_left()->column_type(_column_id),
-                                                                           _input_table_left(), _column_id,
-                                                                           _order_by_mode, _output_chunk_size);
-  return _impl->_on_execute();
+size_t Sort::default_memory_budget() {
+  return static_cast<size_t>(DEFAULT_MEMORY_BUDGET_FRACTION * physical_memory_size());
 }
 
-void Sort::_on_cleanup() { _impl.reset(); }
-
-// This class fulfills only the materialization task for a sorted row_id_value_vector.
-template <typename SortColumnType>
+// This class fulfills only the materialization task for the sorted RowIDs.
 class Sort::SortImplMaterializeOutput {
  public:
-  // creates a new table with reference columns
-  SortImplMaterializeOutput(std::shared_ptr<const Table> in,
-                            std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> id_value_map,
+  // creates a new table with value columns
+  SortImplMaterializeOutput(std::shared_ptr<const Table> in, const std::vector<RowID>& sorted_row_ids,
                             const size_t output_chunk_size)
-      : _table_in(in), _output_chunk_size(output_chunk_size), _row_id_value_vector(id_value_map) {}
+      : _table_in(in), _output_chunk_size(output_chunk_size), _sorted_row_ids(sorted_row_ids) {}
 
   std::shared_ptr<const Table> execute() {
     // First we create a new table as the output
@@ -58,57 +233,47 @@ class Sort::SortImplMaterializeOutput {
 
     // We have decided against duplicating MVCC columns in https://github.com/hyrise/hyrise/issues/408
 
-    // After we created the output table and initialized the column structure, we can start adding values. Because the
-    // values are not ordered by input chunks anymore, we can't process them chunk by chunk. Instead the values are
-    // copied column by column for each output row. For each column in a row we visit the input column with a reference
-    // to the output column. This enables for the SortImplMaterializeOutput class to ignore the column types during the
-    // copying of the values.
-    ChunkID chunk_count_out;
-    size_t output_row_count = _row_id_value_vector->size();
-    if (_output_chunk_size) {
-      chunk_count_out = output_row_count % _output_chunk_size ? (output_row_count / _output_chunk_size) + 1
-                                                              : output_row_count / _output_chunk_size;
-    } else {
-      chunk_count_out = 1;
-      _output_chunk_size = output_row_count;
+    // Without an output chunk size, all rows are written into a single chunk
+    const auto output_row_count = _sorted_row_ids.size();
+    const auto output_chunk_size = _output_chunk_size ? _output_chunk_size : std::max(output_row_count, size_t{1});
+    const auto chunk_count_out = _output_chunk_size ? (output_row_count + output_chunk_size - 1) / output_chunk_size
+                                                    : size_t{1};
+
+    // The values are not ordered by input chunks anymore, so they are gathered column by column for each output chunk.
+    // The type of a column and its input columns are resolved only once, by a ColumnGatherer that is shared by the jobs
+    // that fill the output chunks.
+    auto output_columns = std::vector<std::vector<std::shared_ptr<BaseColumn>>>(
+        chunk_count_out, std::vector<std::shared_ptr<BaseColumn>>(output->column_count()));
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(chunk_count_out * output->column_count());
+
+    for (ColumnID column_id{0}; column_id < output->column_count(); ++column_id) {
+      const auto nullable = _table_in->column_is_nullable(column_id);
+
+      resolve_data_type(_table_in->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        const auto gatherer = std::make_shared<ColumnGatherer<ColumnDataType>>(*_table_in, column_id);
+
+        for (auto chunk_id_out = size_t{0}; chunk_id_out < chunk_count_out; ++chunk_id_out) {
+          const auto begin = std::min(chunk_id_out * output_chunk_size, output_row_count);
+          const auto end = std::min(begin + output_chunk_size, output_row_count);
+
+          jobs.emplace_back(std::make_shared<JobTask>([&, gatherer, column_id, nullable, chunk_id_out, begin, end]() {
+            output_columns[chunk_id_out][column_id] =
+                gatherer->gather(_sorted_row_ids.data() + begin, _sorted_row_ids.data() + end, nullable);
+          }));
+          jobs.back()->schedule();
+        }
+      });
     }
 
-    auto row_index = 0u;
-
-    for (auto chunk_id_out = ChunkID{0}; chunk_id_out < chunk_count_out; chunk_id_out++) {
-      // Because we want to add the values row wise we have to save all columns temporarily before we can add them to
-      // the
-      // output chunk.
-      auto column_vectors = std::vector<std::shared_ptr<BaseColumn>>(output->column_count());
-      for (ColumnID column_id{0}; column_id < output->column_count(); column_id++) {
-        auto column_type = _table_in->column_type(column_id);
-        column_vectors[column_id] =
-            make_shared_by_data_type<BaseColumn, ValueColumn>(column_type, _table_in->column_is_nullable(column_id));
-      }
+    CurrentScheduler::wait_for_tasks(jobs);
 
+    for (auto& columns : output_columns) {
       Chunk chunk_out;
-      // The last chunk might not be completely filled, so we have to check if we got out of range.
-      for (ChunkOffset chunk_offset_out = 0; chunk_offset_out < _output_chunk_size && row_index < output_row_count;
-           chunk_offset_out++) {
-        auto row_id_in = _row_id_value_vector->at(row_index).first;
-        for (ColumnID column_id{0}; column_id < output->column_count(); column_id++) {
-          // The actual value is added by visiting the input column, which then calls a function on the output column to
-          // copy the value
-          auto column = _table_in->get_chunk(row_id_in.chunk_id).get_column(column_id);
-          auto chunk_offset_in = row_id_in.chunk_offset;
-          if (auto reference_column = std::dynamic_pointer_cast<const ReferenceColumn>(column)) {
-            auto pos = reference_column->pos_list()->operator[](row_id_in.chunk_offset);
-            column = reference_column->referenced_table()
-                         ->get_chunk(pos.chunk_id)
-                         .get_column(reference_column->referenced_column_id());
-            chunk_offset_in = pos.chunk_offset;
-          }
-          column->copy_value_to_value_column(*column_vectors[column_id], chunk_offset_in);
-        }
-        row_index++;
-      }
-      for (ColumnID column_id{0}; column_id < output->column_count(); column_id++) {
-        chunk_out.add_column(std::move(column_vectors[column_id]));
+      for (auto& column : columns) {
+        chunk_out.add_column(std::move(column));
       }
       output->emplace_chunk(std::move(chunk_out));
     }
@@ -116,100 +281,259 @@ class Sort::SortImplMaterializeOutput {
     return output;
   }
 
+ protected:
   std::shared_ptr<const Table> _table_in;
   size_t _output_chunk_size;
-  std::shared_ptr<std::vector<std::pair<RowID, SortColumnType>>> _row_id_value_vector;
+  const std::vector<RowID>& _sorted_row_ids;
 };
 
-// we need to use the impl pattern because the scan operator of the sort depends on the type of the column
-template <typename SortColumnType>
-class Sort::SortImpl : public AbstractReadOnlyOperatorImpl {
- public:
-  using RowIDValuePair = std::pair<RowID, SortColumnType>;
-
-  SortImpl(const std::shared_ptr<const Table> table_in, const ColumnID column_id,
-           const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = 0)
-      : _table_in(table_in),
-        _column_id(column_id),
-        _order_by_mode(order_by_mode),
-        _output_chunk_size(output_chunk_size) {
-    // initialize a structure which can be sorted by std::sort
-    _row_id_value_vector = std::make_shared<std::vector<RowIDValuePair>>();
-    _null_value_rows = std::make_shared<std::vector<RowIDValuePair>>();
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto input_table = _input_table_left();
+
+  // Besides its key, the sort holds the RowID of each row, its index twice while merging runs, and its sorted RowID
+  const auto column_key_widths = NormalizedSortKeys::column_key_widths(input_table, _sort_definitions);
+  const auto row_size = std::accumulate(column_key_widths.cbegin(), column_key_widths.cend(), size_t{0}) +
+                        2 * sizeof(RowID) + 2 * sizeof(size_t);
+  const auto memory_budget = _memory_budget ? *_memory_budget : default_memory_budget();
+  if (input_table->row_count() * row_size > memory_budget) {
+    return _sort_spilled(column_key_widths, memory_budget / row_size);
   }
 
-  std::shared_ptr<const Table> _on_execute() override {
-    // 1. Prepare Sort: Creating rowid-value-Structure
-    _materialize_sort_column();
+  // 1. Encode the sort columns of each row into a normalized key
+  auto chunk_ids = std::vector<ChunkID>(input_table->chunk_count());
+  std::iota(chunk_ids.begin(), chunk_ids.end(), ChunkID{0});
+  const auto keys = NormalizedSortKeys{input_table, _sort_definitions, chunk_ids, column_key_widths};
+
+  // 2. Sort the rows by their keys. Equal keys are ordered by the position of the row, so the sort is stable. With a
+  // scheduler, one run for each worker is sorted in parallel and the runs are merged.
+  auto row_indices = std::vector<size_t>(keys.row_count());
+  std::iota(row_indices.begin(), row_indices.end(), size_t{0});
+
+  const auto worker_count = CurrentScheduler::is_set() ? CurrentScheduler::get()->topology()->num_cpus() : size_t{1};
+  const auto run_count = std::max(size_t{1}, std::min(worker_count, row_indices.size() / MIN_RUN_SIZE));
+  parallel_merge_sort(
+      row_indices, [&](const size_t left, const size_t right) { return keys.less(left, right); }, run_count);
+
+  auto sorted_row_ids = std::vector<RowID>{};
+  sorted_row_ids.reserve(row_indices.size());
+  for (const auto row_idx : row_indices) {
+    sorted_row_ids.emplace_back(keys.row_id(row_idx));
+  }
 
-    // 2. After we got our ValueRowID Map we sort the map by the value of the pair
-    if (_order_by_mode == OrderByMode::Ascending || _order_by_mode == OrderByMode::AscendingNullsLast) {
-      sort_with_operator<std::less<>>();
-    } else {
-      sort_with_operator<std::greater<>>();
-    }
+  // 3. Materialization of the result
+  return _materialize_output(sorted_row_ids);
+}
 
-    // 2b. Insert null rows if necessary
-    if (_null_value_rows->size()) {
-      if (_order_by_mode == OrderByMode::AscendingNullsLast || _order_by_mode == OrderByMode::DescendingNullsLast) {
-        // NULLs last
-        _row_id_value_vector->insert(_row_id_value_vector->end(), _null_value_rows->begin(), _null_value_rows->end());
-      } else {
-        // NULLs first (default behavior)
-        _row_id_value_vector->insert(_row_id_value_vector->begin(), _null_value_rows->begin(), _null_value_rows->end());
-      }
+std::shared_ptr<const Table> Sort::_sort_spilled(const std::vector<size_t>& column_key_widths,
+                                                 const size_t max_run_size) const {
+  const auto input_table = _input_table_left();
+  const auto key_width = std::accumulate(column_key_widths.cbegin(), column_key_widths.cend(), size_t{0});
+  const auto column_count = input_table->column_count();
+
+  /*
+  RUN GENERATION
+  Consecutive chunks are added to a run until it holds at least run_size rows, so that a run may exceed the budget by
+  a chunk. The rows of each run are sorted in memory by their keys, which are comparable across runs because all of
+  them are encoded with the column key widths of the whole table. Each block of a run's file holds the number of its
+  rows, their keys, and their values, one column after another.
+  */
+  const auto run_size = std::max({max_run_size, size_t{1},
+                                  (input_table->row_count() + MAX_SPILL_RUN_COUNT - 1) / MAX_SPILL_RUN_COUNT});
+
+  auto runs = std::vector<SpilledRun>{};
+  auto run_chunk_ids = std::vector<ChunkID>{};
+  auto run_row_count = size_t{0};
+
+  const auto spill_run = [&]() {
+    const auto keys = NormalizedSortKeys{input_table, _sort_definitions, run_chunk_ids, column_key_widths};
+
+    auto row_indices = std::vector<size_t>(keys.row_count());
+    std::iota(row_indices.begin(), row_indices.end(), size_t{0});
+    const auto worker_count = CurrentScheduler::is_set() ? CurrentScheduler::get()->topology()->num_cpus() : size_t{1};
+    const auto run_count = std::max(size_t{1}, std::min(worker_count, row_indices.size() / MIN_RUN_SIZE));
+    parallel_merge_sort(
+        row_indices, [&](const size_t left, const size_t right) { return keys.less(left, right); }, run_count);
+
+    auto sorted_row_ids = std::vector<RowID>{};
+    sorted_row_ids.reserve(row_indices.size());
+    for (const auto row_idx : row_indices) {
+      sorted_row_ids.emplace_back(keys.row_id(row_idx));
     }
 
-    // 3. Materialization of the result: We take the sorted ValueRowID Vector, create chunks fill them until they are
-    // full and create the next one. Each chunk is filled row by row.
-    auto materialization = std::make_shared<SortImplMaterializeOutput<SortColumnType>>(_table_in, _row_id_value_vector,
-                                                                                       _output_chunk_size);
-    return materialization->execute();
-  }
-
-  // completely materializes the sort column to create a vector of RowID-Value pairs
-  void _materialize_sort_column() {
-    auto& row_id_value_vector = *_row_id_value_vector;
-    row_id_value_vector.reserve(_table_in->row_count());
+    auto run = SpilledRun{};
+    run.file = std::make_unique<SpillFile>();
+    run.remaining_row_count = sorted_row_ids.size();
+    auto& file = *run.file;
+
+    // The type of each column and the columns of the run's chunks are resolved once for all blocks
+    auto column_writers = std::vector<std::function<void(const RowID* begin, const RowID* end)>>{};
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      const auto nullable = input_table->column_is_nullable(column_id);
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        const auto gatherer = std::make_shared<ColumnGatherer<ColumnDataType>>(*input_table, column_id);
+        column_writers.emplace_back([&file, gatherer, nullable](const RowID* begin, const RowID* end) {
+          const auto column = gatherer->gather(begin, end, nullable);
+          write_spilled_column(static_cast<const ValueColumn<ColumnDataType>&>(*column), file);
+        });
+      });
+    }
 
-    auto& null_value_rows = *_null_value_rows;
+    for (auto begin = size_t{0}; begin < sorted_row_ids.size(); begin += SPILL_BLOCK_SIZE) {
+      const auto end = std::min(begin + SPILL_BLOCK_SIZE, sorted_row_ids.size());
 
-    for (ChunkID chunk_id{0}; chunk_id < _table_in->chunk_count(); ++chunk_id) {
-      auto& chunk = _table_in->get_chunk(chunk_id);
+      file.write(static_cast<uint32_t>(end - begin));
+      for (auto sorted_idx = begin; sorted_idx < end; ++sorted_idx) {
+        file.write_bytes(keys.key(row_indices[sorted_idx]), key_width);
+      }
+      for (const auto& column_writer : column_writers) {
+        column_writer(sorted_row_ids.data() + begin, sorted_row_ids.data() + end);
+      }
+    }
 
-      auto base_column = chunk.get_column(_column_id);
+    runs.emplace_back(std::move(run));
+    run_chunk_ids.clear();
+    run_row_count = 0;
+  };
 
-      resolve_column_type<SortColumnType>(*base_column, [&](auto& typed_column) {
-        auto iterable = create_iterable_from_column<SortColumnType>(typed_column);
+  for (ChunkID chunk_id{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto chunk_size = input_table->get_chunk(chunk_id).size();
+    if (chunk_size == 0) continue;
 
-        iterable.for_each([&](const auto& value) {
-          if (value.is_null()) {
-            null_value_rows.emplace_back(RowID{chunk_id, value.chunk_offset()}, SortColumnType{});
-          } else {
-            row_id_value_vector.emplace_back(RowID{chunk_id, value.chunk_offset()}, value.value());
-          }
-        });
+    run_chunk_ids.emplace_back(chunk_id);
+    run_row_count += chunk_size;
+    if (run_row_count >= run_size) spill_run();
+  }
+  if (!run_chunk_ids.empty()) spill_run();
+
+  /*
+  MERGE PHASE
+  A min-heap holds the runs by the key of their current row. Equal keys are taken from the run of the earlier chunks
+  first, which keeps the sort stable. The taken rows are collected and copied into the output columns before the block
+  they are in is replaced, i.e., when a run moves on to its next block or when an output chunk is full.
+  */
+  const auto load_block = [&](SpilledRun& run) {
+    auto block_row_count = uint32_t{0};
+    run.file->read(block_row_count);
+    run.block_row_count = block_row_count;
+    run.row_idx = 0;
+    run.remaining_row_count -= block_row_count;
+
+    run.keys.resize(block_row_count * key_width);
+    run.file->read_bytes(run.keys.data(), run.keys.size());
+
+    run.columns.clear();
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        run.columns.emplace_back(read_spilled_column<ColumnDataType>(*run.file, block_row_count,
+                                                                     input_table->column_is_nullable(column_id)));
       });
     }
+  };
+
+  const auto current_key = [&](const size_t run_idx) {
+    const auto& run = runs[run_idx];
+    return run.keys.data() + run.row_idx * key_width;
+  };
+
+  // Rows with equal keys may differ after the prefix of a string, which is compared using the current block
+  const auto tie_breaker = SortKeyTieBreaker{input_table, _sort_definitions, column_key_widths};
+  const auto current_string = [&](const size_t run_idx) {
+    return [&, run_idx](const ColumnID column_id) {
+      const auto& run = runs[run_idx];
+      return type_cast<std::string>((*run.columns[column_id])[run.row_idx]);
+    };
+  };
+
+  // As std::push_heap and std::pop_heap create a max-heap, the run with the smallest key has to compare greatest
+  const auto heap_less = [&](const size_t left_run_idx, const size_t right_run_idx) {
+    auto comparison = std::memcmp(current_key(left_run_idx), current_key(right_run_idx), key_width);
+    if (comparison == 0 && tie_breaker.is_needed()) {
+      comparison =
+          tie_breaker.compare(current_key(left_run_idx), current_string(left_run_idx), current_string(right_run_idx));
+    }
+    return comparison > 0 || (comparison == 0 && left_run_idx > right_run_idx);
+  };
+
+  auto heap = std::vector<size_t>{};
+  for (auto run_idx = size_t{0}; run_idx < runs.size(); ++run_idx) {
+    runs[run_idx].file->rewind();
+    load_block(runs[run_idx]);
+    heap.emplace_back(run_idx);
   }
-
-  template <typename Comparator>
-  void sort_with_operator() {
-    Comparator comparator;
-    std::stable_sort(_row_id_value_vector->begin(), _row_id_value_vector->end(),
-                     [comparator](RowIDValuePair a, RowIDValuePair b) { return comparator(a.second, b.second); });
+  std::make_heap(heap.begin(), heap.end(), heap_less);
+
+  auto output = Table::create_with_layout_from(input_table, _output_chunk_size);
+  const auto output_chunk_size = _output_chunk_size ? _output_chunk_size : input_table->row_count();
+
+  auto output_columns = std::vector<std::shared_ptr<BaseColumn>>{};
+  auto output_chunk_row_count = size_t{0};
+  const auto create_output_columns = [&]() {
+    output_columns.clear();
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      output_columns.emplace_back(make_shared_by_data_type<BaseColumn, ValueColumn>(
+          input_table->column_type(column_id), input_table->column_is_nullable(column_id)));
+    }
+    output_chunk_row_count = 0;
+  };
+  create_output_columns();
+
+  // The taken rows as pairs of run and row in the run's current block
+  auto taken_rows = std::vector<std::pair<size_t, size_t>>{};
+  const auto copy_taken_rows = [&]() {
+    for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        auto& output_column = static_cast<ValueColumn<ColumnDataType>&>(*output_columns[column_id]);
+        for (const auto& [run_idx, row_idx] : taken_rows) {
+          const auto& block_column = static_cast<const ValueColumn<ColumnDataType>&>(*runs[run_idx].columns[column_id]);
+          output_column.values().push_back(block_column.values()[row_idx]);
+          if (output_column.is_nullable()) output_column.null_values().push_back(block_column.null_values()[row_idx]);
+        }
+      });
+    }
+    taken_rows.clear();
+  };
+
+  const auto emplace_output_chunk = [&]() {
+    copy_taken_rows();
+    Chunk chunk;
+    for (auto& column : output_columns) {
+      chunk.add_column(std::move(column));
+    }
+    output->emplace_chunk(std::move(chunk));
+    create_output_columns();
+  };
+
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), heap_less);
+    const auto run_idx = heap.back();
+    auto& run = runs[run_idx];
+
+    taken_rows.emplace_back(run_idx, run.row_idx);
+    ++run.row_idx;
+    if (++output_chunk_row_count == output_chunk_size) emplace_output_chunk();
+
+    if (run.row_idx < run.block_row_count) {
+      std::push_heap(heap.begin(), heap.end(), heap_less);
+    } else if (run.remaining_row_count > 0) {
+      copy_taken_rows();
+      load_block(run);
+      std::push_heap(heap.begin(), heap.end(), heap_less);
+    } else {
+      heap.pop_back();
+      run.file.reset();
+    }
   }
+  if (output_chunk_row_count > 0) emplace_output_chunk();
 
-  const std::shared_ptr<const Table> _table_in;
-
-  // column to sort by
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
-  // chunk size of the materialized output
-  const size_t _output_chunk_size;
+  return output;
+}
 
-  std::shared_ptr<std::vector<RowIDValuePair>> _row_id_value_vector;
-  std::shared_ptr<std::vector<RowIDValuePair>> _null_value_rows;
-};
+std::shared_ptr<const Table> Sort::_materialize_output(const std::vector<RowID>& sorted_row_ids) const {
+  // We take the sorted RowIDs, create chunks and fill them column by column until they are full
+  return SortImplMaterializeOutput{_input_table_left(), sorted_row_ids, _output_chunk_size}.execute();
+}
 
 }  // namespace opossum
@@ -1,23 +1,26 @@
 #pragma once
 
-#include <algorithm>
-#include <functional>
 #include <memory>
+#include <optional>
 #include <string>
-#include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
-#include "resolve_type.hpp"
-#include "storage/iterables/create_iterable_from_column.hpp"
+#include "sort/normalized_sort_keys.hpp"
 #include "types.hpp"
 
 namespace opossum {
 
 /**
- * Operator to sort a table by a single column. This implements a stable sort, i.e., rows that share the same value will
- * maintain their relative order.
- * Multi-column sort is not supported yet. For now, you will have to sort by the secondary criterion, then by the first
+ * Operator to sort a table by one or more columns, each in ascending or descending order with NULLs first or last.
+ * This implements a stable sort, i.e., rows that share the same values will maintain their relative order.
+ *
+ * The values of all sort columns of a row are encoded into a normalized key (see NormalizedSortKeys), so that the rows
+ * are sorted at once by comparing their keys with memcmp instead of by one column after the other. With a scheduler,
+ * the keys of the chunks are encoded and runs of rows are sorted and merged in parallel (see parallel_merge_sort).
+ *
+ * If the keys and RowIDs of all rows exceed the `memory_budget` (in bytes, by default a fraction of the main memory),
+ * an external merge sort is used instead, see _sort_spilled().
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
@@ -25,30 +28,44 @@ class Sort : public AbstractReadOnlyOperator {
   Sort(const std::shared_ptr<const AbstractOperator> in, const ColumnID column_id,
        const OrderByMode order_by_mode = OrderByMode::Ascending, const size_t output_chunk_size = Chunk::MAX_SIZE);
 
+  // The first definition is the primary sort criterion
+  Sort(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t output_chunk_size = Chunk::MAX_SIZE, const std::optional<size_t>& memory_budget = std::nullopt);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  // Column and sort order of the primary sort criterion
   ColumnID column_id() const;
   OrderByMode order_by_mode() const;
 
   const std::string name() const override;
   std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
 
+  // Fraction of the main memory that a single Sort may use for its keys and RowIDs if no budget is passed
+  static constexpr double DEFAULT_MEMORY_BUDGET_FRACTION = 0.25;
+
+  static size_t default_memory_budget();
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
-  void _on_cleanup() override;
-
-  // The operator is separated in three different classes. SortImpl is the common templated implementation of the
-  // operator. SortImpl* und SortImplMaterializeOutput are extra classes for the visitor pattern. They fulfill a certain
-  // task during the Sort process, as described later on.
-  template <typename SortColumnType>
-  class SortImpl;
-  template <typename SortColumnType>
-  class SortImplMaterializeSortColumn;
-  template <typename SortColumnType>
+
+  // Copies the rows of the input table into the output table in the given order
+  std::shared_ptr<const Table> _materialize_output(const std::vector<RowID>& sorted_row_ids) const;
+
+  /**
+   * Used if the keys and RowIDs of all rows do not fit into the memory budget. Consecutive chunks of the input are
+   * sorted in runs of about max_run_size rows, and each sorted run is written to a spill file in blocks of rows. The
+   * runs are then merged into the output, with only the current block of each run in memory.
+   */
+  std::shared_ptr<const Table> _sort_spilled(const std::vector<size_t>& column_key_widths,
+                                             const size_t max_run_size) const;
+
+  // SortImplMaterializeOutput copies the rows of the input table into the output table in the sorted order
   class SortImplMaterializeOutput;
 
-  std::unique_ptr<AbstractReadOnlyOperatorImpl> _impl;
-  const ColumnID _column_id;
-  const OrderByMode _order_by_mode;
+  const std::vector<SortColumnDefinition> _sort_definitions;
   const size_t _output_chunk_size;
+  const std::optional<size_t> _memory_budget;
 };
 
 }  // namespace opossum
@@ -0,0 +1,245 @@
+#include "normalized_sort_keys.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/iterables/create_iterable_from_column.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Length of the string length that follows the characters of a string
+constexpr auto STRING_LENGTH_WIDTH = sizeof(uint32_t);
+
+template <typename UnsignedType>
+void write_big_endian(const UnsignedType word, uint8_t* destination) {
+  for (auto byte_idx = size_t{0}; byte_idx < sizeof(UnsignedType); ++byte_idx) {
+    destination[byte_idx] = static_cast<uint8_t>(word >> ((sizeof(UnsignedType) - 1 - byte_idx) * 8));
+  }
+}
+
+template <typename T>
+void encode_sort_value(const T& value, uint8_t* destination, const size_t value_width) {
+  if constexpr (std::is_same<T, std::string>::value) {
+    // Strings longer than the prefix are marked by a length that no string of the prefix width has
+    const auto prefix_width = value_width - STRING_LENGTH_WIDTH;
+    DebugAssert(value.size() <= prefix_width || prefix_width == NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH,
+                "String is longer than its column in the key");
+    const auto is_cut_off = value.size() > prefix_width;
+    std::memcpy(destination, value.data(), is_cut_off ? prefix_width : value.size());
+    write_big_endian(static_cast<uint32_t>(is_cut_off ? prefix_width + 1 : value.size()), destination + prefix_width);
+  } else if constexpr (std::is_integral<T>::value) {
+    using UnsignedType = std::make_unsigned_t<T>;
+    constexpr auto sign_bit = UnsignedType{1} << (sizeof(T) * 8 - 1);
+    write_big_endian(static_cast<UnsignedType>(static_cast<UnsignedType>(value) ^ sign_bit), destination);
+  } else {
+    using UnsignedType = std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    constexpr auto sign_bit = UnsignedType{1} << (sizeof(T) * 8 - 1);
+
+    // -0.0 equals 0.0, but has a different binary representation
+    const auto normalized_value = (value == T{0}) ? T{0} : value;
+    auto bits = UnsignedType{0};
+    std::memcpy(&bits, &normalized_value, sizeof(bits));
+    write_big_endian(static_cast<UnsignedType>((bits & sign_bit) ? ~bits : (bits | sign_bit)), destination);
+  }
+}
+
+bool is_descending(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::Descending || order_by_mode == OrderByMode::DescendingNullsLast;
+}
+
+bool is_nulls_last(const OrderByMode order_by_mode) {
+  return order_by_mode == OrderByMode::AscendingNullsLast || order_by_mode == OrderByMode::DescendingNullsLast;
+}
+
+std::vector<ChunkID> all_chunk_ids(const Table& table) {
+  auto chunk_ids = std::vector<ChunkID>(table.chunk_count());
+  std::iota(chunk_ids.begin(), chunk_ids.end(), ChunkID{0});
+  return chunk_ids;
+}
+
+// Computes the width of a column in a key, which depends on the longest string (up to the prefix length) for string
+// columns
+size_t column_key_width(const Table& table, const ColumnID column_id) {
+  const auto null_width = table.column_is_nullable(column_id) ? size_t{1} : size_t{0};
+
+  auto value_width = size_t{0};
+  resolve_data_type(table.column_type(column_id), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    if constexpr (std::is_same<ColumnDataType, std::string>::value) {
+      auto max_string_lengths = std::vector<size_t>(table.chunk_count());
+
+      auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+      jobs.reserve(table.chunk_count());
+      for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+        jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+          const auto& column = *table.get_chunk(chunk_id).get_column(column_id);
+          resolve_column_type<ColumnDataType>(column, [&](const auto& typed_column) {
+            auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+            iterable.for_each([&](const auto& value) {
+              if (value.is_null()) return;
+              max_string_lengths[chunk_id] = std::max(max_string_lengths[chunk_id], value.value().size());
+            });
+          });
+        }));
+        jobs.back()->schedule();
+      }
+      CurrentScheduler::wait_for_tasks(jobs);
+
+      const auto max_string_length =
+          max_string_lengths.empty() ? size_t{0}
+                                     : *std::max_element(max_string_lengths.cbegin(), max_string_lengths.cend());
+      value_width = std::min(max_string_length, NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH) + STRING_LENGTH_WIDTH;
+    } else {
+      value_width = sizeof(ColumnDataType);
+    }
+  });
+
+  return null_width + value_width;
+}
+
+}  // namespace
+
+SortColumnDefinition::SortColumnDefinition(const ColumnID column_id, const OrderByMode order_by_mode)
+    : column_id(column_id), order_by_mode(order_by_mode) {}
+
+SortKeyTieBreaker::SortKeyTieBreaker(const std::shared_ptr<const Table>& table,
+                                     const std::vector<SortColumnDefinition>& definitions,
+                                     const std::vector<size_t>& column_key_widths)
+    : _table(table) {
+  constexpr auto cut_off_value_width = NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH + STRING_LENGTH_WIDTH;
+
+  auto key_offset = size_t{0};
+  for (auto definition_idx = size_t{0}; definition_idx < definitions.size(); ++definition_idx) {
+    const auto& definition = definitions[definition_idx];
+    const auto null_width = table->column_is_nullable(definition.column_id) ? size_t{1} : size_t{0};
+
+    // Only the columns with strings of at least the prefix length can hold cut off strings
+    if (table->column_type(definition.column_id) == DataType::String &&
+        column_key_widths[definition_idx] == null_width + cut_off_value_width) {
+      auto column = StringColumn{definition.column_id, is_descending(definition.order_by_mode),
+                                 key_offset + null_width + NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH, {}};
+      write_big_endian(static_cast<uint32_t>(NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH + 1), column.cut_off_length);
+      if (column.descending) {
+        for (auto& byte : column.cut_off_length) byte = static_cast<uint8_t>(~byte);
+      }
+      _columns.emplace_back(column);
+    }
+
+    key_offset += column_key_widths[definition_idx];
+  }
+}
+
+int SortKeyTieBreaker::compare(const uint8_t* key, const RowID& left_row_id, const RowID& right_row_id) const {
+  const auto get_string = [&](const RowID& row_id) {
+    return [&, row_id](const ColumnID column_id) {
+      const auto& column = *_table->get_chunk(row_id.chunk_id).get_column(column_id);
+      return type_cast<std::string>(column[row_id.chunk_offset]);
+    };
+  };
+  return compare(key, get_string(left_row_id), get_string(right_row_id));
+}
+
+NormalizedSortKeys::NormalizedSortKeys(const std::shared_ptr<const Table>& table,
+                                       const std::vector<SortColumnDefinition>& definitions)
+    : NormalizedSortKeys(table, definitions, all_chunk_ids(*table), column_key_widths(table, definitions)) {}
+
+NormalizedSortKeys::NormalizedSortKeys(const std::shared_ptr<const Table>& table,
+                                       const std::vector<SortColumnDefinition>& definitions,
+                                       const std::vector<ChunkID>& chunk_ids,
+                                       const std::vector<size_t>& column_key_widths)
+    : _table(table), _tie_breaker(table, definitions, column_key_widths) {
+  Assert(!definitions.empty(), "Expected at least one column to sort by");
+  Assert(definitions.size() == column_key_widths.size(), "Expected a key width for each column to sort by");
+
+  _key_width = std::accumulate(column_key_widths.cbegin(), column_key_widths.cend(), size_t{0});
+
+  auto row_count = size_t{0};
+  for (const auto chunk_id : chunk_ids) {
+    row_count += _table->get_chunk(chunk_id).size();
+  }
+  _keys.resize(row_count * _key_width);
+  _row_ids.reserve(row_count);
+
+  // The chunks are encoded in parallel, each into its own range of the keys
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_ids.size());
+
+  for (const auto chunk_id : chunk_ids) {
+    const auto first_row_idx = _row_ids.size();
+    const auto chunk_size = _table->get_chunk(chunk_id).size();
+    for (ChunkOffset chunk_offset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      _row_ids.emplace_back(RowID{chunk_id, chunk_offset});
+    }
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id, first_row_idx]() {
+      auto key_offset = size_t{0};
+      for (auto definition_idx = size_t{0}; definition_idx < definitions.size(); ++definition_idx) {
+        _encode_column(chunk_id, first_row_idx, definitions[definition_idx], key_offset,
+                       column_key_widths[definition_idx]);
+        key_offset += column_key_widths[definition_idx];
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+}
+
+std::vector<size_t> NormalizedSortKeys::column_key_widths(const std::shared_ptr<const Table>& table,
+                                                          const std::vector<SortColumnDefinition>& definitions) {
+  auto widths = std::vector<size_t>{};
+  widths.reserve(definitions.size());
+  for (const auto& definition : definitions) {
+    widths.emplace_back(column_key_width(*table, definition.column_id));
+  }
+  return widths;
+}
+
+void NormalizedSortKeys::_encode_column(const ChunkID chunk_id, const size_t first_row_idx,
+                                        const SortColumnDefinition& definition, const size_t key_offset,
+                                        const size_t column_key_width) {
+  const auto column_id = definition.column_id;
+  const auto is_nullable = _table->column_is_nullable(column_id);
+  const auto nulls_last = is_nulls_last(definition.order_by_mode);
+  const auto descending = is_descending(definition.order_by_mode);
+
+  const auto value_offset = key_offset + (is_nullable ? 1 : 0);
+  const auto value_width = column_key_width - (is_nullable ? 1 : 0);
+
+  const auto& column = *_table->get_chunk(chunk_id).get_column(column_id);
+  resolve_data_and_column_type(_table->column_type(column_id), column, [&](auto type, const auto& typed_column) {
+    using ColumnDataType = typename decltype(type)::type;
+
+    auto iterable = create_iterable_from_column<ColumnDataType>(typed_column);
+    iterable.for_each([&](const auto& value) {
+      auto* key = _keys.data() + (first_row_idx + value.chunk_offset()) * _key_width;
+
+      if (is_nullable) key[key_offset] = value.is_null() == nulls_last ? 1 : 0;
+      if (value.is_null()) return;
+
+      auto* value_key = key + value_offset;
+      encode_sort_value<ColumnDataType>(value.value(), value_key, value_width);
+      if (descending) {
+        for (auto byte_idx = size_t{0}; byte_idx < value_width; ++byte_idx) {
+          value_key[byte_idx] = static_cast<uint8_t>(~value_key[byte_idx]);
+        }
+      }
+    });
+  });
+}
+
+}  // namespace opossum
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * A column to sort by and its sort order
+ */
+struct SortColumnDefinition {
+  SortColumnDefinition(const ColumnID column_id, const OrderByMode order_by_mode = OrderByMode::Ascending);
+
+  ColumnID column_id;
+  OrderByMode order_by_mode;
+};
+
+/**
+ * Orders rows whose normalized keys (see below) are equal by the full strings of the sort columns that are cut off in
+ * their keys. Whether a string is cut off is encoded in the key, so that the strings of the rows are only looked up if
+ * they are longer than the prefix in the keys.
+ */
+class SortKeyTieBreaker {
+ public:
+  SortKeyTieBreaker(const std::shared_ptr<const Table>& table, const std::vector<SortColumnDefinition>& definitions,
+                    const std::vector<size_t>& column_key_widths);
+
+  // Whether the keys of any sort column may hold a cut off string
+  bool is_needed() const { return !_columns.empty(); }
+
+  // Compares two rows that share the given key. get_left_string and get_right_string return the string of the
+  // respective row in a column. Returns a negative value, zero, or a positive value like memcmp.
+  template <typename GetLeftString, typename GetRightString>
+  int compare(const uint8_t* key, const GetLeftString& get_left_string, const GetRightString& get_right_string) const {
+    for (const auto& column : _columns) {
+      if (std::memcmp(key + column.length_offset, column.cut_off_length, sizeof(column.cut_off_length)) != 0) continue;
+
+      const auto comparison = get_left_string(column.column_id).compare(get_right_string(column.column_id));
+      if (comparison != 0) return (comparison < 0) != column.descending ? -1 : 1;
+    }
+    return 0;
+  }
+
+  // Compares two rows of the table that share the given key
+  int compare(const uint8_t* key, const RowID& left_row_id, const RowID& right_row_id) const;
+
+ protected:
+  struct StringColumn {
+    ColumnID column_id;
+    bool descending;
+    // Offset of the string length in the key and the encoded length of a cut off string
+    size_t length_offset;
+    uint8_t cut_off_length[sizeof(uint32_t)];
+  };
+
+  const std::shared_ptr<const Table> _table;
+  std::vector<StringColumn> _columns;
+};
+
+/**
+ * Encodes the values of the sort columns of each row of a table into a normalized key, i.e., a byte string that has
+ * the same order under memcmp as the row has under the sort definitions. All keys have the same width, so that they
+ * are stored back to back and the rows are sorted by comparing their keys only, regardless of the number and types
+ * of the sort columns.
+ *
+ * The encoding of a column starts with a byte that puts NULLs first or last, if the column is nullable. It is followed
+ * by the value in big-endian order:
+ *  - integers with the sign bit flipped,
+ *  - floating point numbers with the sign bit flipped if positive and all bits flipped if negative,
+ *  - strings cut off after MAX_STRING_PREFIX_LENGTH characters, padded with zeros to the longest (cut off) string of
+ *    the column, and followed by their length, or MAX_STRING_PREFIX_LENGTH + 1 if they were cut off.
+ * For descending columns, the bits of the value are flipped. The value of NULLs is all zeros.
+ *
+ * As only a prefix of long strings is encoded, a single long string does not widen the keys of all rows. Rows with
+ * equal keys may still differ after the prefix of a string, which the SortKeyTieBreaker resolves.
+ *
+ * Rows are numbered chunk by chunk in the order of the given chunks, which are all chunks of the table by default.
+ * Keys of different chunks are only comparable if they were encoded with the same column key widths.
+ */
+class NormalizedSortKeys {
+ public:
+  // Strings longer than this are cut off in the keys
+  static constexpr size_t MAX_STRING_PREFIX_LENGTH = 32;
+
+  NormalizedSortKeys(const std::shared_ptr<const Table>& table, const std::vector<SortColumnDefinition>& definitions);
+
+  NormalizedSortKeys(const std::shared_ptr<const Table>& table, const std::vector<SortColumnDefinition>& definitions,
+                     const std::vector<ChunkID>& chunk_ids, const std::vector<size_t>& column_key_widths);
+
+  // Widths of the sort columns in a key, which depend on the longest string in the table for string columns, up to
+  // MAX_STRING_PREFIX_LENGTH
+  static std::vector<size_t> column_key_widths(const std::shared_ptr<const Table>& table,
+                                               const std::vector<SortColumnDefinition>& definitions);
+
+  size_t row_count() const { return _row_ids.size(); }
+  size_t key_width() const { return _key_width; }
+
+  const uint8_t* key(const size_t row_idx) const { return _keys.data() + row_idx * _key_width; }
+  RowID row_id(const size_t row_idx) const { return _row_ids[row_idx]; }
+
+  // Rows with equal keys are ordered by their cut off strings and then by their position in the input, which makes
+  // sorting by this comparison stable
+  bool less(const size_t left_row_idx, const size_t right_row_idx) const {
+    auto comparison = std::memcmp(key(left_row_idx), key(right_row_idx), _key_width);
+    if (comparison == 0 && _tie_breaker.is_needed()) {
+      comparison = _tie_breaker.compare(key(left_row_idx), row_id(left_row_idx), row_id(right_row_idx));
+    }
+    return comparison < 0 || (comparison == 0 && left_row_idx < right_row_idx);
+  }
+
+ protected:
+  // Writes the part of the keys of a chunk that encodes one column
+  void _encode_column(const ChunkID chunk_id, const size_t first_row_idx, const SortColumnDefinition& definition,
+                      const size_t key_offset, const size_t column_key_width);
+
+  const std::shared_ptr<const Table> _table;
+  const SortKeyTieBreaker _tie_breaker;
+  size_t _key_width = 0;
+  std::vector<uint8_t> _keys;
+  std::vector<RowID> _row_ids;
+};
+
+}  // namespace opossum
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+
+namespace opossum {
+
+/**
+ * Returns how many elements of the run [first_begin, first_end) are among the first output_offset elements of its
+ * stable merge with the run [second_begin, second_end). This is where the "merge path" crosses the diagonal of the
+ * output_offset-th element, which is found with a binary search. See Odeh et al., "Merge Path - Parallel Merging Made
+ * Simple" (2012).
+ */
+template <typename Iterator, typename Less>
+size_t merge_path_split(const Iterator first_begin, const Iterator first_end, const Iterator second_begin,
+                        const Iterator second_end, const size_t output_offset, const Less& less) {
+  const auto first_size = static_cast<size_t>(std::distance(first_begin, first_end));
+  const auto second_size = static_cast<size_t>(std::distance(second_begin, second_end));
+
+  auto low = output_offset > second_size ? output_offset - second_size : size_t{0};
+  auto high = std::min(output_offset, first_size);
+  while (low < high) {
+    const auto middle = low + (high - low) / 2;
+    // On ties, elements of the first run come first
+    if (!less(second_begin[output_offset - middle - 1], first_begin[middle])) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+/**
+ * Sorts values in parallel if a scheduler is active. The values are split into run_count runs of about the same size,
+ * which are sorted by one JobTask each. Then, adjacent runs are merged pairwise until one run is left. To keep all
+ * workers busy until the last merge, each merge is split into segments of about the size of a run, which are merged
+ * by JobTasks independently.
+ *
+ * The runs are sorted by std::sort, so values that are neither less nor greater than each other end up in an
+ * arbitrary order.
+ */
+template <typename T, typename Less>
+void parallel_merge_sort(std::vector<T>& values, const Less& less, const size_t run_count) {
+  if (run_count <= 1 || values.size() < run_count) {
+    std::sort(values.begin(), values.end(), less);
+    return;
+  }
+
+  // 1. Sort the runs
+  const auto run_size = (values.size() + run_count - 1) / run_count;
+
+  auto run_begins = std::vector<size_t>{};
+  for (auto run_begin = size_t{0}; run_begin < values.size(); run_begin += run_size) {
+    run_begins.emplace_back(run_begin);
+  }
+  run_begins.emplace_back(values.size());
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto run_idx = size_t{0}; run_idx + 1 < run_begins.size(); ++run_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, run_idx]() {
+      std::sort(values.begin() + run_begins[run_idx], values.begin() + run_begins[run_idx + 1], less);
+    }));
+    jobs.back()->schedule();
+  }
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // 2. Merge pairs of adjacent runs from values into buffer (and back) until one run is left
+  auto buffer = std::vector<T>(values.size());
+  auto* source = &values;
+  auto* target = &buffer;
+
+  while (run_begins.size() > 2) {
+    jobs.clear();
+    auto merged_run_begins = std::vector<size_t>{};
+
+    for (auto run_idx = size_t{0}; run_idx + 1 < run_begins.size(); run_idx += 2) {
+      const auto first_begin = source->cbegin() + run_begins[run_idx];
+      const auto first_end = source->cbegin() + run_begins[run_idx + 1];
+      const auto second_end = source->cbegin() + run_begins[std::min(run_idx + 2, run_begins.size() - 1)];
+      const auto output_begin = target->begin() + run_begins[run_idx];
+      const auto merged_size = static_cast<size_t>(std::distance(first_begin, second_end));
+
+      merged_run_begins.emplace_back(run_begins[run_idx]);
+
+      for (auto segment_begin = size_t{0}; segment_begin < merged_size; segment_begin += run_size) {
+        const auto segment_end = std::min(segment_begin + run_size, merged_size);
+
+        jobs.emplace_back(std::make_shared<JobTask>([=, &less]() {
+          const auto first_split_begin =
+              merge_path_split(first_begin, first_end, first_end, second_end, segment_begin, less);
+          const auto first_split_end =
+              merge_path_split(first_begin, first_end, first_end, second_end, segment_end, less);
+
+          std::merge(first_begin + first_split_begin, first_begin + first_split_end,
+                     first_end + (segment_begin - first_split_begin), first_end + (segment_end - first_split_end),
+                     output_begin + segment_begin, less);
+        }));
+        jobs.back()->schedule();
+      }
+    }
+    merged_run_begins.emplace_back(values.size());
+
+    CurrentScheduler::wait_for_tasks(jobs);
+
+    run_begins = std::move(merged_run_begins);
+    std::swap(source, target);
+  }
+
+  if (source != &values) values = std::move(buffer);
+}
+
+}  // namespace opossum
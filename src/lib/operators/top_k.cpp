@@ -0,0 +1,156 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "scheduler/abstract_scheduler.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "scheduler/topology.hpp"
+#include "sort/normalized_sort_keys.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+namespace {
+
+/**
+ * The rows with the smallest keys offered so far, at most capacity of them. The top of the heap is the row with the
+ * largest key, which is replaced when a row with a smaller key is offered. As in NormalizedSortKeys, rows with equal
+ * keys are ordered by their cut off strings and then by their position in the input.
+ */
+class BoundedKeyHeap {
+ public:
+  BoundedKeyHeap(const size_t capacity, const size_t key_width, const SortKeyTieBreaker& tie_breaker)
+      : _capacity(capacity), _key_width(key_width), _tie_breaker(&tie_breaker) {}
+
+  void offer(const uint8_t* row_key, const RowID row_id) {
+    const auto slot_less = [&](const size_t left_slot, const size_t right_slot) {
+      return less(key(left_slot), _row_ids[left_slot], key(right_slot), _row_ids[right_slot]);
+    };
+
+    if (_row_ids.size() < _capacity) {
+      _keys.insert(_keys.end(), row_key, row_key + _key_width);
+      _row_ids.emplace_back(row_id);
+      _heap.emplace_back(_row_ids.size() - 1);
+      std::push_heap(_heap.begin(), _heap.end(), slot_less);
+      return;
+    }
+
+    const auto largest_slot = _heap.front();
+    if (!less(row_key, row_id, key(largest_slot), _row_ids[largest_slot])) return;
+
+    std::pop_heap(_heap.begin(), _heap.end(), slot_less);
+    std::memcpy(_keys.data() + largest_slot * _key_width, row_key, _key_width);
+    _row_ids[largest_slot] = row_id;
+    std::push_heap(_heap.begin(), _heap.end(), slot_less);
+  }
+
+  size_t size() const { return _row_ids.size(); }
+  const uint8_t* key(const size_t slot) const { return _keys.data() + slot * _key_width; }
+  RowID row_id(const size_t slot) const { return _row_ids[slot]; }
+
+  bool less(const uint8_t* left_key, const RowID& left_row_id, const uint8_t* right_key,
+            const RowID& right_row_id) const {
+    auto comparison = std::memcmp(left_key, right_key, _key_width);
+    if (comparison == 0 && _tie_breaker->is_needed()) {
+      comparison = _tie_breaker->compare(left_key, left_row_id, right_row_id);
+    }
+    return comparison < 0 || (comparison == 0 && left_row_id < right_row_id);
+  }
+
+ private:
+  const size_t _capacity;
+  const size_t _key_width;
+  const SortKeyTieBreaker* _tie_breaker;
+  std::vector<uint8_t> _keys;
+  std::vector<RowID> _row_ids;
+  std::vector<size_t> _heap;
+};
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+           const size_t k, const size_t output_chunk_size)
+    : Sort(in, sort_definitions, output_chunk_size), _k(k) {}
+
+size_t TopK::k() const { return _k; }
+
+const std::string TopK::name() const { return "TopK"; }
+
+std::shared_ptr<AbstractOperator> TopK::recreate(const std::vector<AllParameterVariant>& args) const {
+  return std::make_shared<TopK>(_input_left->recreate(args), _sort_definitions, _k, _output_chunk_size);
+}
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = _input_table_left();
+  const auto chunk_count = input_table->chunk_count();
+
+  // If no row is dropped, nothing is saved over sorting all rows
+  if (_k >= input_table->row_count()) return Sort::_on_execute();
+  if (_k == 0) return _materialize_output({});
+
+  // 1. Each job keeps the smallest k rows of a range of chunks. The keys are encoded one chunk at a time, so that only
+  // those of the heaps and of the current chunk are held in memory.
+  const auto worker_count = CurrentScheduler::is_set() ? CurrentScheduler::get()->topology()->num_cpus() : size_t{1};
+  const auto job_count = std::max(size_t{1}, std::min(worker_count, static_cast<size_t>(chunk_count)));
+  const auto column_key_widths = NormalizedSortKeys::column_key_widths(input_table, _sort_definitions);
+  const auto key_width = std::accumulate(column_key_widths.cbegin(), column_key_widths.cend(), size_t{0});
+
+  const auto tie_breaker = SortKeyTieBreaker{input_table, _sort_definitions, column_key_widths};
+  auto heaps = std::vector<BoundedKeyHeap>(job_count, BoundedKeyHeap{_k, key_width, tie_breaker});
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(job_count);
+  for (auto job_idx = size_t{0}; job_idx < job_count; ++job_idx) {
+    const auto begin_chunk_id = static_cast<ChunkID>(chunk_count * job_idx / job_count);
+    const auto end_chunk_id = static_cast<ChunkID>(chunk_count * (job_idx + 1) / job_count);
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, job_idx, begin_chunk_id, end_chunk_id]() {
+      for (auto chunk_id = begin_chunk_id; chunk_id < end_chunk_id; ++chunk_id) {
+        const auto keys = NormalizedSortKeys{input_table, _sort_definitions, {chunk_id}, column_key_widths};
+        for (auto row_idx = size_t{0}; row_idx < keys.row_count(); ++row_idx) {
+          heaps[job_idx].offer(keys.key(row_idx), keys.row_id(row_idx));
+        }
+      }
+    }));
+    jobs.back()->schedule();
+  }
+
+  CurrentScheduler::wait_for_tasks(jobs);
+
+  // 2. Sort the rows of all heaps and keep the first k of them
+  auto candidates = std::vector<std::pair<size_t, size_t>>{};
+  for (auto heap_idx = size_t{0}; heap_idx < heaps.size(); ++heap_idx) {
+    for (auto slot = size_t{0}; slot < heaps[heap_idx].size(); ++slot) {
+      candidates.emplace_back(heap_idx, slot);
+    }
+  }
+
+  const auto output_row_count = std::min(_k, candidates.size());
+  std::partial_sort(candidates.begin(), candidates.begin() + output_row_count, candidates.end(),
+                    [&](const auto& left, const auto& right) {
+                      const auto& left_heap = heaps[left.first];
+                      const auto& right_heap = heaps[right.first];
+                      return left_heap.less(left_heap.key(left.second), left_heap.row_id(left.second),
+                                            right_heap.key(right.second), right_heap.row_id(right.second));
+                    });
+
+  auto sorted_row_ids = std::vector<RowID>{};
+  sorted_row_ids.reserve(output_row_count);
+  for (auto candidate_idx = size_t{0}; candidate_idx < output_row_count; ++candidate_idx) {
+    const auto& [heap_idx, slot] = candidates[candidate_idx];
+    sorted_row_ids.emplace_back(heaps[heap_idx].row_id(slot));
+  }
+
+  // 3. Materialize only the k output rows
+  return _materialize_output(sorted_row_ids);
+}
+
+}  // namespace opossum
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sort.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Sort fused with Limit, i.e., outputs the first k rows of the input in the order of the sort definitions, exactly as
+ * Limit(Sort(in, sort_definitions), k) would. Instead of sorting all rows, each job scans a range of chunks and keeps
+ * the k rows with the smallest normalized keys it has seen in a bounded max-heap. Only the rows left in the heaps are
+ * sorted in the end and only the k output rows are materialized.
+ *
+ * The LQPTranslator uses it for a LimitNode directly on top of a SortNode, e.g., for ORDER BY x LIMIT 10.
+ */
+class TopK : public Sort {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator> in, const std::vector<SortColumnDefinition>& sort_definitions,
+       const size_t k, const size_t output_chunk_size = Chunk::MAX_SIZE);
+
+  size_t k() const;
+
+  const std::string name() const override;
+  std::shared_ptr<AbstractOperator> recreate(const std::vector<AllParameterVariant>& args = {}) const override;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const size_t _k;
+};
+
+}  // namespace opossum
@@ -13,6 +13,7 @@
 #include "operators/aggregate.hpp"
 #include "operators/table_wrapper.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
 #include "table_statistics.hpp"
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -1,5 +1,6 @@
 #include "join_detection_rule.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -27,18 +28,46 @@ bool JoinDetectionRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) {
        * If we find a predicate with a condition that operates on the cross-joined tables,
        * replace the cross join and the predicate with a conditional inner join
        */
-      auto join_condition = _find_predicate_for_cross_join(cross_join_node);
-      if (join_condition) {
-        std::pair<ColumnID, ColumnID> column_ids(join_condition->left_column_id, join_condition->right_column_id);
+      auto join_conditions = _find_predicates_for_cross_join(cross_join_node);
+      if (!join_conditions.empty()) {
+        /**
+         * Prefer an equality predicate as the primary join condition, so that all other equality predicates can be
+         * merged into the same join, which then matches on a composite key
+         */
+        auto primary_condition = std::find_if(
+            join_conditions.begin(), join_conditions.end(),
+            [](const auto& join_condition) { return join_condition.predicate_node->scan_type() == ScanType::Equals; });
+        if (primary_condition == join_conditions.end()) primary_condition = join_conditions.begin();
+
+        const auto scan_type = primary_condition->predicate_node->scan_type();
+        std::pair<ColumnID, ColumnID> column_ids(primary_condition->left_column_id, primary_condition->right_column_id);
+
+        std::vector<std::pair<ColumnID, ColumnID>> additional_column_ids;
+        std::vector<std::shared_ptr<PredicateNode>> predicate_nodes{primary_condition->predicate_node};
+
+        if (scan_type == ScanType::Equals) {
+          for (auto join_condition = join_conditions.begin(); join_condition != join_conditions.end();
+               ++join_condition) {
+            if (join_condition == primary_condition ||
+                join_condition->predicate_node->scan_type() != ScanType::Equals) {
+              continue;
+            }
+
+            additional_column_ids.emplace_back(join_condition->left_column_id, join_condition->right_column_id);
+            predicate_nodes.emplace_back(join_condition->predicate_node);
+          }
+        }
 
-        auto predicate_node = join_condition->predicate_node;
-        const auto new_join_node = std::make_shared<JoinNode>(JoinMode::Inner, column_ids, predicate_node->scan_type());
+        const auto new_join_node =
+            std::make_shared<JoinNode>(JoinMode::Inner, column_ids, scan_type, additional_column_ids);
 
         /**
-         * Place the conditional join where the cross join was and remove the predicate node
+         * Place the conditional join where the cross join was and remove the predicate nodes
          */
         cross_join_node->replace_with(new_join_node);
-        predicate_node->remove_from_tree();
+        for (const auto& predicate_node : predicate_nodes) {
+          predicate_node->remove_from_tree();
+        }
 
         return true;
       }
@@ -48,10 +77,12 @@ bool JoinDetectionRule::apply_to(const std::shared_ptr<AbstractLQPNode>& node) {
   return _apply_to_children(node);
 }
 
-std::optional<JoinDetectionRule::JoinCondition> JoinDetectionRule::_find_predicate_for_cross_join(
+std::vector<JoinDetectionRule::JoinCondition> JoinDetectionRule::_find_predicates_for_cross_join(
     const std::shared_ptr<JoinNode>& cross_join) {
   Assert(cross_join->left_child() && cross_join->right_child(), "Cross Join must have two children");
 
+  std::vector<JoinCondition> join_conditions;
+
   // Everytime we traverse a node which we're the right child of, the ColumnIDs a predicate needs to reference become
   // offsetted
   auto column_id_offset = 0;
@@ -83,13 +114,14 @@ std::optional<JoinDetectionRule::JoinCondition> JoinDetectionRule::_find_predica
      * Detecting Join Conditions across other node types may be possible by applying 'Predicate Pushdown' first.
      */
     if (node->type() != LQPNodeType::Join && node->type() != LQPNodeType::Predicate) {
-      return std::nullopt;
+      break;
     }
 
     if (node->type() == LQPNodeType::Predicate) {
       const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
 
-      if (predicate_node->value().type() != typeid(ColumnID)) {
+      // The second value of a BETWEEN predicate is a literal, so it cannot become a JoinNode's predicate
+      if (predicate_node->value().type() != typeid(ColumnID) || predicate_node->scan_type() == ScanType::Between) {
         continue;
       }
 
@@ -123,20 +155,19 @@ std::optional<JoinDetectionRule::JoinCondition> JoinDetectionRule::_find_predica
 
       if (_is_join_condition(predicate_left_column_id, predicate_right_column_id, cross_left_num_cols,
                              cross_right_num_cols)) {
-        return JoinCondition{predicate_node, predicate_left_column_id,
-                             ColumnID{(ColumnID::base_type)(predicate_right_column_id - cross_left_num_cols)}};
+        join_conditions.emplace_back(
+            JoinCondition{predicate_node, predicate_left_column_id,
+                          ColumnID{(ColumnID::base_type)(predicate_right_column_id - cross_left_num_cols)}});
+      } else if (_is_join_condition(predicate_right_column_id, predicate_left_column_id, cross_left_num_cols,
+                                    cross_right_num_cols)) {
+        join_conditions.emplace_back(
+            JoinCondition{predicate_node, predicate_right_column_id,
+                          ColumnID{(ColumnID::base_type)(predicate_left_column_id - cross_left_num_cols)}});
       }
-      if (_is_join_condition(predicate_right_column_id, predicate_left_column_id, cross_left_num_cols,
-                             cross_right_num_cols)) {
-        return JoinCondition{predicate_node, predicate_right_column_id,
-                             ColumnID{(ColumnID::base_type)(predicate_left_column_id - cross_left_num_cols)}};
-      }
-
-      // If we make it here, the predicate was no fit to be merged with the cross join
     }
   }
 
-  return std::nullopt;
+  return join_conditions;
 }
 
 bool JoinDetectionRule::_is_join_condition(ColumnID left, ColumnID right, size_t left_num_cols,
@@ -33,6 +33,8 @@ struct ColumnID;
  * by searching the parent nodes for PredicateNodes. Each PredicateNode is a potential candidate
  * but only those that compare two columns are interesting enough to check.
  * When such a PredicateNode is found, the rule will check whether each ColumnID comes from the left/right input.
+ * If several such PredicateNodes compare columns for equality, all of them are merged into the join, which then
+ * matches on a composite key (see JoinNode::additional_join_column_ids()).
  *
  * Note: Limited first iteration. This will only work on subtrees consisting of Joins and Predicates, so we don't
  * have to deal with ColumnID re-mappings for now. Projections, Aggregates, etc. amidst Joins and Predicates
@@ -51,7 +53,7 @@ class JoinDetectionRule : public AbstractRule {
     ColumnID right_column_id;
   };
 
-  std::optional<JoinCondition> _find_predicate_for_cross_join(const std::shared_ptr<JoinNode>& cross_join);
+  std::vector<JoinCondition> _find_predicates_for_cross_join(const std::shared_ptr<JoinNode>& cross_join);
 
   /**
    * Used to check whether a Predicate working on the ColumnIDs left and right could be used as a JoinCondition
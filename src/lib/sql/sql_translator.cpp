@@ -1,6 +1,7 @@
 #include "sql_translator.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
@@ -39,6 +40,19 @@
 
 namespace opossum {
 
+namespace {
+
+// Whether two expressions are equal apart from their aliases, e.g., `a * 100 + b AS k` and `a * 100 + b`
+bool equals_without_alias(const Expression& left, const Expression& right) {
+  const auto left_copy = left.deep_copy();
+  const auto right_copy = right.deep_copy();
+  left_copy->set_alias("");
+  right_copy->set_alias("");
+  return *left_copy == *right_copy;
+}
+
+}  // namespace
+
 ScanType translate_operator_type_to_scan_type(const hsql::OperatorType operator_type) {
   static const std::unordered_map<const hsql::OperatorType, const ScanType> operator_to_scan_type = {
       {hsql::kOpEquals, ScanType::Equals},       {hsql::kOpNotEquals, ScanType::NotEquals},
@@ -308,64 +322,122 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_join(const hsql::Join
   auto left_node = _translate_table_ref(*join.left);
   auto right_node = _translate_table_ref(*join.right);
 
-  const hsql::Expr& condition = *join.condition;
-
-  Assert(condition.type == hsql::kExprOperator, "Join condition must be operator.");
-  // The Join operators only support simple comparisons for now.
-  switch (condition.opType) {
-    case hsql::kOpEquals:
-    case hsql::kOpNotEquals:
-    case hsql::kOpLess:
-    case hsql::kOpLessEq:
-    case hsql::kOpGreater:
-    case hsql::kOpGreaterEq:
-      break;
-    default:
-      Fail("Join condition must be a simple comparison operator.");
+  /**
+   * A join condition is either a single comparison of two columns or a conjunction (AND) of such comparisons. In the
+   * latter case, all comparisons need to be equality comparisons and the join is performed on a composite key.
+   */
+  std::vector<const hsql::Expr*> conditions;
+  std::vector<const hsql::Expr*> unvisited_conditions{join.condition};
+  while (!unvisited_conditions.empty()) {
+    const auto condition = unvisited_conditions.back();
+    unvisited_conditions.pop_back();
+
+    Assert(condition->type == hsql::kExprOperator, "Join condition must be operator.");
+    if (condition->opType == hsql::kOpAnd) {
+      // Push the right operand first, so that the conditions are translated from left to right
+      unvisited_conditions.emplace_back(condition->expr2);
+      unvisited_conditions.emplace_back(condition->expr);
+    } else {
+      conditions.emplace_back(condition);
+    }
   }
-  Assert(condition.expr && condition.expr->type == hsql::kExprColumnRef,
-         "Left arg of join condition must be column ref");
-  Assert(condition.expr2 && condition.expr2->type == hsql::kExprColumnRef,
-         "Right arg of join condition must be column ref");
-
-  const auto left_named_column_reference =
-      SQLExpressionTranslator::get_named_column_reference_for_column_reference(*condition.expr);
-  const auto right_named_column_reference =
-      SQLExpressionTranslator::get_named_column_reference_for_column_reference(*condition.expr2);
 
   /**
-   * `x_in_y_node` indicates whether the column identifier on the `x` side in the join expression is in the input node
-   * on
-   * the `y` side of the join. So in the query
-   * `SELECT * FROM T1 JOIN T2 on person_id == customer_id`
-   * We have to check whether `person_id` belongs to T1 (left_in_left_node == true) or to T2
-   * (left_in_right_node == true). Later we make sure that one and only one of them is true, otherwise we either have
-   * ambiguity or the column is simply not existing.
+   * A join condition of the form `left.point BETWEEN right.lower AND right.upper` is translated into a band join. For
+   * now, the point has to be a column of the left input and both bounds have to be columns of the right input.
    */
-  const auto left_in_left_node = left_node->find_column_id_by_named_column_reference(left_named_column_reference);
-  const auto left_in_right_node = right_node->find_column_id_by_named_column_reference(left_named_column_reference);
-  const auto right_in_left_node = left_node->find_column_id_by_named_column_reference(right_named_column_reference);
-  const auto right_in_right_node = right_node->find_column_id_by_named_column_reference(right_named_column_reference);
-
-  Assert(static_cast<bool>(left_in_left_node) ^ static_cast<bool>(left_in_right_node),
-         std::string("Left operand ") + left_named_column_reference.as_string() +
-             " must be in exactly one of the input nodes");
-  Assert(static_cast<bool>(right_in_left_node) ^ static_cast<bool>(right_in_right_node),
-         std::string("Right operand ") + right_named_column_reference.as_string() +
-             " must be in exactly one of the input nodes");
-
-  std::pair<ColumnID, ColumnID> column_ids;
-
-  if (left_in_left_node) {
-    column_ids = std::make_pair(*left_in_left_node, *right_in_right_node);
-  } else {
-    column_ids = std::make_pair(*left_in_right_node, *right_in_left_node);
+  if (conditions.size() == 1 && conditions.front()->opType == hsql::kOpBetween) {
+    const auto& condition = *conditions.front();
+    Assert(condition.exprList && condition.exprList->size() == 2, "Need two arguments for BETWEEN");
+
+    const auto resolve_column = [](const hsql::Expr* expr, const std::shared_ptr<AbstractLQPNode>& node,
+                                   const std::string& error_message) {
+      Assert(expr && expr->type == hsql::kExprColumnRef, "Operands of BETWEEN join conditions must be column refs");
+      const auto column_id = node->find_column_id_by_named_column_reference(
+          SQLExpressionTranslator::get_named_column_reference_for_column_reference(*expr));
+      Assert(column_id, error_message);
+      return *column_id;
+    };
+
+    const auto point_column_id = resolve_column(condition.expr, left_node, "BETWEEN join value must be a left column");
+    const auto lower_bound_column_id =
+        resolve_column((*condition.exprList)[0], right_node, "BETWEEN join bounds must be right columns");
+    const auto upper_bound_column_id =
+        resolve_column((*condition.exprList)[1], right_node, "BETWEEN join bounds must be right columns");
+
+    auto join_node = std::make_shared<JoinNode>(join_mode, std::make_pair(point_column_id, lower_bound_column_id),
+                                                upper_bound_column_id);
+    join_node->set_left_child(left_node);
+    join_node->set_right_child(right_node);
+
+    return join_node;
   }
 
-  // Joins currently only support one simple condition (i.e., not multiple conditions).
-  auto scan_type = translate_operator_type_to_scan_type(condition.opType);
+  const auto translate_condition = [&](const hsql::Expr& condition) {
+    // The Join operators only support simple comparisons for now.
+    switch (condition.opType) {
+      case hsql::kOpEquals:
+      case hsql::kOpNotEquals:
+      case hsql::kOpLess:
+      case hsql::kOpLessEq:
+      case hsql::kOpGreater:
+      case hsql::kOpGreaterEq:
+        break;
+      default:
+        Fail("Join condition must be a simple comparison operator.");
+    }
+    Assert(condition.expr && condition.expr->type == hsql::kExprColumnRef,
+           "Left arg of join condition must be column ref");
+    Assert(condition.expr2 && condition.expr2->type == hsql::kExprColumnRef,
+           "Right arg of join condition must be column ref");
+
+    const auto left_named_column_reference =
+        SQLExpressionTranslator::get_named_column_reference_for_column_reference(*condition.expr);
+    const auto right_named_column_reference =
+        SQLExpressionTranslator::get_named_column_reference_for_column_reference(*condition.expr2);
+
+    /**
+     * `x_in_y_node` indicates whether the column identifier on the `x` side in the join expression is in the input
+     * node on the `y` side of the join. So in the query
+     * `SELECT * FROM T1 JOIN T2 on person_id == customer_id`
+     * We have to check whether `person_id` belongs to T1 (left_in_left_node == true) or to T2
+     * (left_in_right_node == true). Later we make sure that one and only one of them is true, otherwise we either have
+     * ambiguity or the column is simply not existing.
+     */
+    const auto left_in_left_node = left_node->find_column_id_by_named_column_reference(left_named_column_reference);
+    const auto left_in_right_node = right_node->find_column_id_by_named_column_reference(left_named_column_reference);
+    const auto right_in_left_node = left_node->find_column_id_by_named_column_reference(right_named_column_reference);
+    const auto right_in_right_node = right_node->find_column_id_by_named_column_reference(right_named_column_reference);
+
+    Assert(static_cast<bool>(left_in_left_node) ^ static_cast<bool>(left_in_right_node),
+           std::string("Left operand ") + left_named_column_reference.as_string() +
+               " must be in exactly one of the input nodes");
+    Assert(static_cast<bool>(right_in_left_node) ^ static_cast<bool>(right_in_right_node),
+           std::string("Right operand ") + right_named_column_reference.as_string() +
+               " must be in exactly one of the input nodes");
+
+    std::pair<ColumnID, ColumnID> column_ids;
+
+    if (left_in_left_node) {
+      column_ids = std::make_pair(*left_in_left_node, *right_in_right_node);
+    } else {
+      column_ids = std::make_pair(*left_in_right_node, *right_in_left_node);
+    }
+
+    return column_ids;
+  };
+
+  const auto column_ids = translate_condition(*conditions.front());
+  auto scan_type = translate_operator_type_to_scan_type(conditions.front()->opType);
 
-  auto join_node = std::make_shared<JoinNode>(join_mode, column_ids, scan_type);
+  std::vector<std::pair<ColumnID, ColumnID>> additional_column_ids;
+  for (auto condition_idx = size_t{1}; condition_idx < conditions.size(); ++condition_idx) {
+    Assert(scan_type == ScanType::Equals && conditions[condition_idx]->opType == hsql::kOpEquals,
+           "Join conditions consisting of multiple comparisons must only contain equality comparisons.");
+    additional_column_ids.emplace_back(translate_condition(*conditions[condition_idx]));
+  }
+
+  auto join_node = std::make_shared<JoinNode>(join_mode, column_ids, scan_type, additional_column_ids);
   join_node->set_left_child(left_node);
   join_node->set_right_child(right_node);
 
@@ -585,8 +657,10 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_aggregate(
   /**
    * This function creates the following node structure:
    *
-   * input_node -> aggregate_node -> {having_node}* -> projection_node
+   * input_node -> {groupby_projection_node} -> aggregate_node -> {having_node}* -> projection_node
    *
+   * - the optional groupby_projection_node passes on all input columns and appends the GROUP BY expressions that are
+   *        not plain columns, e.g., `a * 100 + b`. The LQPTranslator fuses it into the Aggregate operator.
    * - the aggregate_node creates aggregate and groupby columns.
    * - the having_nodes apply the predicates in the optional HAVING clause
    * - the projection_node establishes the correct column order (since AggregateNode outputs all groupby columns first
@@ -601,6 +675,30 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_aggregate(
   std::vector<std::shared_ptr<Expression>> aggregate_expressions;
   aggregate_expressions.reserve(select_list.size());
 
+  /**
+   * Collect the GROUP BY expressions. Some of them may be aliases that are set in the SELECT list, in which case the
+   * aliased expression is used.
+   */
+  std::vector<std::shared_ptr<Expression>> groupby_expressions;
+  if (group_by != nullptr) {
+    for (const auto* groupby_hsql_expr : *group_by->columns) {
+      const auto* resolved_hsql_expr = groupby_hsql_expr;
+      if (groupby_hsql_expr->isType(hsql::kExprColumnRef) && !groupby_hsql_expr->table) {
+        for (const auto* column_expr : select_list) {
+          if (column_expr->alias && strcmp(column_expr->alias, groupby_hsql_expr->name) == 0) {
+            resolved_hsql_expr = column_expr;
+            break;
+          }
+        }
+      }
+
+      const auto groupby_expression = SQLExpressionTranslator::translate_expression(*resolved_hsql_expr, input_node);
+      Assert(groupby_expression->type() == ExpressionType::Column || groupby_expression->is_arithmetic_operator(),
+             "Only columns and arithmetic expressions are supported in GROUP BY.");
+      groupby_expressions.emplace_back(groupby_expression);
+    }
+  }
+
   /**
    * The Aggregate Operator outputs all groupby columns first, and then all aggregates.
    * Therefore use this offset when setting up the ColumnIDs for the Projection that puts the columns in the right order.
@@ -668,41 +766,51 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_aggregate(
                                         "' is specified in SELECT list, but not in GROUP BY clause.");
 
       projections.push_back(Expression::create_column(static_cast<ColumnID>(selected_group_by_idx), alias));
+    } else if (column_expr->isType(hsql::kExprOperator)) {
+      // Expressions in the SELECT list have to be equal to one of the GROUP BY expressions, e.g., `a * 100 + b`
+      Assert(group_by != nullptr,
+             "SELECT list of aggregate contains an expression, but the query does not have a GROUP BY clause.");
+
+      const auto select_expression = SQLExpressionTranslator::translate_expression(*column_expr, input_node);
+      const auto groupby_expression_it =
+          std::find_if(groupby_expressions.cbegin(), groupby_expressions.cend(), [&](const auto& groupby_expression) {
+            return equals_without_alias(*groupby_expression, *select_expression);
+          });
+      Assert(groupby_expression_it != groupby_expressions.cend(),
+             "Expression '" + select_expression->to_string(input_node->output_column_names()) +
+                 "' is specified in SELECT list, but not in GROUP BY clause.");
+
+      const auto groupby_idx = std::distance(groupby_expressions.cbegin(), groupby_expression_it);
+      projections.push_back(Expression::create_column(static_cast<ColumnID>(groupby_idx), alias));
     } else {
       Fail("Unsupported item in projection list for AggregateOperator.");
     }
   }
 
   /**
-   * Collect the ColumnIDs to GROUP BY
+   * Collect the ColumnIDs to GROUP BY. If any of the GROUP BY expressions is not a plain column, a ProjectionNode
+   * appends the computed group keys to the input columns. As the input columns keep their ColumnIDs, the aggregate
+   * expressions remain valid.
    */
+  auto aggregate_input_node = input_node;
   std::vector<ColumnID> groupby_columns;
-  if (group_by != nullptr) {
-    groupby_columns.reserve(group_by->columns->size());
-    for (const auto* groupby_hsql_expr : *group_by->columns) {
-      if (!groupby_hsql_expr->isType(hsql::kExprColumnRef)) {
-        Fail("Grouping on complex expressions is not yet supported.");
-      }
+  groupby_columns.reserve(groupby_expressions.size());
 
-      // Some of the GROUP BY expressions may be aliases that were set in this aggregate node. Because the
-      // ProjectionNode that maps these aliases will only be added later, we will have to search the projections
-      // by hand here in order to find the column ids for GROUP BY.
-      bool found_aliased_column = false;
-      for (const auto& projection : projections) {
-        if (projection->alias() && *projection->alias() == groupby_hsql_expr->name) {
-          Assert(projection->type() == ExpressionType::Column, "Grouping on complex expressions is not yet supported.");
-          groupby_columns.emplace_back(projection->column_id());
-          found_aliased_column = true;
-          break;
-        }
-      }
-      if (found_aliased_column) continue;
-
-      groupby_columns.emplace_back(
-          SQLExpressionTranslator::get_column_id_for_expression(*groupby_hsql_expr, input_node));
+  auto groupby_column_expressions = Expression::create_columns(input_node->get_output_column_ids());
+  for (const auto& groupby_expression : groupby_expressions) {
+    if (groupby_expression->type() == ExpressionType::Column) {
+      groupby_columns.emplace_back(groupby_expression->column_id());
+    } else {
+      groupby_columns.emplace_back(static_cast<ColumnID::base_type>(groupby_column_expressions.size()));
+      groupby_column_expressions.emplace_back(groupby_expression);
     }
   }
 
+  if (groupby_column_expressions.size() > input_node->output_column_count()) {
+    aggregate_input_node = std::make_shared<ProjectionNode>(groupby_column_expressions);
+    aggregate_input_node->set_left_child(input_node);
+  }
+
   /**
    * Check for HAVING now, because it might contain more aggregations
    */
@@ -723,7 +831,7 @@ std::shared_ptr<AbstractLQPNode> SQLTranslator::_translate_aggregate(
   }
 
   auto aggregate_node = std::make_shared<AggregateNode>(aggregate_expressions, groupby_columns);
-  aggregate_node->set_left_child(input_node);
+  aggregate_node->set_left_child(aggregate_input_node);
 
   // Create a projection node for the correct column order
   auto projection_node = std::make_shared<ProjectionNode>(projections);
@@ -226,7 +226,7 @@ enum class JoinMode { Inner, Left, Right, Outer, Cross, Natural, Self, Semi, Ant
 
 enum class UnionMode { Positions };
 
-enum class AggregateFunction { Min, Max, Sum, Avg, Count, CountDistinct };
+enum class AggregateFunction { Min, Max, Sum, Avg, Count, CountDistinct, ApproxCountDistinct };
 
 enum class OrderByMode { Ascending, Descending, AscendingNullsLast, DescendingNullsLast };
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/*
+Insert-only, blocked Bloom filter on precomputed 32 bit hash values. Each hash value sets three bits within a single
+64 bit word, so that an insertion or a lookup touches only one cache line. With the default of 16 bits per element,
+the false positive rate is below 1%.
+
+The filter is used by JoinHash to drop probe rows that cannot find a join partner before they are partitioned
+(semi-join reduction). Inserting is thread-safe, so that the filter can be filled while materializing the build
+relation in parallel.
+*/
+class BloomFilter : private Noncopyable {
+ public:
+  explicit BloomFilter(const size_t expected_element_count, const size_t bits_per_element = 16) {
+    // Round the number of words up to the next power of two, so that a word can be selected using a shift
+    const auto min_word_count = std::max(size_t{1}, (expected_element_count * bits_per_element + 63) / 64);
+    while ((size_t{1} << _word_count_bits) < min_word_count) ++_word_count_bits;
+
+    _words = std::make_unique<std::atomic<uint64_t>[]>(size_t{1} << _word_count_bits);
+    for (size_t word_id = 0; word_id < (size_t{1} << _word_count_bits); ++word_id) {
+      _words[word_id].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void insert(const uint32_t hash) {
+    const auto scrambled_hash = _scramble(hash);
+    _words[_word_id(scrambled_hash)].fetch_or(_mask(scrambled_hash), std::memory_order_relaxed);
+  }
+
+  // Returns false if no element with the given hash was inserted. Might return true for elements that were not.
+  bool contains(const uint32_t hash) const {
+    const auto scrambled_hash = _scramble(hash);
+    const auto mask = _mask(scrambled_hash);
+    return (_words[_word_id(scrambled_hash)].load(std::memory_order_relaxed) & mask) == mask;
+  }
+
+ protected:
+  /*
+  The callers use the most significant bits of their hash values for radix partitioning. Multiplying with a large odd
+  constant (Fibonacci hashing) spreads all bits of the hash over the upper half of the result, so that the filter
+  does not depend on the bits that all elements of a partition share.
+  */
+  static uint64_t _scramble(const uint32_t hash) { return (hash | (uint64_t{hash} << 32)) * 0x9E3779B97F4A7C15ull; }
+
+  size_t _word_id(const uint64_t scrambled_hash) const {
+    if (_word_count_bits == 0) return 0;
+    return scrambled_hash >> (64 - _word_count_bits);
+  }
+
+  static uint64_t _mask(const uint64_t scrambled_hash) {
+    return (uint64_t{1} << (scrambled_hash & 63)) | (uint64_t{1} << ((scrambled_hash >> 6) & 63)) |
+           (uint64_t{1} << ((scrambled_hash >> 12) & 63));
+  }
+
+  size_t _word_count_bits = 0;
+  std::unique_ptr<std::atomic<uint64_t>[]> _words;
+};
+
+}  // namespace opossum
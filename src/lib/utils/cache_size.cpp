@@ -0,0 +1,19 @@
+#include "cache_size.hpp"
+
+#include <unistd.h>
+
+namespace opossum {
+
+size_t l2_cache_size() {
+  static const size_t default_l2_cache_size = 256 * 1024;
+
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  // Only determine the cache size once, as sysconf might have to parse /sys on every call
+  static const auto detected_l2_cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  if (detected_l2_cache_size > 0) return static_cast<size_t>(detected_l2_cache_size);
+#endif
+
+  return default_l2_cache_size;
+}
+
+}  // namespace opossum
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+namespace opossum {
+
+/**
+ * Returns the size of the L2 cache (per core) in bytes as reported by the operating system. If the size cannot be
+ * determined, a conservative default of 256 KiB is returned. Operators use this, e.g., to size radix partitions so
+ * that a partition and its auxiliary data structures fit into the cache.
+ */
+size_t l2_cache_size();
+
+}  // namespace opossum
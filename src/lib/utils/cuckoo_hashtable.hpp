@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -44,8 +47,7 @@ class HashTable : private Noncopyable {
         return;
       }
     }
-    auto element =
-        std::make_shared<HashElement>(HashElement{value, std::make_shared<PosList>(pmr_vector<RowID>{row_id})});
+    auto element = std::make_shared<HashElement>(value, std::make_shared<PosList>(pmr_vector<RowID>{row_id}));
     place(element, 0, 0);
   }
 
@@ -55,14 +57,36 @@ class HashTable : private Noncopyable {
   */
   template <typename S>
   std::shared_ptr<PosList> get(S value) {
-    for (size_t i = 0; i < NUMBER_OF_HASH_FUNCTIONS; i++) {
-      auto position = hash<S>(i, value);
-      auto element = _hashtables[i][position];
-      if (element != nullptr && value_equal(element->value, value)) {
-        return element->row_ids;
+    const auto element = find(value);
+    return element ? element->row_ids : nullptr;
+  }
+
+  /*
+  Like get(), but additionally marks the matching element. Joins that have to output the rows without a join partner
+  on the build side (e.g., full outer joins) use these marks as a bitmap of matched values. Can be called concurrently.
+  */
+  template <typename S>
+  std::shared_ptr<PosList> get_and_mark(S value) {
+    const auto element = find(value);
+    if (!element) return nullptr;
+
+    element->marked.store(true, std::memory_order_relaxed);
+    return element->row_ids;
+  }
+
+  /*
+  Calls func with the RowIDs of each element that has not been marked by get_and_mark().
+  */
+  template <typename Functor>
+  void for_each_unmarked(const Functor& func) const {
+    // Each element is stored in exactly one of the internal hash tables
+    for (const auto& hashtable : _hashtables) {
+      for (const auto& element : hashtable) {
+        if (element != nullptr && !element->marked.load(std::memory_order_relaxed)) {
+          func(*element->row_ids);
+        }
       }
     }
-    return nullptr;
   }
 
  protected:
@@ -70,10 +94,44 @@ class HashTable : private Noncopyable {
   We use this struct internally for storing data. It should not be exposed to other classes.
   */
   struct HashElement {
+    HashElement(const T& value, const std::shared_ptr<PosList>& row_ids) : value(value), row_ids(row_ids) {}
+
     T value;
     std::shared_ptr<PosList> row_ids;
+    std::atomic<bool> marked{false};
   };
 
+  /*
+  Returns the element storing the given value, or nullptr. The elements are placed by the hash of their value as T, so
+  numbers of a different type are converted to T first. Numbers without an exact representation as T cannot be stored.
+  */
+  template <typename S>
+  HashElement* find(S value) {
+    if constexpr (!std::is_same<S, T>::value && std::is_arithmetic<S>::value && std::is_arithmetic<T>::value) {
+      if constexpr (std::is_floating_point<S>::value && std::is_integral<T>::value) {
+        // The maximum of T is not exactly representable as S and would round up to a power of two outside of T
+        constexpr auto upper_bound = static_cast<S>(std::numeric_limits<T>::max() / 2 + 1) * S{2};
+        if (!(value >= static_cast<S>(std::numeric_limits<T>::lowest()) && value < upper_bound)) return nullptr;
+      } else {
+        if (!(value >= std::numeric_limits<T>::lowest() && value <= std::numeric_limits<T>::max())) return nullptr;
+      }
+
+      const auto converted_value = static_cast<T>(value);
+      if (static_cast<S>(converted_value) != value) return nullptr;
+
+      return find(converted_value);
+    } else {
+      for (size_t i = 0; i < NUMBER_OF_HASH_FUNCTIONS; i++) {
+        auto position = hash<S>(i, value);
+        const auto& element = _hashtables[i][position];
+        if (element != nullptr && value_equal(element->value, value)) {
+          return element.get();
+        }
+      }
+      return nullptr;
+    }
+  }
+
   /*
   function to place a key in one of its possible positions
   tableID: table in which key has to be placed, also equal
@@ -0,0 +1,18 @@
+#include "physical_memory.hpp"
+
+#include <unistd.h>
+
+namespace opossum {
+
+size_t physical_memory_size() {
+  static const size_t default_physical_memory_size = size_t{8} * 1024 * 1024 * 1024;
+
+  // Only determine the size once, as sysconf might have to parse /proc on every call
+  static const auto page_count = sysconf(_SC_PHYS_PAGES);
+  static const auto page_size = sysconf(_SC_PAGE_SIZE);
+  if (page_count <= 0 || page_size <= 0) return default_physical_memory_size;
+
+  return static_cast<size_t>(page_count) * static_cast<size_t>(page_size);
+}
+
+}  // namespace opossum
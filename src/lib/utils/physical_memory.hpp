@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace opossum {
+
+/**
+ * Returns the size of the main memory in bytes as reported by the operating system. If the size cannot be determined,
+ * 8 GiB are assumed. Operators use this to derive their default memory budgets.
+ */
+size_t physical_memory_size();
+
+}  // namespace opossum
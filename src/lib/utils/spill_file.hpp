@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/*
+Anonymous temporary file for operators that exceed their memory budget and have to move intermediate results out of
+main memory. Values are written in their binary representation, strings are prefixed with their length. The file is
+first written sequentially, then rewound and read back in the same order. It is deleted by the operating system once
+it is closed, i.e., when the SpillFile is destroyed or the process terminates.
+*/
+class SpillFile : private Noncopyable {
+ public:
+  SpillFile() : _file(std::tmpfile()) {
+    Assert(_file, "Could not create temporary file for spilling");
+    std::setvbuf(_file, nullptr, _IOFBF, BUFFER_SIZE);
+  }
+
+  ~SpillFile() { std::fclose(_file); }
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_standard_layout<T>::value && !std::is_pointer<T>::value, "Only plain values can be spilled");
+    _write(&value, sizeof(T));
+  }
+
+  void write(const std::string& value) {
+    const auto size = static_cast<uint32_t>(value.size());
+    _write(&size, sizeof(size));
+    _write(value.data(), size);
+  }
+
+  template <typename T>
+  void read(T& value) {
+    static_assert(std::is_standard_layout<T>::value && !std::is_pointer<T>::value, "Only plain values can be spilled");
+    _read(&value, sizeof(T));
+  }
+
+  void read(std::string& value) {
+    auto size = uint32_t{0};
+    _read(&size, sizeof(size));
+    value.resize(size);
+    _read(&value[0], size);
+  }
+
+  // Writes size bytes as they are, e.g., an array of plain values, which is read back by read_bytes()
+  void write_bytes(const void* data, const size_t size) { _write(data, size); }
+
+  void read_bytes(void* data, const size_t size) { _read(data, size); }
+
+  // Flushes the written data and moves back to the beginning of the file, so that it can be read
+  void rewind() { std::rewind(_file); }
+
+  // Number of bytes written to the file
+  size_t size() const { return _size; }
+
+ protected:
+  // The stdio buffer of each file. Larger buffers mean fewer system calls, but operators may have many open files.
+  static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+  void _write(const void* data, const size_t size) {
+    if (size == 0) return;
+    // The message is only built on failure, as this is called for every spilled value
+    if (std::fwrite(data, size, 1, _file) != 1) Fail("Could not write to spill file");
+    _size += size;
+  }
+
+  void _read(void* data, const size_t size) {
+    if (size == 0) return;
+    if (std::fread(data, size, 1, _file) != 1) Fail("Could not read from spill file");
+  }
+
+  std::FILE* _file;
+  size_t _size = 0;
+};
+
+}  // namespace opossum
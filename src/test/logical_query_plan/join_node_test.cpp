@@ -1,5 +1,6 @@
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -40,6 +41,38 @@ TEST_F(JoinNodeTest, Description) { EXPECT_EQ(_join_node->description(), "[Cross
 
 TEST_F(JoinNodeTest, DescriptionInnerJoin) { EXPECT_EQ(_inner_join_node->description(), "[Inner Join] t_a.a = t_b.y"); }
 
+TEST_F(JoinNodeTest, DescriptionCompositeKeyJoin) {
+  auto join_node = std::make_shared<JoinNode>(JoinMode::Inner, std::make_pair(ColumnID{0}, ColumnID{1}),
+                                              ScanType::Equals,
+                                              std::vector<std::pair<ColumnID, ColumnID>>{{ColumnID{1}, ColumnID{0}}});
+  join_node->set_left_child(_stored_table_node_a);
+  join_node->set_right_child(_stored_table_node_b);
+
+  EXPECT_EQ(join_node->description(), "[Inner Join] t_a.a = t_b.y AND t_a.b = t_b.x");
+
+  const auto copied_join_node = std::dynamic_pointer_cast<JoinNode>(join_node->deep_copy());
+  EXPECT_EQ(copied_join_node->additional_join_column_ids(), join_node->additional_join_column_ids());
+}
+
+TEST_F(JoinNodeTest, DescriptionBandJoin) {
+  auto join_node = std::make_shared<JoinNode>(JoinMode::Inner, std::make_pair(ColumnID{2}, ColumnID{0}), ColumnID{1});
+  join_node->set_left_child(_stored_table_node_a);
+  join_node->set_right_child(_stored_table_node_b);
+
+  EXPECT_EQ(join_node->description(), "[Inner Join] t_a.c BETWEEN t_b.x AND t_b.y");
+  EXPECT_EQ(join_node->scan_type(), ScanType::Between);
+
+  const auto copied_join_node = std::dynamic_pointer_cast<JoinNode>(join_node->deep_copy());
+  EXPECT_EQ(copied_join_node->upper_bound_column_id(), ColumnID{1});
+}
+
+TEST_F(JoinNodeTest, BandJoinRejectsSelfJoin) {
+  if (!IS_DEBUG) return;
+
+  EXPECT_THROW(std::make_shared<JoinNode>(JoinMode::Self, std::make_pair(ColumnID{2}, ColumnID{0}), ColumnID{1}),
+               std::logic_error);
+}
+
 TEST_F(JoinNodeTest, VerboseColumnNames) {
   EXPECT_EQ(_join_node->get_verbose_column_name(ColumnID{0}), "t_a.a");
   EXPECT_EQ(_join_node->get_verbose_column_name(ColumnID{1}), "t_a.b");
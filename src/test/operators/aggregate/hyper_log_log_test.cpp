@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <string>
+
+#include "../../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate/hyper_log_log.hpp"
+
+namespace opossum {
+
+class HyperLogLogTest : public BaseTest {};
+
+TEST_F(HyperLogLogTest, EmptySketch) { EXPECT_EQ(HyperLogLog{}.estimate(), 0u); }
+
+TEST_F(HyperLogLogTest, SmallCardinalitiesAreExact) {
+  auto sketch = HyperLogLog{};
+  for (auto repetition = 0; repetition < 3; ++repetition) {
+    for (auto value = int32_t{0}; value < 100; ++value) {
+      sketch.add(hyper_log_log_hash(value));
+    }
+  }
+
+  EXPECT_EQ(sketch.estimate(), 100u);
+}
+
+TEST_F(HyperLogLogTest, LargeCardinalities) {
+  for (const auto distinct_count : {1'000, 20'000, 1'000'000}) {
+    auto sketch = HyperLogLog{};
+    for (auto value = int64_t{0}; value < distinct_count; ++value) {
+      sketch.add(hyper_log_log_hash(value));
+      sketch.add(hyper_log_log_hash(value));
+    }
+
+    // Five times the standard error
+    EXPECT_NEAR(static_cast<double>(sketch.estimate()), distinct_count, distinct_count * 0.08);
+  }
+}
+
+TEST_F(HyperLogLogTest, MergeOverlappingSketches) {
+  auto sparse_sketch = HyperLogLog{};
+  auto dense_sketch_a = HyperLogLog{};
+  auto dense_sketch_b = HyperLogLog{};
+
+  for (auto value = 0; value < 50; ++value) {
+    sparse_sketch.add(hyper_log_log_hash(std::to_string(value)));
+  }
+  for (auto value = 0; value < 30'000; ++value) {
+    dense_sketch_a.add(hyper_log_log_hash(std::to_string(value)));
+  }
+  for (auto value = 20'000; value < 50'000; ++value) {
+    dense_sketch_b.add(hyper_log_log_hash(std::to_string(value)));
+  }
+
+  sparse_sketch.merge(dense_sketch_a);
+  sparse_sketch.merge(dense_sketch_b);
+  dense_sketch_a.merge(dense_sketch_b);
+
+  EXPECT_NEAR(static_cast<double>(sparse_sketch.estimate()), 50'000, 50'000 * 0.08);
+  EXPECT_EQ(sparse_sketch.estimate(), dense_sketch_a.estimate());
+}
+
+}  // namespace opossum
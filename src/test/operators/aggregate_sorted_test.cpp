@@ -0,0 +1,115 @@
+#include <memory>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/aggregate_sorted.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateSortedTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Sorted by a and b. The group (2, 20) spans three chunks, NULLs are sorted first.
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", DataType::Int, true);
+    table->add_column("b", DataType::Int);
+    table->add_column("c", DataType::String, true);
+    table->append({NULL_VALUE, 10, "n"});
+    table->append({1, 10, "x"});
+    table->append({1, 10, NULL_VALUE});
+    table->append({1, 20, "y"});
+    table->append({2, 20, "a"});
+    table->append({2, 20, "b"});
+    table->append({2, 20, "c"});
+    table->append({2, 20, "d"});
+    table->append({2, 20, "e"});
+    table->append({3, 10, "z"});
+    DictionaryCompression::compress_chunks(*table, {ChunkID{1}, ChunkID{3}});
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAggregateSortedTest, OperatorName) {
+  auto aggregate = std::make_shared<AggregateSorted>(
+      _table_wrapper, std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Sum}},
+      std::vector<ColumnID>{ColumnID{0}});
+
+  EXPECT_EQ(aggregate->name(), "AggregateSorted");
+}
+
+TEST_F(OperatorsAggregateSortedTest, GroupsSpanningChunks) {
+  const auto aggregates = std::vector<AggregateDefinition>{{ColumnID{2}, AggregateFunction::Max},
+                                                           {ColumnID{2}, AggregateFunction::Count},
+                                                           {CountStarID, AggregateFunction::Count}};
+  const auto groupby_column_ids = std::vector<ColumnID>{ColumnID{0}, ColumnID{1}};
+
+  auto aggregate = std::make_shared<AggregateSorted>(_table_wrapper, aggregates, groupby_column_ids);
+  aggregate->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::Int, true);
+  expected->add_column("b", DataType::Int, true);
+  expected->add_column("MAX(c)", DataType::String, true);
+  expected->add_column("COUNT(c)", DataType::Long);
+  expected->add_column("COUNT(*)", DataType::Long);
+  expected->append({NULL_VALUE, 10, "n", int64_t{1}, int64_t{1}});
+  expected->append({1, 10, "x", int64_t{1}, int64_t{2}});
+  expected->append({1, 20, "y", int64_t{1}, int64_t{1}});
+  expected->append({2, 20, "e", int64_t{5}, int64_t{5}});
+  expected->append({3, 10, "z", int64_t{1}, int64_t{1}});
+
+  EXPECT_TABLE_EQ_ORDERED(aggregate->get_output(), expected);
+
+  auto hash_aggregate = std::make_shared<Aggregate>(_table_wrapper, aggregates, groupby_column_ids);
+  hash_aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), hash_aggregate->get_output());
+}
+
+TEST_F(OperatorsAggregateSortedTest, SortedReferenceColumns) {
+  auto filtered = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::NotEquals, "c");
+  filtered->execute();
+  auto sorted = std::make_shared<Sort>(filtered, ColumnID{1}, OrderByMode::Descending, 2);
+  sorted->execute();
+
+  auto aggregate = std::make_shared<AggregateSorted>(
+      sorted, std::vector<AggregateDefinition>{{ColumnID{0}, AggregateFunction::Sum}},
+      std::vector<ColumnID>{ColumnID{1}});
+  aggregate->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("b", DataType::Int, true);
+  expected->add_column("SUM(a)", DataType::Long, true);
+  expected->append({20, int64_t{9}});
+  expected->append({10, int64_t{4}});
+
+  EXPECT_TABLE_EQ_ORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateSortedTest, EmptyInput) {
+  auto filtered = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::GreaterThan, 100);
+  filtered->execute();
+
+  auto aggregate = std::make_shared<AggregateSorted>(
+      filtered, std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Avg}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+
+  EXPECT_EQ(aggregate->get_output()->row_count(), 0u);
+  EXPECT_EQ(aggregate->get_output()->column_count(), 2u);
+  EXPECT_EQ(aggregate->get_output()->column_name(ColumnID{1}), "AVG(b)");
+}
+
+}  // namespace opossum
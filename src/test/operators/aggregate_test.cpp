@@ -15,8 +15,12 @@
 #include "operators/join_hash.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/print.hpp"
+#include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/dictionary_compression.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
@@ -533,4 +537,419 @@ TEST_F(OperatorsAggregateTest, OuterJoinThenAggregate) {
                     "src/test/tables/aggregateoperator/groupby_int_1gb_1agg/outer_join.tbl", 1, false);
 }
 
+TEST_F(OperatorsAggregateTest, ManySparseIntegerGroups) {
+  // The values are too far apart for the array of dense GroupIDs, so they are hashed
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", DataType::Long);
+  table->add_column("b", DataType::Int);
+  for (auto row = int64_t{0}; row < 10'000; ++row) {
+    table->append({(row % 2'500) * 1'000'003 - 1'000'000'000, static_cast<int32_t>(row)});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}, ChunkID{4}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::Long, true);
+  expected->add_column("COUNT(b)", DataType::Long);
+  expected->add_column("MIN(b)", DataType::Int, true);
+  for (auto group = int64_t{0}; group < 2'500; ++group) {
+    expected->append({group * 1'000'003 - 1'000'000'000, int64_t{4}, static_cast<int32_t>(group)});
+  }
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Count}, {ColumnID{1}, AggregateFunction::Min}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, DenseIntegerGroupsWithNegativeValuesAndNull) {
+  auto table = std::make_shared<Table>(3);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::Int);
+  for (const auto& value : std::vector<AllTypeVariant>{-2, 3, NULL_VALUE, -2, 0, 3, NULL_VALUE, 3}) {
+    table->append({value, 1});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::Int, true);
+  expected->add_column("SUM(b)", DataType::Long, true);
+  expected->append({-2, int64_t{2}});
+  expected->append({0, int64_t{1}});
+  expected->append({3, int64_t{3}});
+  expected->append({NULL_VALUE, int64_t{2}});
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper, std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Sum}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, FloatGroupsWithNegativeZero) {
+  auto table = std::make_shared<Table>();
+  table->add_column("a", DataType::Float);
+  table->append({0.0f});
+  table->append({-0.0f});
+  table->append({1.5f});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::Float, true);
+  expected->add_column("COUNT(*)", DataType::Long);
+  expected->append({0.0f, int64_t{2}});
+  expected->append({1.5f, int64_t{1}});
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper, std::vector<AggregateDefinition>{{CountStarID, AggregateFunction::Count}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, StringAndIntegerGroupsOnMixedEncodings) {
+  auto table = std::make_shared<Table>(2);
+  table->add_column("s", DataType::String, true);
+  table->add_column("i", DataType::Int);
+  table->append({"x", 1});
+  table->append({"y", 1});
+  table->append({"x", 1});
+  table->append({NULL_VALUE, 2});
+  table->append({"y", 1});
+  table->append({"x", 2});
+  table->append({NULL_VALUE, 2});
+  DictionaryCompression::compress_chunks(*table, {ChunkID{0}, ChunkID{2}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("s", DataType::String, true);
+  expected->add_column("i", DataType::Int, true);
+  expected->add_column("MAX(s)", DataType::String, true);
+  expected->append({"x", 1, "x"});
+  expected->append({"y", 1, "y"});
+  expected->append({"x", 2, "x"});
+  expected->append({NULL_VALUE, 2, NULL_VALUE});
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper, std::vector<AggregateDefinition>{{ColumnID{0}, AggregateFunction::Max}},
+      std::vector<ColumnID>{ColumnID{0}, ColumnID{1}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, NoGroupbyOnMixedEncodingsWithNull) {
+  auto table = std::make_shared<Table>(4);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::Int);
+  for (const auto& value : std::vector<AllTypeVariant>{3, NULL_VALUE, 3, 8, -4, 6, NULL_VALUE, -4, 1, 2, NULL_VALUE}) {
+    table->append({value, 1});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto aggregates = std::vector<AggregateDefinition>{
+      {ColumnID{0}, AggregateFunction::Min},   {ColumnID{0}, AggregateFunction::Max},
+      {ColumnID{0}, AggregateFunction::Sum},   {ColumnID{0}, AggregateFunction::Avg},
+      {ColumnID{0}, AggregateFunction::Count}, {ColumnID{0}, AggregateFunction::CountDistinct},
+      {ColumnID{1}, AggregateFunction::Sum},   {CountStarID, AggregateFunction::Count}};
+
+  const auto create_expected = [](const std::vector<AllTypeVariant>& row) {
+    auto expected = std::make_shared<Table>();
+    expected->add_column("MIN(a)", DataType::Int, true);
+    expected->add_column("MAX(a)", DataType::Int, true);
+    expected->add_column("SUM(a)", DataType::Long, true);
+    expected->add_column("AVG(a)", DataType::Double, true);
+    expected->add_column("COUNT(a)", DataType::Long);
+    expected->add_column("COUNT(DISTINCT a)", DataType::Long);
+    expected->add_column("SUM(b)", DataType::Long, true);
+    expected->add_column("COUNT(*)", DataType::Long);
+    expected->append(row);
+    return expected;
+  };
+
+  auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(),
+                            create_expected({-4, 8, int64_t{15}, 15.0 / 8, int64_t{8}, int64_t{6}, int64_t{11},
+                                             int64_t{11}}));
+
+  // On a ReferenceColumn, the values of the dictionary that are filtered out must not be used
+  auto filtered = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::GreaterThan, -4);
+  filtered->execute();
+
+  aggregate = std::make_shared<Aggregate>(filtered, aggregates, std::vector<ColumnID>{});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), create_expected({1, 8, int64_t{23}, 23.0 / 6, int64_t{6},
+                                                                      int64_t{5}, int64_t{6}, int64_t{6}}));
+}
+
+TEST_F(OperatorsAggregateTest, ApproxCountDistinct) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", DataType::Int);
+  table->add_column("b", DataType::String, true);
+  for (auto row = 0; row < 20'000; ++row) {
+    table->append({row % 2, row % 3 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{std::to_string(row % 9'000)}});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{0}, ChunkID{5}, ChunkID{6}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // With the grouping on a, each group has 3'000 distinct values of b. In total, there are 6'000.
+  for (const auto& groupby_column_ids : {std::vector<ColumnID>{ColumnID{0}}, std::vector<ColumnID>{}}) {
+    auto aggregate = std::make_shared<Aggregate>(
+        table_wrapper,
+        std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::ApproxCountDistinct},
+                                         {ColumnID{1}, AggregateFunction::CountDistinct}},
+        groupby_column_ids);
+    aggregate->execute();
+
+    const auto output = aggregate->get_output();
+    const auto approx_column_id = ColumnID{static_cast<ColumnID::base_type>(groupby_column_ids.size())};
+    EXPECT_EQ(output->column_name(approx_column_id), "APPROX_COUNT_DISTINCT(b)");
+    EXPECT_EQ(output->column_type(approx_column_id), DataType::Long);
+    EXPECT_FALSE(output->column_is_nullable(approx_column_id));
+    ASSERT_EQ(output->row_count(), groupby_column_ids.empty() ? 1u : 2u);
+
+    for (auto row = size_t{0}; row < output->row_count(); ++row) {
+      const auto exact_count = type_cast<int64_t>((*output->get_chunk(ChunkID{0}).get_column(
+          ColumnID{static_cast<ColumnID::base_type>(approx_column_id + 1)}))[row]);
+      const auto approx_count =
+          type_cast<int64_t>((*output->get_chunk(ChunkID{0}).get_column(approx_column_id))[row]);
+
+      EXPECT_EQ(exact_count, groupby_column_ids.empty() ? 6'000 : 3'000);
+      EXPECT_NEAR(static_cast<double>(approx_count), exact_count, exact_count * 0.08);
+    }
+  }
+}
+
+TEST_F(OperatorsAggregateTest, GroupByValueIDsWithDifferentDictionaries) {
+  // Each chunk has its own dictionary, so the same value has different ValueIDs in different chunks
+  auto table = std::make_shared<Table>(3);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::Double, true);
+  table->append({5, 1.0});
+  table->append({1, 2.0});
+  table->append({NULL_VALUE, 4.0});
+  table->append({9, 8.0});
+  table->append({5, NULL_VALUE});
+  table->append({7, 16.0});
+  table->append({7, 32.0});
+  table->append({1, NULL_VALUE});
+  DictionaryCompression::compress_table(*table);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::Int, true);
+  expected->add_column("SUM(b)", DataType::Double, true);
+  expected->add_column("COUNT(b)", DataType::Long);
+  expected->add_column("COUNT(*)", DataType::Long);
+  expected->append({1, 2.0, int64_t{1}, int64_t{2}});
+  expected->append({5, 1.0, int64_t{1}, int64_t{2}});
+  expected->append({7, 48.0, int64_t{2}, int64_t{2}});
+  expected->append({9, 8.0, int64_t{1}, int64_t{1}});
+  expected->append({NULL_VALUE, 4.0, int64_t{1}, int64_t{1}});
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Sum},
+                                       {ColumnID{1}, AggregateFunction::Count},
+                                       {CountStarID, AggregateFunction::Count}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, GroupByStringValueIDsWithScheduler) {
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+
+  auto table = std::make_shared<Table>(700);
+  table->add_column("a", DataType::String);
+  table->add_column("b", DataType::Int);
+  for (auto row = 0; row < 10'000; ++row) {
+    table->append({std::to_string(row % 3'000), row});
+  }
+  DictionaryCompression::compress_table(*table);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::String, true);
+  expected->add_column("MIN(b)", DataType::Int, true);
+  expected->add_column("COUNT(DISTINCT b)", DataType::Long);
+  for (auto group = 0; group < 3'000; ++group) {
+    expected->append({std::to_string(group), group, int64_t{group < 1'000 ? 4 : 3}});
+  }
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Min},
+                                       {ColumnID{1}, AggregateFunction::CountDistinct}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+TEST_F(OperatorsAggregateTest, ManyGroupsWithScheduler) {
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+
+  // Enough local groups to be merged in several partitions
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", DataType::String);
+  table->add_column("b", DataType::Int);
+  for (auto row = 0; row < 20'000; ++row) {
+    table->append({std::to_string(row % 5'000), row});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{0}, ChunkID{3}, ChunkID{17}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", DataType::String, true);
+  expected->add_column("COUNT(*)", DataType::Long);
+  expected->add_column("MAX(b)", DataType::Int, true);
+  expected->add_column("COUNT(DISTINCT b)", DataType::Long);
+  for (auto group = 0; group < 5'000; ++group) {
+    expected->append({std::to_string(group), int64_t{4}, group + 15'000, int64_t{4}});
+  }
+
+  auto aggregate = std::make_shared<Aggregate>(
+      table_wrapper,
+      std::vector<AggregateDefinition>{{CountStarID, AggregateFunction::Count},
+                                       {ColumnID{1}, AggregateFunction::Max},
+                                       {ColumnID{1}, AggregateFunction::CountDistinct}},
+      std::vector<ColumnID>{ColumnID{0}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected);
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+TEST_F(OperatorsAggregateTest, ColumnExpressions) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", DataType::Int);
+  table->add_column("b", DataType::Int, true);
+  for (auto row = 0; row < 1'000; ++row) {
+    table->append({row % 7, row % 10 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{row % 3}});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{0}, ChunkID{1}, ChunkID{5}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // a, b, a * 100 + b, b * 2
+  const auto a_times_100 = Expression::create_binary_operator(
+      ExpressionType::Multiplication, Expression::create_column(ColumnID{0}), Expression::create_literal(100));
+  const auto column_expressions = Projection::ColumnExpressions{
+      Expression::create_column(ColumnID{0}), Expression::create_column(ColumnID{1}),
+      Expression::create_binary_operator(ExpressionType::Addition, a_times_100, Expression::create_column(ColumnID{1})),
+      Expression::create_binary_operator(ExpressionType::Multiplication, Expression::create_column(ColumnID{1}),
+                                         Expression::create_literal(2), std::string{"b_times_2"})};
+
+  auto projection = std::make_shared<Projection>(table_wrapper, column_expressions);
+  projection->execute();
+
+  const auto aggregates = std::vector<AggregateDefinition>{{ColumnID{3}, AggregateFunction::Sum},
+                                                           {ColumnID{3}, AggregateFunction::CountDistinct},
+                                                           {CountStarID, AggregateFunction::Count}};
+
+  // Grouping by a computed column, by a passed-through dictionary-encoded column, and by both
+  for (const auto& groupby_column_ids : std::vector<std::vector<ColumnID>>{
+           {ColumnID{2}}, {ColumnID{0}}, {ColumnID{2}, ColumnID{0}}, {}}) {
+    auto expected_aggregate = std::make_shared<Aggregate>(projection, aggregates, groupby_column_ids);
+    expected_aggregate->execute();
+
+    auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, groupby_column_ids, column_expressions);
+    aggregate->execute();
+
+    EXPECT_EQ(aggregate->get_output()->column_names(), expected_aggregate->get_output()->column_names());
+    EXPECT_TABLE_EQ_UNORDERED(aggregate->get_output(), expected_aggregate->get_output());
+  }
+
+  auto aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{2}},
+                                               column_expressions);
+  aggregate->execute();
+  EXPECT_EQ(aggregate->get_output()->column_name(ColumnID{0}), "(a * 100) + b");
+  EXPECT_EQ(aggregate->get_output()->column_name(ColumnID{1}), "SUM(b_times_2)");
+  // NULL keys form a single group
+  EXPECT_EQ(aggregate->get_output()->row_count(), 7u * 3u + 1u);
+}
+
+TEST_F(OperatorsAggregateTest, SpillGroupsExceedingMemoryBudget) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("s", DataType::String, true);
+  table->add_column("f", DataType::Float, true);
+  table->add_column("i", DataType::Int);
+  for (auto row = 0; row < 10'000; ++row) {
+    const auto s = row % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{std::to_string(row % 1'500)};
+    const auto f = row % 11 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row % 2 == 0 ? -0.0f : 0.0f)};
+    table->append({s, f, row});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{0}, ChunkID{4}, ChunkID{5}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto filtered = std::make_shared<TableScan>(table_wrapper, ColumnID{2}, ScanType::GreaterThanEquals, 500);
+  filtered->execute();
+
+  const auto aggregates = std::vector<AggregateDefinition>{{ColumnID{2}, AggregateFunction::Avg, "avg_i"},
+                                                           {ColumnID{2}, AggregateFunction::CountDistinct},
+                                                           {ColumnID{0}, AggregateFunction::Max},
+                                                           {CountStarID, AggregateFunction::Count}};
+  const auto groupby_column_ids = std::vector<ColumnID>{ColumnID{1}, ColumnID{0}};
+
+  for (const auto& input : std::vector<std::shared_ptr<AbstractOperator>>{table_wrapper, filtered}) {
+    auto in_memory_aggregate = std::make_shared<Aggregate>(input, aggregates, groupby_column_ids);
+    in_memory_aggregate->execute();
+
+    // A budget of a single byte makes Aggregate spill to the maximum number of files
+    auto spilling_aggregate =
+        std::make_shared<Aggregate>(input, aggregates, groupby_column_ids, Projection::ColumnExpressions{}, 1);
+    spilling_aggregate->execute();
+
+    const auto output = spilling_aggregate->get_output();
+    EXPECT_GT(output->chunk_count(), 1u);
+    EXPECT_EQ(output->column_name(ColumnID{2}), "avg_i");
+    EXPECT_TRUE(output->column_is_nullable(ColumnID{0}));
+    EXPECT_TABLE_EQ_UNORDERED(output, in_memory_aggregate->get_output());
+  }
+}
+
+TEST_F(OperatorsAggregateTest, SpillDictionaryEncodedGroups) {
+  auto table = std::make_shared<Table>(700);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::Long);
+  for (auto row = 0; row < 5'000; ++row) {
+    table->append({row % 13 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{row % 2'000}, int64_t{row}});
+  }
+  DictionaryCompression::compress_table(*table);
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto aggregates =
+      std::vector<AggregateDefinition>{{ColumnID{1}, AggregateFunction::Sum}, {ColumnID{1}, AggregateFunction::Min}};
+
+  auto in_memory_aggregate = std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}});
+  in_memory_aggregate->execute();
+
+  auto spilling_aggregate =
+      std::make_shared<Aggregate>(table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}},
+                                  Projection::ColumnExpressions{}, 10'000);
+  spilling_aggregate->execute();
+
+  EXPECT_GT(spilling_aggregate->get_output()->chunk_count(), 1u);
+  EXPECT_TABLE_EQ_UNORDERED(spilling_aggregate->get_output(), in_memory_aggregate->get_output());
+}
+
 }  // namespace opossum
@@ -0,0 +1,195 @@
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/join_band.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class JoinBandTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto points = std::make_shared<Table>(3);
+    points->add_column("point", DataType::Int, true);
+    for (const auto& value : std::vector<AllTypeVariant>{1, 5, 10, NULL_VALUE, 15, 7}) {
+      points->append({value});
+    }
+    _table_wrapper_points = std::make_shared<TableWrapper>(points);
+    _table_wrapper_points->execute();
+
+    _table_wrapper_intervals = std::make_shared<TableWrapper>(_create_intervals());
+    _table_wrapper_intervals->execute();
+  }
+
+  static std::shared_ptr<Table> _create_intervals() {
+    auto intervals = std::make_shared<Table>(2);
+    intervals->add_column("lower", DataType::Int, true);
+    intervals->add_column("upper", DataType::Int, true);
+    intervals->append({0, 5});
+    intervals->append({5, 8});
+    intervals->append({9, 9});
+    intervals->append({20, 30});
+    intervals->append({NULL_VALUE, 10});
+    intervals->append({6, 2});
+    return intervals;
+  }
+
+  static std::shared_ptr<Table> _create_expected_table(const std::vector<std::vector<AllTypeVariant>>& rows,
+                                                       const bool with_intervals = true) {
+    auto table = std::make_shared<Table>();
+    table->add_column("point", DataType::Int, true);
+    if (with_intervals) {
+      table->add_column("lower", DataType::Int, true);
+      table->add_column("upper", DataType::Int, true);
+    }
+    for (const auto& row : rows) {
+      table->append(row);
+    }
+    return table;
+  }
+
+  std::shared_ptr<const Table> _join(const JoinMode mode) const {
+    auto join = std::make_shared<JoinBand>(_table_wrapper_points, _table_wrapper_intervals, mode,
+                                           std::make_pair(ColumnID{0}, ColumnID{0}), ColumnID{1});
+    join->execute();
+    return join->get_output();
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_points, _table_wrapper_intervals;
+};
+
+TEST_F(JoinBandTest, InnerJoin) {
+  const auto expected = _create_expected_table({{1, 0, 5}, {5, 0, 5}, {5, 5, 8}, {7, 5, 8}});
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Inner), expected);
+}
+
+TEST_F(JoinBandTest, LeftJoin) {
+  const auto expected = _create_expected_table({{1, 0, 5},
+                                                {5, 0, 5},
+                                                {5, 5, 8},
+                                                {7, 5, 8},
+                                                {10, NULL_VALUE, NULL_VALUE},
+                                                {15, NULL_VALUE, NULL_VALUE},
+                                                {NULL_VALUE, NULL_VALUE, NULL_VALUE}});
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Left), expected);
+}
+
+TEST_F(JoinBandTest, RightJoin) {
+  const auto expected = _create_expected_table({{1, 0, 5},
+                                                {5, 0, 5},
+                                                {5, 5, 8},
+                                                {7, 5, 8},
+                                                {NULL_VALUE, 9, 9},
+                                                {NULL_VALUE, 20, 30},
+                                                {NULL_VALUE, NULL_VALUE, 10},
+                                                {NULL_VALUE, 6, 2}});
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Right), expected);
+}
+
+TEST_F(JoinBandTest, OuterJoin) {
+  const auto expected = _create_expected_table({{1, 0, 5},
+                                                {5, 0, 5},
+                                                {5, 5, 8},
+                                                {7, 5, 8},
+                                                {10, NULL_VALUE, NULL_VALUE},
+                                                {15, NULL_VALUE, NULL_VALUE},
+                                                {NULL_VALUE, NULL_VALUE, NULL_VALUE},
+                                                {NULL_VALUE, 9, 9},
+                                                {NULL_VALUE, 20, 30},
+                                                {NULL_VALUE, NULL_VALUE, 10},
+                                                {NULL_VALUE, 6, 2}});
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Outer), expected);
+}
+
+TEST_F(JoinBandTest, SemiJoin) {
+  const auto expected = _create_expected_table({{1}, {5}, {7}}, false);
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Semi), expected);
+}
+
+TEST_F(JoinBandTest, AntiJoin) {
+  const auto expected = _create_expected_table({{10}, {15}}, false);
+  EXPECT_TABLE_EQ_UNORDERED(_join(JoinMode::Anti), expected);
+}
+
+TEST_F(JoinBandTest, ReferenceAndDictionaryInputs) {
+  auto intervals = _create_intervals();
+  DictionaryCompression::compress_chunks(*intervals, {ChunkID{0}, ChunkID{2}});
+  auto table_wrapper_intervals = std::make_shared<TableWrapper>(intervals);
+  table_wrapper_intervals->execute();
+
+  auto scan_points = std::make_shared<TableScan>(_table_wrapper_points, ColumnID{0}, ScanType::GreaterThan, 1);
+  scan_points->execute();
+  auto scan_intervals =
+      std::make_shared<TableScan>(table_wrapper_intervals, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_intervals->execute();
+
+  auto join = std::make_shared<JoinBand>(scan_points, scan_intervals, JoinMode::Left,
+                                         std::make_pair(ColumnID{0}, ColumnID{0}), ColumnID{1});
+  join->execute();
+
+  const auto expected = _create_expected_table(
+      {{5, 0, 5}, {5, 5, 8}, {7, 5, 8}, {10, NULL_VALUE, NULL_VALUE}, {15, NULL_VALUE, NULL_VALUE}});
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected);
+}
+
+TEST_F(JoinBandTest, MatchesNestedLoopOnManyChunks) {
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int32_t>{0, 1'000};
+
+  auto points = std::make_shared<Table>(100);
+  points->add_column("point", DataType::Int);
+  for (auto row = 0; row < 1'000; ++row) {
+    points->append({distribution(generator)});
+  }
+  auto table_wrapper_points = std::make_shared<TableWrapper>(points);
+  table_wrapper_points->execute();
+
+  auto intervals = std::make_shared<Table>(30);
+  intervals->add_column("lower", DataType::Int);
+  intervals->add_column("upper", DataType::Int);
+  for (auto row = 0; row < 300; ++row) {
+    const auto lower = distribution(generator);
+    intervals->append({lower, lower + distribution(generator) / 50});
+  }
+  auto table_wrapper_intervals = std::make_shared<TableWrapper>(intervals);
+  table_wrapper_intervals->execute();
+
+  auto band_join = std::make_shared<JoinBand>(table_wrapper_points, table_wrapper_intervals, JoinMode::Inner,
+                                              std::make_pair(ColumnID{0}, ColumnID{0}), ColumnID{1});
+  band_join->execute();
+
+  auto nested_loop = std::make_shared<JoinNestedLoop>(table_wrapper_points, table_wrapper_intervals, JoinMode::Inner,
+                                                      std::make_pair(ColumnID{0}, ColumnID{0}),
+                                                      ScanType::GreaterThanEquals);
+  nested_loop->execute();
+  auto scan_upper = std::make_shared<TableScan>(nested_loop, ColumnID{0}, ScanType::LessThanEquals, ColumnID{2});
+  scan_upper->execute();
+
+  EXPECT_GT(band_join->get_output()->row_count(), 0u);
+  EXPECT_TABLE_EQ_UNORDERED(band_join->get_output(), scan_upper->get_output());
+}
+
+TEST_F(JoinBandTest, DifferentBoundTypes) {
+  auto intervals = std::make_shared<Table>();
+  intervals->add_column("lower", DataType::Int);
+  intervals->add_column("upper", DataType::Float);
+  intervals->append({0, 5.f});
+  auto table_wrapper_intervals = std::make_shared<TableWrapper>(intervals);
+  table_wrapper_intervals->execute();
+
+  auto join = std::make_shared<JoinBand>(_table_wrapper_points, table_wrapper_intervals, JoinMode::Inner,
+                                         std::make_pair(ColumnID{0}, ColumnID{0}), ColumnID{1});
+  EXPECT_THROW(join->execute(), std::logic_error);
+}
+
+}  // namespace opossum
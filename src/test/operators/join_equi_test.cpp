@@ -15,7 +15,9 @@
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
 #include "operators/union_all.hpp"
+#include "storage/reference_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -60,9 +62,6 @@ TYPED_TEST(JoinEquiTest, RightJoin) {
 }
 
 TYPED_TEST(JoinEquiTest, OuterJoin) {
-  if (std::is_same<TypeParam, JoinHash>::value) {
-    return;
-  }
   this->template test_join_output<TypeParam>(
       this->_table_wrapper_a, this->_table_wrapper_b, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
       ScanType::Equals, JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join.tbl", 1);
@@ -243,6 +242,35 @@ TYPED_TEST(JoinEquiTest, MultiJoinOnReferenceRight) {
       "src/test/tables/joinoperators/int_inner_multijoin_ref_ref_ref_right.tbl", 1);
 }
 
+TYPED_TEST(JoinEquiTest, OutputColumnsShareResolvedPosLists) {
+  auto scan_a = std::make_shared<TableScan>(this->_table_wrapper_f, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_a->execute();
+
+  auto join = std::make_shared<TypeParam>(scan_a, this->_table_wrapper_g, JoinMode::Inner,
+                                          std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  join->execute();
+
+  const auto output = join->get_output();
+  ASSERT_EQ(output->column_count(), 4u);
+
+  for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    if (chunk.size() == 0) continue;
+
+    auto columns = std::vector<std::shared_ptr<const ReferenceColumn>>{};
+    for (ColumnID column_id{0}; column_id < output->column_count(); ++column_id) {
+      columns.emplace_back(std::dynamic_pointer_cast<const ReferenceColumn>(chunk.get_column(column_id)));
+      ASSERT_NE(columns.back(), nullptr);
+    }
+
+    // The positions of the scanned input are resolved to the stored table once for both of its columns
+    EXPECT_EQ(columns[0]->referenced_table(), this->_table_wrapper_f->get_output());
+    EXPECT_EQ(columns[0]->pos_list(), columns[1]->pos_list());
+    EXPECT_EQ(columns[2]->referenced_table(), this->_table_wrapper_g->get_output());
+    EXPECT_EQ(columns[2]->pos_list(), columns[3]->pos_list());
+  }
+}
+
 TYPED_TEST(JoinEquiTest, MultiJoinOnReferenceLeftFiltered) {
   // scan that returns all rows
   auto scan_a = std::make_shared<TableScan>(this->_table_wrapper_f, ColumnID{0}, ScanType::GreaterThan, 6);
@@ -342,6 +370,50 @@ TYPED_TEST(JoinEquiTest, LeftJoinEmptyRefColumn) {
       JoinMode::Left, "src/test/tables/joinoperators/int_join_empty_left.tbl", 1);
 }
 
+TYPED_TEST(JoinEquiTest, InnerCompositeKeyJoin) {
+  // Join on a = a (int and long), b = b (string) and c = c (int, left side with NULLs)
+  auto left = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_left.tbl", 2));
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_right.tbl", 3));
+  right->execute();
+
+  this->template test_join_output<TypeParam>(
+      left, right, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), ScanType::Equals, JoinMode::Inner,
+      "src/test/tables/joinoperators/composite_key_inner_join.tbl", 1,
+      {std::make_pair(ColumnID{1}, ColumnID{1}), std::make_pair(ColumnID{2}, ColumnID{2})});
+}
+
+TYPED_TEST(JoinEquiTest, LeftCompositeKeyJoin) {
+  auto left = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_left.tbl", 2));
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_right.tbl", 3));
+  right->execute();
+
+  this->template test_join_output<TypeParam>(
+      left, right, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), ScanType::Equals, JoinMode::Left,
+      "src/test/tables/joinoperators/composite_key_left_join.tbl", 1,
+      {std::make_pair(ColumnID{1}, ColumnID{1}), std::make_pair(ColumnID{2}, ColumnID{2})});
+}
+
+TYPED_TEST(JoinEquiTest, InnerRefCompositeKeyJoin) {
+  auto left = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_left.tbl", 2));
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(load_table("src/test/tables/joinoperators/composite_key_right.tbl", 3));
+  right->execute();
+
+  // scans that return all rows
+  auto scan_left = std::make_shared<TableScan>(left, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_left->execute();
+  auto scan_right = std::make_shared<TableScan>(right, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_right->execute();
+
+  // The order of the column pairs does not matter
+  this->template test_join_output<TypeParam>(
+      scan_left, scan_right, std::pair<ColumnID, ColumnID>(ColumnID{2}, ColumnID{2}), ScanType::Equals,
+      JoinMode::Inner, "src/test/tables/joinoperators/composite_key_inner_join.tbl", 1,
+      {std::make_pair(ColumnID{1}, ColumnID{1}), std::make_pair(ColumnID{0}, ColumnID{0})});
+}
+
 // Does not work yet due to problems with RowID implementation (RowIDs need to reference a table)
 TYPED_TEST(JoinEquiTest, DISABLED_JoinOnUnion /* #160 */) {
   //  Filtering to generate RefColumns
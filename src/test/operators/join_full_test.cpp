@@ -10,6 +10,7 @@
 #include "join_test.hpp"
 
 #include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/table_scan.hpp"
@@ -422,4 +423,35 @@ TYPED_TEST(JoinFullTest, JoinOnDictAndReferenceColumn) {
       ScanType::NotEquals, JoinMode::Inner, "src/test/tables/joinoperators/int_inner_join_neq.tbl", 1);
 }
 
+TYPED_TEST(JoinFullTest, OuterJoinOnManyChunkPairs) {
+  // Large enough for JoinNestedLoop to split the chunk pairs of each left chunk into multiple jobs
+  auto left_table = std::make_shared<Table>(2'000);
+  left_table->add_column("a", DataType::Int);
+  for (auto value = 0; value < 4'000; ++value) {
+    left_table->append({value});
+  }
+
+  auto right_table = std::make_shared<Table>(1'000);
+  right_table->add_column("b", DataType::Int);
+  for (auto value = 3'000; value < 7'000; ++value) {
+    right_table->append({value});
+  }
+
+  auto left = std::make_shared<TableWrapper>(left_table);
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+
+  auto expected_join = std::make_shared<JoinHash>(left, right, JoinMode::Outer,
+                                                  std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  expected_join->execute();
+
+  auto join = std::make_shared<TypeParam>(left, right, JoinMode::Outer, std::make_pair(ColumnID{0}, ColumnID{0}),
+                                          ScanType::Equals);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 7'000u);
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_join->get_output());
+}
+
 }  // namespace opossum
@@ -0,0 +1,410 @@
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+#include "join_test.hpp"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_nested_loop.hpp"
+#include "operators/join_sort_merge.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "optimizer/expression.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/*
+This contains the tests that are specific to JoinHash, e.g., the choice of radix bits or spilling to disk.
+The general join tests for JoinHash can be found in join_equi_test.cpp and join_semi_anti_test.cpp.
+*/
+
+class JoinHashTest : public JoinTest {
+ protected:
+  void SetUp() override {
+    JoinTest::SetUp();
+
+    // String tables with all chunks dictionary-encoded, so that the join can use the ValueIDs
+    auto table = load_table("src/test/tables/int_string.tbl", 4);
+    DictionaryCompression::compress_table(*table);
+    _table_wrapper_c_string_dict = std::make_shared<TableWrapper>(std::move(table));
+    _table_wrapper_c_string_dict->execute();
+
+    table = load_table("src/test/tables/string_int.tbl", 3);
+    DictionaryCompression::compress_table(*table);
+    _table_wrapper_d_string_dict = std::make_shared<TableWrapper>(std::move(table));
+    _table_wrapper_d_string_dict->execute();
+  }
+
+  // Runs the join with no partitioning, a single partitioning pass, and two partitioning passes
+  void test_join_output_with_radix_bits(const std::shared_ptr<const AbstractOperator> left,
+                                        const std::shared_ptr<const AbstractOperator> right,
+                                        const std::pair<ColumnID, ColumnID>& column_ids, const JoinMode mode,
+                                        const std::string& file_name) {
+    std::shared_ptr<Table> expected_result = load_table(file_name, 1);
+
+    for (const auto radix_bits : {size_t{0}, size_t{3}, JoinHash::MAX_RADIX_BITS_PER_PASS + 3}) {
+      auto join = std::make_shared<JoinHash>(left, right, mode, column_ids, ScanType::Equals,
+                                             std::vector<std::pair<ColumnID, ColumnID>>{}, radix_bits);
+      join->execute();
+
+      EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
+    }
+  }
+
+  // Runs the join with memory budgets that force it to spill its inputs to disk. A budget of one byte is exceeded by
+  // every partition, so that the partitions are recursively split up until the maximum recursion depth is reached.
+  void test_join_output_with_memory_budgets(const std::shared_ptr<const AbstractOperator> left,
+                                            const std::shared_ptr<const AbstractOperator> right,
+                                            const std::pair<ColumnID, ColumnID>& column_ids, const JoinMode mode,
+                                            const std::string& file_name) {
+    std::shared_ptr<Table> expected_result = load_table(file_name, 1);
+
+    for (const auto memory_budget : {size_t{1}, size_t{256}}) {
+      auto join = std::make_shared<JoinHash>(left, right, mode, column_ids, ScanType::Equals,
+                                             std::vector<std::pair<ColumnID, ColumnID>>{}, std::nullopt, memory_budget);
+      join->execute();
+
+      EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
+    }
+  }
+
+  // Compares inner and semi joins of the probe relation with a smaller build relation, in memory and spilled to disk,
+  // with JoinNestedLoop. The build keys have to be unique, as the semi join result is the probe side of the inner join.
+  void test_join_output_against_nested_loop(const std::shared_ptr<const AbstractOperator> probe,
+                                            const std::shared_ptr<const AbstractOperator> build,
+                                            const size_t expected_row_count) {
+    const auto column_ids = std::make_pair(ColumnID{0}, ColumnID{0});
+    auto expected_join = std::make_shared<JoinNestedLoop>(probe, build, JoinMode::Inner, column_ids, ScanType::Equals);
+    expected_join->execute();
+
+    auto probe_column_ids = std::vector<ColumnID>{};
+    for (ColumnID column_id{0}; column_id < probe->get_output()->column_count(); ++column_id) {
+      probe_column_ids.emplace_back(column_id);
+    }
+    auto expected_semi_join = std::make_shared<Projection>(expected_join, Expression::create_columns(probe_column_ids));
+    expected_semi_join->execute();
+
+    for (const auto memory_budget : {std::optional<size_t>{}, std::optional<size_t>{1}}) {
+      for (const auto mode : {JoinMode::Inner, JoinMode::Semi}) {
+        auto join = std::make_shared<JoinHash>(probe, build, mode, column_ids, ScanType::Equals,
+                                               std::vector<std::pair<ColumnID, ColumnID>>{}, std::nullopt,
+                                               memory_budget);
+        join->execute();
+
+        EXPECT_EQ(join->get_output()->row_count(), expected_row_count);
+        EXPECT_TABLE_EQ_UNORDERED(join->get_output(), mode == JoinMode::Inner ? expected_join->get_output()
+                                                                              : expected_semi_join->get_output());
+      }
+    }
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_c_string_dict, _table_wrapper_d_string_dict;
+};
+
+TEST_F(JoinHashTest, CalculateRadixBits) {
+  const auto cache_size = size_t{256 * 1024};
+
+  EXPECT_EQ(JoinHash::calculate_radix_bits(0, cache_size), 0u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(1'000, cache_size), 0u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(cache_size, cache_size), 0u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(cache_size + 1, cache_size), 1u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(cache_size * 256, cache_size), 8u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(cache_size * 256 + 1, cache_size), 9u);
+  EXPECT_EQ(JoinHash::calculate_radix_bits(size_t{1} << 40, cache_size), JoinHash::MAX_RADIX_BITS);
+}
+
+TEST_F(JoinHashTest, InnerJoinWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Inner,
+                                   "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerJoinOnStringWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_c, _table_wrapper_d, {ColumnID{1}, ColumnID{0}}, JoinMode::Inner,
+                                   "src/test/tables/joinoperators/string_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerRefJoinFilteredWithRadixBits) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::GreaterThan, 1000);
+  scan_a->execute();
+  auto scan_b = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_b->execute();
+
+  test_join_output_with_radix_bits(scan_a, scan_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Inner,
+                                   "src/test/tables/joinoperators/int_inner_join_filtered.tbl");
+}
+
+TEST_F(JoinHashTest, LeftJoinWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Left,
+                                   "src/test/tables/joinoperators/int_left_join.tbl");
+}
+
+TEST_F(JoinHashTest, RightJoinWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Right,
+                                   "src/test/tables/joinoperators/int_right_join.tbl");
+}
+
+TEST_F(JoinHashTest, OuterJoinWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Outer,
+                                   "src/test/tables/joinoperators/int_outer_join.tbl");
+}
+
+TEST_F(JoinHashTest, OuterJoinWithNullWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_m, _table_wrapper_n, {ColumnID{0}, ColumnID{0}}, JoinMode::Outer,
+                                   "src/test/tables/joinoperators/int_outer_join_null.tbl");
+}
+
+TEST_F(JoinHashTest, SemiJoinWithRadixBits) {
+  test_join_output_with_radix_bits(_table_wrapper_k, _table_wrapper_a, {ColumnID{0}, ColumnID{0}}, JoinMode::Semi,
+                                   "src/test/tables/int.tbl");
+}
+
+TEST_F(JoinHashTest, InnerJoinWithSkewedInput) {
+  // 90% of the rows of the larger (i.e., probe) relation share one join key, so that its partition is split up
+  auto skewed_table = std::make_shared<Table>(1'000);
+  skewed_table->add_column("a", DataType::Int);
+  for (auto row = 0; row < 5'000; ++row) {
+    skewed_table->append({row % 10 == 0 ? row : 1});
+  }
+
+  auto keys_table = std::make_shared<Table>();
+  keys_table->add_column("b", DataType::Int);
+  for (auto key = 0; key < 500; ++key) {
+    keys_table->append({key});
+  }
+
+  auto skewed_wrapper = std::make_shared<TableWrapper>(skewed_table);
+  skewed_wrapper->execute();
+  auto keys_wrapper = std::make_shared<TableWrapper>(keys_table);
+  keys_wrapper->execute();
+
+  auto expected_join = std::make_shared<JoinSortMerge>(skewed_wrapper, keys_wrapper, JoinMode::Inner,
+                                                       std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  expected_join->execute();
+
+  for (const auto radix_bits : {size_t{3}, JoinHash::MAX_RADIX_BITS_PER_PASS + 3}) {
+    auto join = std::make_shared<JoinHash>(skewed_wrapper, keys_wrapper, JoinMode::Inner,
+                                           std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals,
+                                           std::vector<std::pair<ColumnID, ColumnID>>{}, radix_bits);
+    join->execute();
+
+    EXPECT_EQ(join->get_output()->row_count(), 4'550u);
+    EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_join->get_output());
+  }
+}
+
+TEST_F(JoinHashTest, InnerJoinOnDictionaryStrings) {
+  test_join_output_with_radix_bits(_table_wrapper_c_string_dict, _table_wrapper_d_string_dict,
+                                   {ColumnID{1}, ColumnID{0}}, JoinMode::Inner,
+                                   "src/test/tables/joinoperators/string_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, LeftJoinOnDictionaryStrings) {
+  test_join_output_with_radix_bits(_table_wrapper_c_string_dict, _table_wrapper_d_string_dict,
+                                   {ColumnID{1}, ColumnID{0}}, JoinMode::Left,
+                                   "src/test/tables/joinoperators/string_left_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerJoinOnDictionaryAndValueStrings) {
+  // Only one input is dictionary-encoded, so the strings are materialized
+  test_join_output_with_radix_bits(_table_wrapper_c, _table_wrapper_d_string_dict, {ColumnID{1}, ColumnID{0}},
+                                   JoinMode::Inner, "src/test/tables/joinoperators/string_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, SelfJoinOnSharedDictionaries) {
+  auto expected_join = std::make_shared<JoinHash>(_table_wrapper_c, _table_wrapper_c, JoinMode::Self,
+                                                  std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::Equals);
+  expected_join->execute();
+
+  auto join = std::make_shared<JoinHash>(_table_wrapper_c_string_dict, _table_wrapper_c_string_dict, JoinMode::Self,
+                                         std::make_pair(ColumnID{1}, ColumnID{1}), ScanType::Equals);
+  join->execute();
+
+  EXPECT_EQ(join->get_output()->row_count(), 12u);
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_join->get_output());
+}
+
+TEST_F(JoinHashTest, DefaultMemoryBudget) { EXPECT_GT(JoinHash::default_memory_budget(), 0u); }
+
+TEST_F(JoinHashTest, InnerJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Inner, "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerJoinOnStringWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_c, _table_wrapper_d, {ColumnID{1}, ColumnID{0}},
+                                       JoinMode::Inner, "src/test/tables/joinoperators/string_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerJoinOnDictionaryStringsWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_c_string_dict, _table_wrapper_d_string_dict,
+                                       {ColumnID{1}, ColumnID{0}}, JoinMode::Inner,
+                                       "src/test/tables/joinoperators/string_inner_join.tbl");
+}
+
+TEST_F(JoinHashTest, InnerRefJoinFilteredWithMemoryBudget) {
+  auto scan_a = std::make_shared<TableScan>(_table_wrapper_a, ColumnID{0}, ScanType::GreaterThan, 1000);
+  scan_a->execute();
+  auto scan_b = std::make_shared<TableScan>(_table_wrapper_b, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_b->execute();
+
+  test_join_output_with_memory_budgets(scan_a, scan_b, {ColumnID{0}, ColumnID{0}}, JoinMode::Inner,
+                                       "src/test/tables/joinoperators/int_inner_join_filtered.tbl");
+}
+
+TEST_F(JoinHashTest, LeftJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Left, "src/test/tables/joinoperators/int_left_join.tbl");
+}
+
+TEST_F(JoinHashTest, RightJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Right, "src/test/tables/joinoperators/int_right_join.tbl");
+}
+
+TEST_F(JoinHashTest, OuterJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_a, _table_wrapper_b, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join.tbl");
+}
+
+TEST_F(JoinHashTest, OuterJoinWithNullWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_m, _table_wrapper_n, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join_null.tbl");
+}
+
+TEST_F(JoinHashTest, SemiJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_k, _table_wrapper_a, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Semi, "src/test/tables/int.tbl");
+}
+
+TEST_F(JoinHashTest, AntiJoinWithMemoryBudget) {
+  test_join_output_with_memory_budgets(_table_wrapper_k, _table_wrapper_a, {ColumnID{0}, ColumnID{0}},
+                                       JoinMode::Anti, "src/test/tables/joinoperators/anti_int4.tbl");
+}
+
+TEST_F(JoinHashTest, SelectiveBuildSideWithBloomFilter) {
+  // Only 1% of the probe rows find a join partner, all others are dropped by the Bloom filter of the build relation
+  auto probe_table = std::make_shared<Table>(500);
+  probe_table->add_column("a", DataType::Int);
+  probe_table->add_column("b", DataType::Int);
+  for (auto row = 0; row < 2'000; ++row) {
+    probe_table->append({row % 1'000, row});
+  }
+
+  auto build_table = std::make_shared<Table>(5);
+  build_table->add_column("a", DataType::Int);
+  for (auto key = 0; key < 1'000; key += 100) {
+    build_table->append({key});
+  }
+
+  auto probe = std::make_shared<TableWrapper>(probe_table);
+  probe->execute();
+  auto build = std::make_shared<TableWrapper>(build_table);
+  build->execute();
+
+  test_join_output_against_nested_loop(probe, build, 20);
+}
+
+TEST_F(JoinHashTest, DifferentKeyTypesWithoutBloomFilter) {
+  // The hash values of an int and a long key differ, so the Bloom filter must not be used to drop probe rows
+  auto probe_table = std::make_shared<Table>(50);
+  probe_table->add_column("a", DataType::Long);
+  for (auto row = int64_t{0}; row < 200; ++row) {
+    probe_table->append({row});
+  }
+
+  auto build_table = std::make_shared<Table>(5);
+  build_table->add_column("a", DataType::Int);
+  for (auto key = 0; key < 200; key += 20) {
+    build_table->append({key});
+  }
+
+  auto probe = std::make_shared<TableWrapper>(probe_table);
+  probe->execute();
+  auto build = std::make_shared<TableWrapper>(build_table);
+  build->execute();
+
+  test_join_output_against_nested_loop(probe, build, 10);
+
+  // Requested radix bits are ignored, as matching keys of different types would end up in different partitions
+  auto join = std::make_shared<JoinHash>(probe, build, JoinMode::Inner, std::make_pair(ColumnID{0}, ColumnID{0}),
+                                         ScanType::Equals, std::vector<std::pair<ColumnID, ColumnID>>{}, 3);
+  join->execute();
+  EXPECT_EQ(join->get_output()->row_count(), 10u);
+}
+
+TEST_F(JoinHashTest, DoubleKeysOutOfRangeOfLongKeys) {
+  // 2^63 is just above the largest long. It must neither match nor be converted to a long.
+  auto probe_table = std::make_shared<Table>();
+  probe_table->add_column("a", DataType::Double);
+  for (const auto value : {9223372036854775808.0, 1e19, -1e19, 4611686018427387904.0, -9223372036854775808.0}) {
+    probe_table->append({value});
+  }
+
+  auto build_table = std::make_shared<Table>();
+  build_table->add_column("a", DataType::Long);
+  for (const auto value : {std::numeric_limits<int64_t>::min(), int64_t{4611686018427387904}, int64_t{0}}) {
+    build_table->append({value});
+  }
+
+  auto probe = std::make_shared<TableWrapper>(probe_table);
+  probe->execute();
+  auto build = std::make_shared<TableWrapper>(build_table);
+  build->execute();
+
+  test_join_output_against_nested_loop(probe, build, 2);
+}
+
+TEST_F(JoinHashTest, SpillWithFewFileDescriptors) {
+  // Enough distinct keys for every spill partition on every recursion level to receive rows
+  auto left_table = std::make_shared<Table>(5'000);
+  left_table->add_column("a", DataType::Int);
+  auto right_table = std::make_shared<Table>(5'000);
+  right_table->add_column("b", DataType::Int);
+  for (auto row = 0; row < 20'000; ++row) {
+    left_table->append({row});
+    right_table->append({(row * 3) % 30'000});
+  }
+  auto left = std::make_shared<TableWrapper>(left_table);
+  left->execute();
+  auto right = std::make_shared<TableWrapper>(right_table);
+  right->execute();
+
+  const auto column_ids = std::make_pair(ColumnID{0}, ColumnID{0});
+  auto in_memory_join = std::make_shared<JoinHash>(left, right, JoinMode::Inner, column_ids, ScanType::Equals);
+  in_memory_join->execute();
+
+  // Spilling with a budget of one byte must not run out of file descriptors under a common limit. The original limit is
+  // restored even if the join fails.
+  struct FileDescriptorLimit {
+    explicit FileDescriptorLimit(const rlim_t limit) {
+      getrlimit(RLIMIT_NOFILE, &original_limit);
+      auto low_limit = original_limit;
+      low_limit.rlim_cur = std::min(original_limit.rlim_cur, limit);
+      setrlimit(RLIMIT_NOFILE, &low_limit);
+    }
+    ~FileDescriptorLimit() { setrlimit(RLIMIT_NOFILE, &original_limit); }
+
+    rlimit original_limit{};
+  };
+
+  auto spilling_join =
+      std::make_shared<JoinHash>(left, right, JoinMode::Inner, column_ids, ScanType::Equals,
+                                 std::vector<std::pair<ColumnID, ColumnID>>{}, std::nullopt, 1);
+  {
+    const auto file_descriptor_limit = FileDescriptorLimit{512};
+    spilling_join->execute();
+  }
+
+  EXPECT_TABLE_EQ_UNORDERED(spilling_join->get_output(), in_memory_join->get_output());
+}
+
+}  // namespace opossum
@@ -0,0 +1,185 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+#include "join_test.hpp"
+
+#include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
+#include "operators/table_scan.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/index/adaptive_radix_tree/adaptive_radix_tree_index.hpp"
+#include "storage/index/group_key/composite_group_key_index.hpp"
+#include "storage/index/group_key/group_key_index.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/*
+This contains the tests for the index nested loop join. The right inputs are dictionary-compressed and indexed
+versions of the tables used in the other join tests, so the same expected results apply.
+*/
+
+template <typename DerivedIndex>
+class JoinIndexTest : public JoinTest {
+ protected:
+  void SetUp() override {
+    JoinTest::SetUp();
+
+    _table_wrapper_a_indexed = _create_indexed_table("src/test/tables/int_float.tbl", {ChunkID{0}, ChunkID{1}});
+    _table_wrapper_b_indexed = _create_indexed_table("src/test/tables/int_float2.tbl", {ChunkID{0}, ChunkID{1}});
+
+    // Only the first chunk is indexed, the second one has to be joined using a nested loop
+    _table_wrapper_b_partially_indexed = _create_indexed_table("src/test/tables/int_float2.tbl", {ChunkID{0}});
+  }
+
+  static std::shared_ptr<TableWrapper> _create_indexed_table(const std::string& file_name,
+                                                             const std::vector<ChunkID>& indexed_chunk_ids) {
+    auto table = load_table(file_name, 2);
+    DictionaryCompression::compress_table(*table);
+
+    for (const auto chunk_id : indexed_chunk_ids) {
+      auto& chunk = table->get_chunk(chunk_id);
+      for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+        chunk.template create_index<DerivedIndex>(std::vector<ColumnID>{column_id});
+      }
+    }
+
+    auto table_wrapper = std::make_shared<TableWrapper>(std::move(table));
+    table_wrapper->execute();
+    return table_wrapper;
+  }
+
+  void test_index_join_output(const std::shared_ptr<const AbstractOperator> left,
+                              const std::shared_ptr<const AbstractOperator> right,
+                              const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type,
+                              const JoinMode mode, const std::string& file_name) {
+    auto expected_result = load_table(file_name, 1);
+
+    auto join = std::make_shared<JoinIndex>(left, right, mode, column_ids, scan_type);
+    join->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_result);
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper_a_indexed, _table_wrapper_b_indexed, _table_wrapper_b_partially_indexed;
+};
+
+using DerivedIndices = ::testing::Types<GroupKeyIndex, CompositeGroupKeyIndex, AdaptiveRadixTreeIndex>;
+TYPED_TEST_CASE(JoinIndexTest, DerivedIndices);
+
+TYPED_TEST(JoinIndexTest, InnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::Equals, JoinMode::Inner, "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, InnerRefJoin) {
+  // scan that returns all rows
+  auto scan_a = std::make_shared<TableScan>(this->_table_wrapper_a, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_a->execute();
+
+  this->test_index_join_output(scan_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}}, ScanType::Equals,
+                               JoinMode::Inner, "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, InnerJoinOnUnindexedRightInput) {
+  // The indices of the stored table cannot be used for the reference table produced by the scan
+  auto scan_b =
+      std::make_shared<TableScan>(this->_table_wrapper_b_indexed, ColumnID{0}, ScanType::GreaterThanEquals, 0);
+  scan_b->execute();
+
+  this->test_index_join_output(this->_table_wrapper_a, scan_b, {ColumnID{0}, ColumnID{0}}, ScanType::Equals,
+                               JoinMode::Inner, "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, InnerJoinOnPartiallyIndexedRightInput) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_partially_indexed,
+                               {ColumnID{0}, ColumnID{0}}, ScanType::Equals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, LeftJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::Equals, JoinMode::Left, "src/test/tables/joinoperators/int_left_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, SemiJoin) {
+  this->test_index_join_output(this->_table_wrapper_k, this->_table_wrapper_a_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::Equals, JoinMode::Semi, "src/test/tables/int.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, AntiJoin) {
+  this->test_index_join_output(this->_table_wrapper_k, this->_table_wrapper_a_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::Equals, JoinMode::Anti, "src/test/tables/joinoperators/anti_int4.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, AntiJoinWithNullableLeftInput) {
+  // Left rows with a NULL key must not be emitted, exactly as in JoinHash
+  auto join_index = std::make_shared<JoinIndex>(this->_table_wrapper_m, this->_table_wrapper_a_indexed, JoinMode::Anti,
+                                                std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  join_index->execute();
+
+  auto join_hash = std::make_shared<JoinHash>(this->_table_wrapper_m, this->_table_wrapper_a_indexed, JoinMode::Anti,
+                                              std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  join_hash->execute();
+
+  EXPECT_EQ(join_index->get_output()->row_count(), 1u);
+  EXPECT_TABLE_EQ_UNORDERED(join_index->get_output(), join_hash->get_output());
+}
+
+TYPED_TEST(JoinIndexTest, NotEqualInnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::NotEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_notequal_inner_join.tbl");
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{1}, ColumnID{1}},
+                               ScanType::NotEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/float_notequal_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, SmallerInnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::LessThan, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_smaller_inner_join.tbl");
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{1}, ColumnID{1}},
+                               ScanType::LessThan, JoinMode::Inner,
+                               "src/test/tables/joinoperators/float_smaller_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, SmallerEqualInnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::LessThanEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_smallerequal_inner_join.tbl");
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{1}, ColumnID{1}},
+                               ScanType::LessThanEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/float_smallerequal_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, GreaterInnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::GreaterThan, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_greater_inner_join.tbl");
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{1}, ColumnID{1}},
+                               ScanType::GreaterThan, JoinMode::Inner,
+                               "src/test/tables/joinoperators/float_greater_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, GreaterEqualInnerJoin) {
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{0}, ColumnID{0}},
+                               ScanType::GreaterThanEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/int_greaterequal_inner_join.tbl");
+  this->test_index_join_output(this->_table_wrapper_a, this->_table_wrapper_b_indexed, {ColumnID{1}, ColumnID{1}},
+                               ScanType::GreaterThanEquals, JoinMode::Inner,
+                               "src/test/tables/joinoperators/float_greaterequal_inner_join.tbl");
+}
+
+TYPED_TEST(JoinIndexTest, UnsupportedJoinMode) {
+  EXPECT_THROW(std::make_shared<JoinIndex>(this->_table_wrapper_a, this->_table_wrapper_b_indexed, JoinMode::Outer,
+                                           std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}), ScanType::Equals),
+               std::logic_error);
+}
+
+}  // namespace opossum
@@ -139,6 +139,18 @@ TYPED_TEST(JoinNullTest, RightJoinWithNullAsInnerDict) {
                                              "src/test/tables/joinoperators/int_right_join_null_inner.tbl", 1);
 }
 
+TYPED_TEST(JoinNullTest, OuterJoinWithNull) {
+  this->template test_join_output<TypeParam>(
+      this->_table_wrapper_m, this->_table_wrapper_n, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
+      ScanType::Equals, JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join_null.tbl", 1);
+}
+
+TYPED_TEST(JoinNullTest, OuterJoinWithNullDict) {
+  this->template test_join_output<TypeParam>(
+      this->_table_wrapper_m_dict, this->_table_wrapper_n_dict, std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
+      ScanType::Equals, JoinMode::Outer, "src/test/tables/joinoperators/int_outer_join_null.tbl", 1);
+}
+
 TYPED_TEST(JoinNullTest, SelfJoinWithNullDict) {
   this->template test_join_output<TypeParam>(this->_table_wrapper_a_null_dict, this->_table_wrapper_a_null_dict,
                                              std::pair<ColumnID, ColumnID>(ColumnID{0}, ColumnID{0}),
@@ -92,13 +92,14 @@ class JoinTest : public BaseTest {
   void test_join_output(const std::shared_ptr<const AbstractOperator> left,
                         const std::shared_ptr<const AbstractOperator> right,
                         const std::pair<ColumnID, ColumnID>& column_ids, const ScanType scan_type, const JoinMode mode,
-                        const std::string& file_name, size_t chunk_size) {
+                        const std::string& file_name, size_t chunk_size,
+                        const std::vector<std::pair<ColumnID, ColumnID>>& additional_column_ids = {}) {
     // load expected results from file
     std::shared_ptr<Table> expected_result = load_table(file_name, chunk_size);
     EXPECT_NE(expected_result, nullptr) << "Could not load expected result table";
 
     // build and execute join
-    auto join = std::make_shared<JoinType>(left, right, mode, column_ids, scan_type);
+    auto join = std::make_shared<JoinType>(left, right, mode, column_ids, scan_type, additional_column_ids);
     EXPECT_NE(join, nullptr) << "Could not build Join";
     join->execute();
 
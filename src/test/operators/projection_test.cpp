@@ -311,4 +311,76 @@ TEST_F(OperatorsProjectionTest, OperatorName) {
   EXPECT_EQ(projection_1->name(), "Projection");
 }
 
+TEST_F(OperatorsProjectionTest, ArithmeticOnManyBatchesWithNullsAndLiterals) {
+  auto table = std::make_shared<Table>(3'000);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::Int);
+  table->add_column("c", DataType::Int);
+  for (auto row = 0; row < 7'000; ++row) {
+    table->append({row % 7 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{row % 13 - 6}, row % 101, row});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{2}, ScanType::GreaterThanEquals, 500);
+  scan->execute();
+
+  const auto a = Expression::create_column(ColumnID{0});
+  const auto b = Expression::create_column(ColumnID{1});
+  const auto c = Expression::create_column(ColumnID{2});
+
+  // a * b + c, (c / a) % 5 with NULL and zero divisors, b - (2 * 3), and b + (NULL - 1)
+  const auto expressions = Projection::ColumnExpressions{
+      Expression::create_binary_operator(ExpressionType::Addition,
+                                         Expression::create_binary_operator(ExpressionType::Multiplication, a, b), c),
+      Expression::create_binary_operator(ExpressionType::Modulo,
+                                         Expression::create_binary_operator(ExpressionType::Division, c, a),
+                                         Expression::create_literal(5)),
+      Expression::create_binary_operator(
+          ExpressionType::Subtraction, b,
+          Expression::create_binary_operator(ExpressionType::Multiplication, Expression::create_literal(2),
+                                             Expression::create_literal(3))),
+      Expression::create_binary_operator(
+          ExpressionType::Addition, b,
+          Expression::create_binary_operator(ExpressionType::Subtraction, Expression::create_literal(NULL_VALUE),
+                                             Expression::create_literal(1)))};
+
+  for (const auto& input : std::vector<std::shared_ptr<AbstractOperator>>{table_wrapper, scan}) {
+    auto projection = std::make_shared<Projection>(input, expressions);
+    projection->execute();
+    const auto output = projection->get_output();
+    ASSERT_EQ(output->row_count(), input->get_output()->row_count());
+
+    auto row_count = size_t{0};
+    for (ChunkID chunk_id{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto& input_chunk = input->get_output()->get_chunk(chunk_id);
+      const auto& output_chunk = output->get_chunk(chunk_id);
+
+      for (ChunkOffset chunk_offset{0}; chunk_offset < output_chunk.size(); ++chunk_offset) {
+        const auto row = type_cast<int>((*input_chunk.get_column(ColumnID{2}))[chunk_offset]);
+        const auto a_value = row % 13 - 6;
+        const auto b_value = row % 101;
+        const auto a_is_null = row % 7 == 0;
+
+        const auto sum = (*output_chunk.get_column(ColumnID{0}))[chunk_offset];
+        const auto modulo = (*output_chunk.get_column(ColumnID{1}))[chunk_offset];
+        if (a_is_null) {
+          EXPECT_TRUE(variant_is_null(sum));
+          EXPECT_TRUE(variant_is_null(modulo));
+        } else {
+          EXPECT_EQ(type_cast<int>(sum), a_value * b_value + row);
+          if (a_value != 0) {
+            EXPECT_EQ(type_cast<int>(modulo), (row / a_value) % 5);
+          }
+        }
+        EXPECT_EQ(type_cast<int>((*output_chunk.get_column(ColumnID{2}))[chunk_offset]), b_value - 6);
+        EXPECT_TRUE(variant_is_null((*output_chunk.get_column(ColumnID{3}))[chunk_offset]));
+        ++row_count;
+      }
+    }
+    EXPECT_EQ(row_count, output->row_count());
+  }
+}
+
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -13,6 +14,7 @@
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
@@ -143,6 +145,24 @@ TEST_F(RecreationTest, RecreationSort) {
   EXPECT_TABLE_EQ_UNORDERED(recreated_sort->get_output(), expected_result);
 }
 
+TEST_F(RecreationTest, RecreationTopK) {
+  // build and execute top k
+  auto top_k = std::make_shared<TopK>(_table_wrapper_a, std::vector<SortColumnDefinition>{{ColumnID{0}}}, 2u, 1u);
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->row_count(), 2u);
+
+  // recreate and execute recreated top k
+  auto recreated_top_k = std::dynamic_pointer_cast<TopK>(top_k->recreate());
+  ASSERT_NE(recreated_top_k, nullptr) << "Could not recreate TopK";
+  EXPECT_EQ(recreated_top_k->k(), 2u);
+
+  // table wrapper needs to be executed manually
+  recreated_top_k->mutable_input_left()->execute();
+  recreated_top_k->execute();
+  EXPECT_EQ(recreated_top_k->get_output()->chunk_count(), 2u);
+  EXPECT_TABLE_EQ_ORDERED(recreated_top_k->get_output(), top_k->get_output());
+}
+
 TEST_F(RecreationTest, RecreationTableScan) {
   std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_filtered2.tbl", 1);
 
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort/parallel_merge_sort.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+
+namespace opossum {
+
+class ParallelMergeSortTest : public BaseTest {
+ protected:
+  // Pairs of a value with many duplicates and the original position
+  static std::vector<std::pair<int, size_t>> _generate_values(const size_t count) {
+    auto random_engine = std::default_random_engine{17};
+    auto distribution = std::uniform_int_distribution<int>{-50, 50};
+
+    auto values = std::vector<std::pair<int, size_t>>{};
+    for (auto position = size_t{0}; position < count; ++position) {
+      values.emplace_back(distribution(random_engine), position);
+    }
+    return values;
+  }
+};
+
+TEST_F(ParallelMergeSortTest, MergePathSplit) {
+  const auto first = std::vector<int>{1, 3, 3, 5};
+  const auto second = std::vector<int>{2, 3, 4};
+  const auto less = std::less<int>{};
+
+  // The stable merge is 1 2 3 3 3 4 5, where the 3s of the first run come before that of the second
+  const auto expected_first_counts = std::vector<size_t>{0, 1, 1, 2, 3, 3, 3, 4};
+  for (auto output_offset = size_t{0}; output_offset <= first.size() + second.size(); ++output_offset) {
+    EXPECT_EQ(merge_path_split(first.cbegin(), first.cend(), second.cbegin(), second.cend(), output_offset, less),
+              expected_first_counts[output_offset]);
+  }
+}
+
+TEST_F(ParallelMergeSortTest, SortsWithAndWithoutScheduler) {
+  // Compare by value and position, which is a strict total order
+  const auto less = [](const auto& left, const auto& right) { return left < right; };
+
+  for (const auto use_scheduler : {false, true}) {
+    if (use_scheduler) {
+      CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+    }
+
+    for (const auto count : {size_t{0}, size_t{3}, size_t{1'000}, size_t{10'007}}) {
+      for (const auto run_count : {size_t{1}, size_t{2}, size_t{5}, size_t{8}}) {
+        auto values = _generate_values(count);
+        auto expected = values;
+        std::sort(expected.begin(), expected.end());
+
+        parallel_merge_sort(values, less, run_count);
+        EXPECT_EQ(values, expected);
+      }
+    }
+
+    if (use_scheduler) {
+      CurrentScheduler::get()->finish();
+      CurrentScheduler::set(nullptr);
+    }
+  }
+}
+
+}  // namespace opossum
@@ -1,6 +1,10 @@
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -10,9 +14,14 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/union_all.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
 #include "storage/dictionary_compression.hpp"
+#include "storage/reference_column.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
+#include "storage/value_column.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -130,6 +139,97 @@ TEST_F(OperatorsSortTest, MultipleColumnSortIsStableMixedOrder) {
   EXPECT_TABLE_EQ_ORDERED(sort_after_a->get_output(), expected_result);
 }
 
+TEST_F(OperatorsSortTest, MultipleColumnsInOneSort) {
+  auto table_wrapper = std::make_shared<TableWrapper>(load_table("src/test/tables/int_float4.tbl", 2));
+  table_wrapper->execute();
+
+  auto sort = std::make_shared<Sort>(
+      table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Ascending}, {ColumnID{1}}}, 2u);
+  sort->execute();
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), load_table("src/test/tables/int_float2_sorted.tbl", 2));
+
+  auto sort_mixed = std::make_shared<Sort>(
+      table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}}, {ColumnID{1}, OrderByMode::Descending}}, 2u);
+  sort_mixed->execute();
+  EXPECT_TABLE_EQ_ORDERED(sort_mixed->get_output(), load_table("src/test/tables/int_float2_sorted_mixed.tbl", 2));
+}
+
+TEST_F(OperatorsSortTest, MultipleColumnsWithNullsAndStrings) {
+  auto table = std::make_shared<Table>(3);
+  table->add_column("s", DataType::String, true);
+  table->add_column("i", DataType::Int);
+  table->add_column("f", DataType::Float);
+  table->append({"b", 1, 1.5f});
+  table->append({NULL_VALUE, 2, -1.0f});
+  table->append({"a", 3, 2.0f});
+  table->append({"ab", 1, 0.0f});
+  table->append({"b", -4, -0.0f});
+  table->append({"a", 3, -2.5f});
+  table->append({NULL_VALUE, -1, 3.0f});
+  table->append({"", 7, 1.0f});
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{1}, ScanType::NotEquals, 100);
+  scan->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("s", DataType::String, true);
+  expected->add_column("i", DataType::Int);
+  expected->add_column("f", DataType::Float);
+  expected->append({"", 7, 1.0f});
+  expected->append({"a", 3, -2.5f});
+  expected->append({"a", 3, 2.0f});
+  expected->append({"ab", 1, 0.0f});
+  expected->append({"b", 1, 1.5f});
+  expected->append({"b", -4, -0.0f});
+  expected->append({NULL_VALUE, 2, -1.0f});
+  expected->append({NULL_VALUE, -1, 3.0f});
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::AscendingNullsLast},
+                                                                  {ColumnID{1}, OrderByMode::Descending},
+                                                                  {ColumnID{2}, OrderByMode::Ascending}};
+  for (const auto& input : std::vector<std::shared_ptr<AbstractOperator>>{table_wrapper, scan}) {
+    auto sort = std::make_shared<Sort>(input, sort_definitions, 3u);
+    sort->execute();
+    EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected);
+  }
+}
+
+TEST_F(OperatorsSortTest, MultipleColumnsWithScheduler) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::String);
+  table->add_column("c", DataType::Int);
+  for (auto row = 0; row < 50'000; ++row) {
+    table->append({row % 13 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row * 7) % 101},
+                   std::to_string(row % 17), row});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{3}, ChunkID{10}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::DescendingNullsLast},
+                                                                  {ColumnID{1}, OrderByMode::Ascending}};
+
+  auto expected_sort = std::make_shared<Sort>(table_wrapper, sort_definitions);
+  expected_sort->execute();
+
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+
+  auto sort = std::make_shared<Sort>(table_wrapper, sort_definitions);
+  sort->execute();
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+
+  // Column c makes the rows unique, so this also checks that the parallel sort is stable
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_sort->get_output());
+  EXPECT_EQ(sort->get_output()->get_value<int>(ColumnID{2}, 0u), 476);
+}
+
 TEST_F(OperatorsSortTest, AscendingSortOfOneColumnWithNull) {
   std::shared_ptr<Table> expected_result = load_table("src/test/tables/int_float_null_sorted_asc.tbl", 2);
 
@@ -225,4 +325,146 @@ TEST_F(OperatorsSortTest, SortTableWithRefandValueColumns) {
       load_table("src/test/tables/int_float__int_float2_filtered__union__sorted.tbl", Chunk::MAX_SIZE));
 }
 
+TEST_F(OperatorsSortTest, SortReferenceColumnsWithNullRowIDsIntoMultipleChunks) {
+  // The reference columns point into a value and a dictionary chunk and contain NULL_ROW_IDs, as after an outer join
+  const auto table = load_table("src/test/tables/int_float_w_null_8_rows.tbl", 4);
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}});
+
+  auto ref_table = std::make_shared<Table>();
+  ref_table->add_column_definition("a", DataType::Int, true);
+  ref_table->add_column_definition("b", DataType::Float, true);
+
+  const auto add_reference_chunk = [&](const PosList& pos_list_a, const PosList& pos_list_b) {
+    auto chunk = Chunk{};
+    chunk.add_column(std::make_shared<ReferenceColumn>(table, ColumnID{0}, std::make_shared<PosList>(pos_list_a)));
+    chunk.add_column(std::make_shared<ReferenceColumn>(table, ColumnID{1}, std::make_shared<PosList>(pos_list_b)));
+    ref_table->emplace_chunk(std::move(chunk));
+  };
+  add_reference_chunk({RowID{ChunkID{1}, 1u}, RowID{ChunkID{0}, 0u}, RowID{ChunkID{0}, 2u}},
+                      {RowID{ChunkID{1}, 0u}, NULL_ROW_ID, RowID{ChunkID{0}, 1u}});
+  add_reference_chunk({RowID{ChunkID{1}, 2u}, RowID{ChunkID{0}, 3u}}, {RowID{ChunkID{1}, 3u}, RowID{ChunkID{0}, 0u}});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(ref_table);
+  table_wrapper->execute();
+
+  auto expected_result = std::make_shared<Table>();
+  expected_result->add_column("a", DataType::Int, true);
+  expected_result->add_column("b", DataType::Float, true);
+  expected_result->append({NULL_VALUE, NULL_VALUE});
+  expected_result->append({12, 457.7f});
+  expected_result->append({1234, NULL_VALUE});
+  expected_result->append({1234, 458.7f});
+  expected_result->append({12345, NULL_VALUE});
+
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+
+  auto sort = std::make_shared<Sort>(table_wrapper, ColumnID{0}, OrderByMode::Ascending, 2u);
+  sort->execute();
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+
+  EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_result);
+  ASSERT_EQ(sort->get_output()->chunk_count(), 3u);
+  for (ChunkID chunk_id{0}; chunk_id < sort->get_output()->chunk_count(); ++chunk_id) {
+    EXPECT_NE(std::dynamic_pointer_cast<const ValueColumn<float>>(
+                  sort->get_output()->get_chunk(chunk_id).get_column(ColumnID{1})),
+              nullptr);
+  }
+}
+
+TEST_F(OperatorsSortTest, SpillRunsWhenExceedingMemoryBudget) {
+  auto table = std::make_shared<Table>(6'000);
+  table->add_column("a", DataType::Int, true);
+  table->add_column("b", DataType::String, true);
+  table->add_column("c", DataType::Double);
+  for (auto row = 0; row < 30'000; ++row) {
+    table->append({row % 11 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row * 7) % 97},
+                   row % 5 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{std::to_string(row % 23)},
+                   static_cast<double>(row)});
+  }
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}, ChunkID{3}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{2}, ScanType::GreaterThanEquals, 1'000.0);
+  scan->execute();
+
+  const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::DescendingNullsLast},
+                                                                  {ColumnID{1}, OrderByMode::Ascending}};
+
+  for (const auto& input : std::vector<std::shared_ptr<AbstractOperator>>{table_wrapper, scan}) {
+    auto in_memory_sort = std::make_shared<Sort>(input, sort_definitions, 1'000u);
+    in_memory_sort->execute();
+
+    // A budget of a single byte makes Sort spill a run per chunk, which is written in multiple blocks
+    for (const auto memory_budget : {size_t{1}, size_t{500'000}}) {
+      auto spilling_sort = std::make_shared<Sort>(input, sort_definitions, 1'000u, memory_budget);
+      spilling_sort->execute();
+
+      // Column c makes the rows unique, so this also checks that the merge of the runs is stable
+      EXPECT_TABLE_EQ_ORDERED(spilling_sort->get_output(), in_memory_sort->get_output());
+      EXPECT_EQ(spilling_sort->get_output()->chunk_count(), in_memory_sort->get_output()->chunk_count());
+      EXPECT_EQ(spilling_sort->get_output()->get_chunk(ChunkID{0}).size(), 1'000u);
+    }
+  }
+}
+
+TEST_F(OperatorsSortTest, LongStringsAreCutOffInKeys) {
+  // One very long string among many short ones. Every third string shares a prefix longer than the one in the keys,
+  // so that these rows are ordered by their full strings.
+  const auto long_prefix = std::string(NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH + 8, 'p');
+  using Row = std::pair<std::optional<std::string>, int>;
+  auto rows = std::vector<Row>{};
+  for (auto row = 0; row < 3'000; ++row) {
+    if (row % 17 == 0) {
+      rows.emplace_back(std::nullopt, row);
+    } else if (row == 1'000) {
+      rows.emplace_back(std::string(60'000, 'x'), row);
+    } else if (row % 3 == 0) {
+      rows.emplace_back(long_prefix + std::to_string(row % 37), row);
+    } else {
+      rows.emplace_back(std::to_string(row % 13), row);
+    }
+  }
+
+  const auto create_table = [](const std::vector<Row>& table_rows) {
+    auto table = std::make_shared<Table>(500);
+    table->add_column("a", DataType::String, true);
+    table->add_column("b", DataType::Int);
+    for (const auto& [value, row] : table_rows) {
+      table->append({value ? AllTypeVariant{*value} : AllTypeVariant{NULL_VALUE}, row});
+    }
+    return table;
+  };
+
+  auto table = create_table(rows);
+  DictionaryCompression::compress_chunks(*table, {ChunkID{1}, ChunkID{4}});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  for (const auto order_by_mode : {OrderByMode::Ascending, OrderByMode::Descending}) {
+    const auto sort_definitions = std::vector<SortColumnDefinition>{{ColumnID{0}, order_by_mode}};
+
+    // The long string does not widen the keys of the other rows
+    const auto column_key_widths = NormalizedSortKeys::column_key_widths(table, sort_definitions);
+    EXPECT_EQ(column_key_widths, std::vector<size_t>{1 + NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH + 4});
+
+    auto expected_rows = rows;
+    std::stable_sort(expected_rows.begin(), expected_rows.end(), [&](const Row& left, const Row& right) {
+      if (!left.first || !right.first) return !left.first && right.first;
+      return order_by_mode == OrderByMode::Ascending ? *left.first < *right.first : *left.first > *right.first;
+    });
+    const auto expected_table = create_table(expected_rows);
+
+    // A budget of a single byte makes Sort spill and merge a run per chunk
+    for (const auto memory_budget : {std::optional<size_t>{}, std::optional<size_t>{1}}) {
+      auto sort = std::make_shared<Sort>(table_wrapper, sort_definitions, 700u, memory_budget);
+      sort->execute();
+
+      EXPECT_TABLE_EQ_ORDERED(sort->get_output(), expected_table);
+    }
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,111 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "scheduler/current_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
+#include "scheduler/topology.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Many ties in a and b, so that the position of the rows decides their order
+    auto table = std::make_shared<Table>(100);
+    table->add_column("a", DataType::Int, true);
+    table->add_column("b", DataType::String);
+    table->add_column("c", DataType::Int);
+    for (auto row = 0; row < 1'000; ++row) {
+      table->append({row % 11 == 0 ? AllTypeVariant{NULL_VALUE} : AllTypeVariant{(row * 7) % 23},
+                     std::to_string(row % 5), row});
+    }
+    DictionaryCompression::compress_chunks(*table, {ChunkID{2}, ChunkID{7}});
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->execute();
+  }
+
+  // Checks TopK against Limit(Sort) for various k
+  void _check_against_sort_and_limit(const std::shared_ptr<AbstractOperator>& input,
+                                     const std::vector<SortColumnDefinition>& sort_definitions) {
+    const auto row_count = input->get_output()->row_count();
+    for (const auto k : {size_t{0}, size_t{1}, size_t{17}, size_t{150}, row_count - 1, row_count, row_count + 3}) {
+      auto sort = std::make_shared<Sort>(input, sort_definitions);
+      sort->execute();
+      auto limit = std::make_shared<Limit>(sort, k);
+      limit->execute();
+
+      auto top_k = std::make_shared<TopK>(input, sort_definitions, k);
+      top_k->execute();
+
+      EXPECT_EQ(top_k->get_output()->row_count(), std::min(k, row_count));
+      EXPECT_TABLE_EQ_ORDERED(top_k->get_output(), limit->get_output());
+    }
+  }
+
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, OperatorName) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}}}, 10);
+
+  EXPECT_EQ(top_k->name(), "TopK");
+  EXPECT_EQ(top_k->k(), 10u);
+}
+
+TEST_F(OperatorsTopKTest, SingleColumn) {
+  _check_against_sort_and_limit(_table_wrapper, {{ColumnID{0}, OrderByMode::Ascending}});
+  _check_against_sort_and_limit(_table_wrapper, {{ColumnID{0}, OrderByMode::DescendingNullsLast}});
+}
+
+TEST_F(OperatorsTopKTest, MultipleColumnsOnReferenceColumns) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::GreaterThanEquals, 100);
+  scan->execute();
+
+  _check_against_sort_and_limit(scan, {{ColumnID{1}, OrderByMode::Descending}, {ColumnID{0}}});
+}
+
+TEST_F(OperatorsTopKTest, MultipleColumnsWithScheduler) {
+  CurrentScheduler::set(std::make_shared<NodeQueueScheduler>(Topology::create_fake_numa_topology(8, 4)));
+
+  _check_against_sort_and_limit(_table_wrapper, {{ColumnID{0}, OrderByMode::AscendingNullsLast}, {ColumnID{1}}});
+
+  CurrentScheduler::get()->finish();
+  CurrentScheduler::set(nullptr);
+}
+
+TEST_F(OperatorsTopKTest, LongStringsAreCutOffInKeys) {
+  // Strings that only differ after the prefix in the keys, and one very long string
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", DataType::String);
+  const auto long_prefix = std::string(NormalizedSortKeys::MAX_STRING_PREFIX_LENGTH, 'p');
+  for (auto row = 0; row < 1'000; ++row) {
+    table->append({row == 500 ? std::string(60'000, 'p') : long_prefix + std::to_string((row * 7) % 31)});
+  }
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  _check_against_sort_and_limit(table_wrapper, {{ColumnID{0}, OrderByMode::Ascending}});
+  _check_against_sort_and_limit(table_wrapper, {{ColumnID{0}, OrderByMode::Descending}});
+
+  // The heaps keep the smallest strings, although the first rows of the input have the same keys
+  auto top_k = std::make_shared<TopK>(table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}}}, 3);
+  top_k->execute();
+  for (auto row = size_t{0}; row < 3; ++row) {
+    EXPECT_EQ(top_k->get_output()->get_value<std::string>(ColumnID{0}, row), long_prefix + "0");
+  }
+}
+
+}  // namespace opossum
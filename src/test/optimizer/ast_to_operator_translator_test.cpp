@@ -18,8 +18,10 @@
 #include "logical_query_plan/sort_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
 #include "operators/aggregate.hpp"
+#include "operators/aggregate_sorted.hpp"
 #include "operators/get_table.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_index.hpp"
 #include "operators/join_sort_merge.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/show_columns.hpp"
@@ -27,6 +29,9 @@
 #include "operators/projection.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_scan.hpp"
+#include "operators/top_k.hpp"
+#include "storage/dictionary_compression.hpp"
+#include "storage/index/group_key/group_key_index.hpp"
 #include "storage/storage_manager.hpp"
 
 namespace opossum {
@@ -109,6 +114,39 @@ TEST_F(LQPTranslatorTest, SortNode) {
   EXPECT_EQ(sort_op->order_by_mode(), OrderByMode::Ascending);
 }
 
+TEST_F(LQPTranslatorTest, SortNodeWithMultipleColumns) {
+  const auto stored_table_node = std::make_shared<StoredTableNode>("table_int_float");
+  auto sort_node = std::make_shared<SortNode>(std::vector<OrderByDefinition>{
+      {ColumnID{1}, OrderByMode::DescendingNullsLast}, {ColumnID{0}, OrderByMode::Ascending}});
+  sort_node->set_left_child(stored_table_node);
+  const auto op = LQPTranslator{}.translate_node(sort_node);
+
+  const auto sort_op = std::dynamic_pointer_cast<Sort>(op);
+  ASSERT_TRUE(sort_op);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(sort_op->input_left()));
+  ASSERT_EQ(sort_op->sort_definitions().size(), 2u);
+  EXPECT_EQ(sort_op->sort_definitions()[0].column_id, ColumnID{1});
+  EXPECT_EQ(sort_op->sort_definitions()[0].order_by_mode, OrderByMode::DescendingNullsLast);
+  EXPECT_EQ(sort_op->sort_definitions()[1].column_id, ColumnID{0});
+  EXPECT_EQ(sort_op->sort_definitions()[1].order_by_mode, OrderByMode::Ascending);
+}
+
+TEST_F(LQPTranslatorTest, LimitNodeOnSortNode) {
+  const auto stored_table_node = std::make_shared<StoredTableNode>("table_int_float");
+  auto sort_node = std::make_shared<SortNode>(std::vector<OrderByDefinition>{{ColumnID{1}, OrderByMode::Descending}});
+  sort_node->set_left_child(stored_table_node);
+  auto limit_node = std::make_shared<LimitNode>(10);
+  limit_node->set_left_child(sort_node);
+  const auto op = LQPTranslator{}.translate_node(limit_node);
+
+  const auto top_k_op = std::dynamic_pointer_cast<TopK>(op);
+  ASSERT_TRUE(top_k_op);
+  EXPECT_EQ(top_k_op->k(), 10u);
+  EXPECT_EQ(top_k_op->column_id(), ColumnID{1});
+  EXPECT_EQ(top_k_op->order_by_mode(), OrderByMode::Descending);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(top_k_op->input_left()));
+}
+
 TEST_F(LQPTranslatorTest, JoinNode) {
   const auto stored_table_node_left = std::make_shared<StoredTableNode>("table_int_float");
   const auto stored_table_node_right = std::make_shared<StoredTableNode>("table_int_float2");
@@ -118,13 +156,43 @@ TEST_F(LQPTranslatorTest, JoinNode) {
   join_node->set_right_child(stored_table_node_right);
   const auto op = LQPTranslator{}.translate_node(join_node);
 
-  const auto join_op = std::dynamic_pointer_cast<JoinSortMerge>(op);
+  const auto join_op = std::dynamic_pointer_cast<JoinHash>(op);
   ASSERT_TRUE(join_op);
   EXPECT_EQ(join_op->column_ids(), join_node->join_column_ids());
   EXPECT_EQ(join_op->scan_type(), ScanType::Equals);
   EXPECT_EQ(join_op->mode(), JoinMode::Outer);
 }
 
+TEST_F(LQPTranslatorTest, JoinNodeSmallOuterIndexedInner) {
+  // A large table that is indexed on its first column
+  auto indexed_table = std::make_shared<Table>();
+  indexed_table->add_column("a", DataType::Int);
+  for (auto value = 0; value < 1000; ++value) indexed_table->append({value});
+  DictionaryCompression::compress_table(*indexed_table);
+  indexed_table->get_chunk(ChunkID{0}).create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
+  StorageManager::get().add_table("table_indexed", indexed_table);
+
+  const auto stored_table_node_left = std::make_shared<StoredTableNode>("table_int_float");
+  const auto stored_table_node_right = std::make_shared<StoredTableNode>("table_indexed");
+  auto join_node =
+      std::make_shared<JoinNode>(JoinMode::Inner, std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  join_node->set_left_child(stored_table_node_left);
+  join_node->set_right_child(stored_table_node_right);
+  const auto op = LQPTranslator{}.translate_node(join_node);
+
+  const auto join_op = std::dynamic_pointer_cast<JoinIndex>(op);
+  ASSERT_TRUE(join_op);
+  EXPECT_EQ(join_op->column_ids(), join_node->join_column_ids());
+  EXPECT_EQ(join_op->mode(), JoinMode::Inner);
+
+  // The index is not used if the outer input is the larger one
+  auto swapped_join_node =
+      std::make_shared<JoinNode>(JoinMode::Inner, std::make_pair(ColumnID{0}, ColumnID{0}), ScanType::Equals);
+  swapped_join_node->set_left_child(std::make_shared<StoredTableNode>("table_indexed"));
+  swapped_join_node->set_right_child(std::make_shared<StoredTableNode>("table_int_float"));
+  EXPECT_TRUE(std::dynamic_pointer_cast<JoinHash>(LQPTranslator{}.translate_node(swapped_join_node)));
+}
+
 TEST_F(LQPTranslatorTest, ShowTablesNode) {
   const auto show_tables_node = std::make_shared<ShowTablesNode>();
   const auto op = LQPTranslator{}.translate_node(show_tables_node);
@@ -166,6 +234,35 @@ TEST_F(LQPTranslatorTest, AggregateNodeNoArithmetics) {
   EXPECT_EQ(aggregate_definition.alias, std::optional<std::string>("sum_of_a"));
 }
 
+TEST_F(LQPTranslatorTest, AggregateNodeOnSortedInput) {
+  const auto stored_table_node = std::make_shared<StoredTableNode>("table_int_float");
+  auto sort_node = std::make_shared<SortNode>(std::vector<OrderByDefinition>{{ColumnID{1}, OrderByMode::Descending}});
+  sort_node->set_left_child(stored_table_node);
+
+  auto sum_expression =
+      Expression::create_aggregate_function(AggregateFunction::Sum, {Expression::create_column(ColumnID{0})});
+
+  // Sorted by the GROUP BY column
+  auto aggregate_node = std::make_shared<AggregateNode>(std::vector<std::shared_ptr<Expression>>{sum_expression},
+                                                        std::vector<ColumnID>{ColumnID{1}});
+  aggregate_node->set_left_child(sort_node);
+
+  const auto op = LQPTranslator{}.translate_node(aggregate_node);
+  const auto aggregate_op = std::dynamic_pointer_cast<AggregateSorted>(op);
+  ASSERT_TRUE(aggregate_op);
+  EXPECT_EQ(aggregate_op->groupby_column_ids(), std::vector<ColumnID>{ColumnID{1}});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const Sort>(aggregate_op->input_left()));
+
+  // Not sorted by the GROUP BY column
+  aggregate_node = std::make_shared<AggregateNode>(std::vector<std::shared_ptr<Expression>>{sum_expression},
+                                                   std::vector<ColumnID>{ColumnID{0}});
+  aggregate_node->set_left_child(sort_node);
+
+  const auto hash_op = LQPTranslator{}.translate_node(aggregate_node);
+  EXPECT_TRUE(std::dynamic_pointer_cast<Aggregate>(hash_op));
+  EXPECT_FALSE(std::dynamic_pointer_cast<AggregateSorted>(hash_op));
+}
+
 TEST_F(LQPTranslatorTest, AggregateNodeWithArithmetics) {
   const auto stored_table_node = std::make_shared<StoredTableNode>("table_int_float");
 
@@ -196,28 +293,55 @@ TEST_F(LQPTranslatorTest, AggregateNodeWithArithmetics) {
   EXPECT_EQ(aggregate_op->groupby_column_ids()[0], ColumnID{0});
 
   const auto aggregate_definition = aggregate_op->aggregates()[0];
-  EXPECT_EQ(aggregate_definition.column_id, ColumnID{1});
+  EXPECT_EQ(aggregate_definition.column_id, ColumnID{2});
   EXPECT_EQ(aggregate_definition.function, AggregateFunction::Sum);
   EXPECT_EQ(aggregate_definition.alias, std::optional<std::string>("sum_of_b_times_two"));
 
-  // Check projection operator.
-  // The projection operator is required because we need the arithmetic operation to be calculated first.
-  const auto left_op = aggregate_op->input_left();
-  ASSERT_TRUE(left_op);
+  // Check column expressions.
+  // The arithmetic operation is calculated by the Aggregate itself, which passes on the input columns.
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(aggregate_op->input_left()));
 
-  const auto projection_op = std::dynamic_pointer_cast<const Projection>(left_op);
-  ASSERT_TRUE(projection_op);
-
-  const auto column_expressions = projection_op->column_expressions();
-  ASSERT_EQ(column_expressions.size(), 2u);
+  const auto column_expressions = aggregate_op->column_expressions();
+  ASSERT_EQ(column_expressions.size(), 3u);
 
   const auto column_expression0 = column_expressions[0];
   EXPECT_EQ(column_expression0->type(), ExpressionType::Column);
   EXPECT_EQ(column_expression0->column_id(), ColumnID{0});
 
-  const auto column_expression1 = column_expressions[1];
-  EXPECT_EQ(column_expression1->to_string(), "ColumnID #1 * 2");
-  EXPECT_EQ(column_expression1->alias(), std::nullopt);
+  const auto column_expression2 = column_expressions[2];
+  EXPECT_EQ(column_expression2->to_string(), "ColumnID #1 * 2");
+  EXPECT_EQ(column_expression2->alias(), std::nullopt);
+}
+
+TEST_F(LQPTranslatorTest, AggregateNodeOnComputedGroupKey) {
+  const auto stored_table_node = std::make_shared<StoredTableNode>("table_int_float");
+
+  // GROUP BY a * 2, with SUM((a * 2) + a)
+  const auto expr_multiplication = Expression::create_binary_operator(
+      ExpressionType::Multiplication, Expression::create_column(ColumnID{0}), Expression::create_literal(2));
+  auto projection_node = std::make_shared<ProjectionNode>(std::vector<std::shared_ptr<Expression>>{
+      Expression::create_column(ColumnID{0}), Expression::create_column(ColumnID{1}), expr_multiplication});
+  projection_node->set_left_child(stored_table_node);
+
+  const auto expr_addition = Expression::create_binary_operator(
+      ExpressionType::Addition, Expression::create_column(ColumnID{2}), Expression::create_column(ColumnID{0}));
+  auto sum_expression = Expression::create_aggregate_function(AggregateFunction::Sum, {expr_addition});
+  auto aggregate_node = std::make_shared<AggregateNode>(std::vector<std::shared_ptr<Expression>>{sum_expression},
+                                                        std::vector<ColumnID>{ColumnID{2}});
+  aggregate_node->set_left_child(projection_node);
+
+  // The ProjectionNode is fused into the Aggregate
+  const auto aggregate_op = std::dynamic_pointer_cast<Aggregate>(LQPTranslator{}.translate_node(aggregate_node));
+  ASSERT_TRUE(aggregate_op);
+  EXPECT_TRUE(std::dynamic_pointer_cast<const GetTable>(aggregate_op->input_left()));
+
+  const auto column_expressions = aggregate_op->column_expressions();
+  ASSERT_EQ(column_expressions.size(), 4u);
+  EXPECT_EQ(column_expressions[2]->to_string(), "ColumnID #0 * 2");
+  EXPECT_EQ(column_expressions[3]->to_string(), "(ColumnID #0 * 2) + ColumnID #0");
+
+  EXPECT_EQ(aggregate_op->groupby_column_ids(), std::vector<ColumnID>{ColumnID{2}});
+  EXPECT_EQ(aggregate_op->aggregates()[0].column_id, ColumnID{3});
 }
 
 TEST_F(LQPTranslatorTest, MultipleNodesHierarchy) {
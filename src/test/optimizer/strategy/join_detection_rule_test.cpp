@@ -147,6 +147,63 @@ TEST_F(JoinDetectionRuleTest, SecondDetectionTest) {
   EXPECT_EQ(output->left_child()->right_child()->type(), LQPNodeType::StoredTable);
 }
 
+TEST_F(JoinDetectionRuleTest, CompositeKeyDetection) {
+  /**
+   * Test that
+   *
+   *   Predicate
+   *  (a.b < b.b)
+   *       |
+   *   Predicate
+   *  (b.b == a.b)
+   *       |
+   *   Predicate
+   *  (a.a == b.a)
+   *       |
+   *     Cross
+   *    /     \
+   *   a       b
+   *
+   * gets converted to
+   *
+   *   Predicate
+   *  (a.b < b.b)
+   *       |
+   *      Join
+   *  (a.a == b.a AND a.b == b.b)
+   *    /     \
+   *   a       b
+   */
+
+  // Generate LQP
+  const auto cross_join_node = std::make_shared<JoinNode>(JoinMode::Cross);
+  cross_join_node->set_left_child(_table_node_a);
+  cross_join_node->set_right_child(_table_node_b);
+
+  const auto predicate_node_a = std::make_shared<PredicateNode>(ColumnID{0}, ScanType::Equals, ColumnID{2});
+  predicate_node_a->set_left_child(cross_join_node);
+
+  const auto predicate_node_b = std::make_shared<PredicateNode>(ColumnID{3}, ScanType::Equals, ColumnID{1});
+  predicate_node_b->set_left_child(predicate_node_a);
+
+  const auto predicate_node_c = std::make_shared<PredicateNode>(ColumnID{1}, ScanType::LessThan, ColumnID{3});
+  predicate_node_c->set_left_child(predicate_node_b);
+
+  auto output = StrategyBaseTest::apply_rule(_rule, predicate_node_c);
+
+  EXPECT_EQ(output, predicate_node_c);
+
+  // Verification of the new JOIN
+  ASSERT_INNER_JOIN_NODE(output->left_child(), ScanType::Equals, ColumnID{0}, ColumnID{0});
+
+  const auto join_node = std::dynamic_pointer_cast<JoinNode>(output->left_child());
+  const auto expected_additional_column_ids = std::vector<std::pair<ColumnID, ColumnID>>{{ColumnID{1}, ColumnID{1}}};
+  EXPECT_EQ(join_node->additional_join_column_ids(), expected_additional_column_ids);
+
+  EXPECT_EQ(join_node->left_child()->type(), LQPNodeType::StoredTable);
+  EXPECT_EQ(join_node->right_child()->type(), LQPNodeType::StoredTable);
+}
+
 TEST_F(JoinDetectionRuleTest, NoPredicate) {
   /**
    * Test that
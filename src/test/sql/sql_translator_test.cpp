@@ -172,6 +172,34 @@ TEST_F(SQLTranslatorTest, AggregateWithInvalidGroupBy) {
   EXPECT_THROW(compile_query(query), std::logic_error);
 }
 
+TEST_F(SQLTranslatorTest, AggregateWithGroupByExpression) {
+  // The GROUP BY expression may be repeated in the SELECT list or referenced by its alias
+  for (const auto query : {"SELECT a * 2 AS k, SUM(b) AS s FROM table_a GROUP BY k;",
+                           "SELECT a * 2 AS k, SUM(b) AS s FROM table_a GROUP BY a * 2;"}) {
+    const auto result_node = compile_query(query);
+
+    const auto projection_node = std::dynamic_pointer_cast<ProjectionNode>(result_node);
+    ASSERT_NE(projection_node, nullptr);
+    EXPECT_EQ(projection_node->output_column_names(), std::vector<std::string>({"k", "s"}));
+
+    const auto aggregate_node = std::dynamic_pointer_cast<AggregateNode>(result_node->left_child());
+    ASSERT_NE(aggregate_node, nullptr);
+    EXPECT_EQ(aggregate_node->groupby_column_ids(), std::vector<ColumnID>{ColumnID{2}});
+
+    // The group key is appended to the input columns
+    const auto groupby_projection_node = std::dynamic_pointer_cast<ProjectionNode>(aggregate_node->left_child());
+    ASSERT_NE(groupby_projection_node, nullptr);
+    ASSERT_EQ(groupby_projection_node->column_expressions().size(), 3u);
+    EXPECT_EQ(groupby_projection_node->column_expressions()[0]->column_id(), ColumnID{0});
+    EXPECT_EQ(groupby_projection_node->column_expressions()[1]->column_id(), ColumnID{1});
+    EXPECT_TRUE(groupby_projection_node->column_expressions()[2]->is_arithmetic_operator());
+    EXPECT_EQ(groupby_projection_node->left_child()->type(), LQPNodeType::StoredTable);
+  }
+
+  // The expression in the SELECT list does not match the GROUP BY expression
+  EXPECT_THROW(compile_query("SELECT a * 3, SUM(b) FROM table_a GROUP BY a * 2;"), std::logic_error);
+}
+
 TEST_F(SQLTranslatorTest, AggregateWithExpression) {
   const auto query = "SELECT SUM(a+b) AS s, SUM(a*b) as f FROM table_a";
   const auto result_node = compile_query(query);
@@ -267,6 +295,44 @@ TEST_F(SQLTranslatorTest, SelectInnerJoin) {
   EXPECT_EQ((*join_node->join_column_ids()).second, ColumnID{0});
 }
 
+TEST_F(SQLTranslatorTest, SelectInnerJoinOnMultipleColumns) {
+  const auto query = "SELECT * FROM table_a AS a INNER JOIN table_b AS b ON a.a = b.a AND b.b = a.b;";
+  auto result_node = compile_query(query);
+
+  EXPECT_EQ(result_node->left_child()->type(), LQPNodeType::Join);
+  auto join_node = std::dynamic_pointer_cast<JoinNode>(result_node->left_child());
+  EXPECT_EQ(join_node->scan_type(), ScanType::Equals);
+  EXPECT_EQ(join_node->join_mode(), JoinMode::Inner);
+  EXPECT_EQ((*join_node->join_column_ids()).first, ColumnID{0});
+  EXPECT_EQ((*join_node->join_column_ids()).second, ColumnID{0});
+
+  const auto expected_additional_column_ids = std::vector<std::pair<ColumnID, ColumnID>>{{ColumnID{1}, ColumnID{1}}};
+  EXPECT_EQ(join_node->additional_join_column_ids(), expected_additional_column_ids);
+}
+
+TEST_F(SQLTranslatorTest, SelectInnerJoinOnMultipleColumnsNonEquality) {
+  const auto query = "SELECT * FROM table_a AS a INNER JOIN table_b AS b ON a.a = b.a AND a.b < b.b;";
+  EXPECT_THROW(compile_query(query), std::logic_error);
+}
+
+TEST_F(SQLTranslatorTest, SelectBandJoin) {
+  const auto query = "SELECT * FROM table_a AS a LEFT JOIN table_b AS b ON a.b BETWEEN b.a AND b.b;";
+  auto result_node = compile_query(query);
+
+  EXPECT_EQ(result_node->left_child()->type(), LQPNodeType::Join);
+  auto join_node = std::dynamic_pointer_cast<JoinNode>(result_node->left_child());
+  EXPECT_EQ(join_node->scan_type(), ScanType::Between);
+  EXPECT_EQ(join_node->join_mode(), JoinMode::Left);
+  EXPECT_EQ((*join_node->join_column_ids()).first, ColumnID{1});
+  EXPECT_EQ((*join_node->join_column_ids()).second, ColumnID{0});
+  EXPECT_EQ(join_node->upper_bound_column_id(), ColumnID{1});
+}
+
+TEST_F(SQLTranslatorTest, SelectBandJoinWithBoundInLeftInput) {
+  const auto query = "SELECT * FROM table_a AS a INNER JOIN table_b AS b ON a.b BETWEEN a.a AND b.b;";
+  EXPECT_THROW(compile_query(query), std::logic_error);
+}
+
 // Verifies that LEFT/RIGHT JOIN are handled correctly and LEFT/RIGHT OUTER JOIN identically
 TEST_F(SQLTranslatorTest, SelectLeftRightOuterJoins) {
   using namespace std::string_literals;  // NOLINT (Linter does not know about using namespace)
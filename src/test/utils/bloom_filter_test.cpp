@@ -0,0 +1,48 @@
+#include <memory>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "utils/bloom_filter.hpp"
+#include "utils/murmur_hash.hpp"
+
+namespace opossum {
+
+class BloomFilterTest : public BaseTest {};
+
+TEST_F(BloomFilterTest, EmptyFilter) {
+  auto bloom_filter = std::make_shared<BloomFilter>(0);
+
+  EXPECT_FALSE(bloom_filter->contains(0));
+  EXPECT_FALSE(bloom_filter->contains(murmur2<int32_t>(5, 13)));
+}
+
+TEST_F(BloomFilterTest, NoFalseNegatives) {
+  auto bloom_filter = std::make_shared<BloomFilter>(1'000);
+
+  for (int32_t value = 0; value < 1'000; ++value) {
+    bloom_filter->insert(murmur2<int32_t>(value, 13));
+  }
+
+  for (int32_t value = 0; value < 1'000; ++value) {
+    EXPECT_TRUE(bloom_filter->contains(murmur2<int32_t>(value, 13)));
+  }
+}
+
+TEST_F(BloomFilterTest, FewFalsePositives) {
+  auto bloom_filter = std::make_shared<BloomFilter>(1'000);
+
+  for (int32_t value = 0; value < 1'000; ++value) {
+    bloom_filter->insert(murmur2<int32_t>(value, 13));
+  }
+
+  auto false_positives = 0u;
+  for (int32_t value = 1'000; value < 11'000; ++value) {
+    if (bloom_filter->contains(murmur2<int32_t>(value, 13))) ++false_positives;
+  }
+
+  // The expected false positive rate is below 1%, allow some variance
+  EXPECT_LT(false_positives, 300u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,61 @@
+#include <memory>
+#include <string>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "types.hpp"
+#include "utils/spill_file.hpp"
+
+namespace opossum {
+
+class SpillFileTest : public BaseTest {};
+
+TEST_F(SpillFileTest, WriteAndReadBack) {
+  auto spill_file = std::make_shared<SpillFile>();
+  EXPECT_EQ(spill_file->size(), 0u);
+
+  for (int32_t value = 0; value < 10'000; ++value) {
+    spill_file->write(RowID{ChunkID{static_cast<uint32_t>(value)}, ChunkOffset{7}});
+    spill_file->write(value);
+    spill_file->write(std::string(value % 10, 'a'));
+  }
+  spill_file->write(2.5);
+  spill_file->write(std::string{});
+
+  spill_file->rewind();
+
+  auto row_id = RowID{};
+  auto int_value = int32_t{0};
+  auto string_value = std::string{};
+
+  for (int32_t value = 0; value < 10'000; ++value) {
+    spill_file->read(row_id);
+    spill_file->read(int_value);
+    spill_file->read(string_value);
+
+    EXPECT_EQ(row_id, (RowID{ChunkID{static_cast<uint32_t>(value)}, ChunkOffset{7}}));
+    EXPECT_EQ(int_value, value);
+    EXPECT_EQ(string_value, std::string(value % 10, 'a'));
+  }
+
+  auto double_value = 0.0;
+  spill_file->read(double_value);
+  EXPECT_EQ(double_value, 2.5);
+
+  spill_file->read(string_value);
+  EXPECT_EQ(string_value, "");
+}
+
+TEST_F(SpillFileTest, Size) {
+  auto spill_file = std::make_shared<SpillFile>();
+
+  spill_file->write(int64_t{1});
+  EXPECT_EQ(spill_file->size(), sizeof(int64_t));
+
+  // Strings are prefixed with their length
+  spill_file->write(std::string{"abc"});
+  EXPECT_EQ(spill_file->size(), sizeof(int64_t) + sizeof(uint32_t) + 3);
+}
+
+}  // namespace opossum